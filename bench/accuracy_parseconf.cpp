@@ -0,0 +1,349 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <iostream>
+
+#include <boost/program_options.hpp>
+#include <boost/tokenizer.hpp>
+namespace po = boost::program_options;
+
+#include "parseconf.h"
+#include "accuracy_parseconf.h"
+
+namespace
+{
+
+    struct FastModeName
+    {
+        const char* name;
+        FastMode::type mode;
+    };
+
+    const FastModeName fast_mode_names[] =
+    {
+        { "int_lut", FastMode::int_lut },
+        { "collapse", FastMode::radial_collapse },
+        { "geom_lut", FastMode::geom_lut },
+        { "vign_lut", FastMode::vign_lut },
+        { "colour_path", FastMode::colour_path },
+        { "tables", FastMode::tables },
+        { "combined", FastMode::combined }
+    };
+
+    const size_t num_fast_mode_names = sizeof(fast_mode_names) / sizeof(fast_mode_names[0]);
+
+    struct ChartName
+    {
+        const char* name;
+        TestChart::type chart;
+    };
+
+    const ChartName chart_names[] =
+    {
+        { "noise", TestChart::noise },
+        { "gradient", TestChart::gradient },
+        { "star", TestChart::star },
+        { "file", TestChart::file }
+    };
+
+    // the file chart is only selected through --chart-file
+    const size_t num_synthetic_charts = 3;
+
+    bool parse_fast_modes(const std::string& param_string, std::vector<FastMode::type>& fast_modes)
+    {
+        typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+        typedef boost::char_separator<char> separator_t;
+
+        separator_t sep(",;");
+        tokenizer_t tokens(param_string, sep);
+
+        for (tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        {
+            if (*it == "all")
+            {
+                for (size_t i = 0; i < num_fast_mode_names; ++i)
+                {
+                    fast_modes.push_back(fast_mode_names[i].mode);
+                }
+                continue;
+            }
+
+            bool found(false);
+            for (size_t i = 0; i < num_fast_mode_names; ++i)
+            {
+                if (*it == fast_mode_names[i].name)
+                {
+                    fast_modes.push_back(fast_mode_names[i].mode);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                std::cerr << "Error: unknown fast mode '" << *it << "'" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool parse_charts(const std::string& param_string, std::vector<TestChart::type>& charts)
+    {
+        typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+        typedef boost::char_separator<char> separator_t;
+
+        separator_t sep(",;");
+        tokenizer_t tokens(param_string, sep);
+
+        for (tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        {
+            bool found(false);
+            for (size_t i = 0; i < num_synthetic_charts; ++i)
+            {
+                if (*it == chart_names[i].name)
+                {
+                    charts.push_back(chart_names[i].chart);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                std::cerr << "Error: unknown test chart '" << *it << "'" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+} // anonymous namespace
+
+const char* fast_mode_name(FastMode::type mode)
+{
+    for (size_t i = 0; i < num_fast_mode_names; ++i)
+    {
+        if (fast_mode_names[i].mode == mode)
+        {
+            return fast_mode_names[i].name;
+        }
+    }
+
+    return "unknown";
+}
+
+const char* chart_name(TestChart::type chart)
+{
+    switch (chart)
+    {
+        case TestChart::noise:
+            return chart_names[0].name;
+
+        case TestChart::gradient:
+            return chart_names[1].name;
+
+        case TestChart::star:
+            return chart_names[2].name;
+
+        case TestChart::file:
+            return chart_names[3].name;
+
+        default:
+            return "unknown";
+    }
+}
+
+bool parse_accuracy_command_line(int argc, char* argv[], AccuracySettings& settings)
+{
+
+    try
+    {
+
+        po::options_description opt_desc("Allowed options");
+        opt_desc.add_options()
+        ("help,h", "show options")
+        ("verbose,v", "be verbose")
+        ("size,s", po::value<std::string>(), "Size of the synthetic test charts: WxH (default: 1500x1000)")
+        ("storage", po::value<std::string>(), "Comma-separated list of storage types, or 'all'"
+         " (default: rgb8,rgb16; cf. phtr-bench)")
+        ("interpolation,i", po::value<std::string>(), "Comma-separated list of interpolation types, or 'all'"
+         " (default: bilin,lanczos3; cf. phtr-bench)")
+        ("models,m", po::value<std::string>(), "Comma-separated list of model chains, or 'all'"
+         " (default: vign,full; cf. phtr-bench)")
+        ("modes", po::value<std::string>(), "Comma-separated list of fast modes, or 'all' (default: all):\n"
+         "  int_lut     - integer decoding table\n"
+         "  collapse    - radial collapse of the correction queues\n"
+         "  geom_lut    - radial table of the geometry conversion\n"
+         "  vign_lut    - r^2 table of the vignetting model\n"
+         "  colour_path - colour-only transformation without resampling\n"
+         "  tables      - default gamma/encoding table precision\n"
+         "  combined    - all of the above")
+        ("charts", po::value<std::string>(), "Comma-separated list of synthetic test charts"
+         " (default: noise,gradient,star):\n"
+         "  noise    - uncorrelated noise\n"
+         "  gradient - ramps and smooth rings\n"
+         "  star     - Siemens star")
+        ("chart-file", po::value<std::string>(), "Additional test chart: binary PPM/PGM file (8 or 16 bit)")
+        ("repeat,n", po::value<unsigned>(), "Number of timed runs per case (default: 3)")
+        ("max-error", po::value<double>(), "Bound for the maximum error, in 8 bit code values"
+         " (scaled for higher bit depths; default: 2)")
+        ("max-mean-error", po::value<double>(), "Bound for the mean error, in 8 bit code values"
+         " (default: 0.05)")
+        ("min-psnr", po::value<double>(), "Bound for the PSNR in dB (default: 60)")
+        ("json", "Write results as JSON")
+        ("output-file,o", po::value<std::string>(), "Output file (default: standard output)");
+
+        po::variables_map options_map;
+        po::store(po::parse_command_line(argc, argv, opt_desc), options_map);
+        po::notify(options_map);
+
+        if (options_map.count("help"))
+        {
+            std::cout << opt_desc << std::endl;
+            std::cout << "The exit status is non-zero if any result exceeds the error bounds." << std::endl;
+            settings.help = true;
+            return true;
+        }
+
+        if (options_map.count("verbose"))
+        {
+            settings.verbose = true;
+        }
+
+        if (options_map.count("size"))
+        {
+            if (!parse_image_size(options_map["size"].as<std::string>(), settings.width, settings.height))
+            {
+                return false;
+            }
+        }
+
+        if (options_map.count("storage"))
+        {
+            if (!parse_storage_list(options_map["storage"].as<std::string>(), settings.storage_types))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            settings.storage_types.push_back(phtr::mem::Storage::rgb_8_inter);
+            settings.storage_types.push_back(phtr::mem::Storage::rgb_16_inter);
+        }
+
+        if (options_map.count("interpolation"))
+        {
+            if (!parse_interpolation_list(options_map["interpolation"].as<std::string>(), settings.interpolations))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            using phtr::Interpolation;
+            settings.interpolations.push_back(InterpSpec(Interpolation::bilinear, 0));
+            settings.interpolations.push_back(InterpSpec(Interpolation::lanczos, 3));
+        }
+
+        if (options_map.count("models"))
+        {
+            if (!parse_model_chain_list(options_map["models"].as<std::string>(), settings.model_chains))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            settings.model_chains.push_back(ModelChain::vignetting);
+            settings.model_chains.push_back(ModelChain::all);
+        }
+
+        if (!parse_fast_modes(options_map.count("modes") ? options_map["modes"].as<std::string>() : "all",
+                              settings.fast_modes))
+        {
+            return false;
+        }
+
+        if (!parse_charts(options_map.count("charts") ? options_map["charts"].as<std::string>()
+                          : "noise,gradient,star", settings.charts))
+        {
+            return false;
+        }
+
+        if (options_map.count("chart-file"))
+        {
+            settings.chart_file = options_map["chart-file"].as<std::string>();
+            settings.charts.push_back(TestChart::file);
+        }
+
+        if (options_map.count("repeat"))
+        {
+            settings.repeat = options_map["repeat"].as<unsigned>();
+            if (settings.repeat < 1)
+            {
+                std::cerr << "Error: repeat count has to be at least 1" << std::endl;
+                return false;
+            }
+        }
+
+        if (options_map.count("max-error"))
+        {
+            settings.max_error = options_map["max-error"].as<double>();
+        }
+
+        if (options_map.count("max-mean-error"))
+        {
+            settings.max_mean_error = options_map["max-mean-error"].as<double>();
+        }
+
+        if (options_map.count("min-psnr"))
+        {
+            settings.min_psnr = options_map["min-psnr"].as<double>();
+        }
+
+        if (options_map.count("json"))
+        {
+            settings.json = true;
+        }
+
+        if (options_map.count("output-file"))
+        {
+            settings.outp_file = options_map["output-file"].as<std::string>();
+        }
+
+    }
+    catch (po::unknown_option& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "Try option '--help'" << std::endl;
+        return false;
+    }
+    catch (po::error& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,32 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_ACCURACY_PARSECONF_H__
+#define PHTR_BENCH_ACCURACY_PARSECONF_H__
+
+#include "accuracy_settings.h"
+
+bool parse_accuracy_command_line(int argc, char* argv[], AccuracySettings& settings);
+
+const char* fast_mode_name(FastMode::type mode);
+const char* chart_name(TestChart::type chart);
+
+#endif // PHTR_BENCH_ACCURACY_PARSECONF_H__
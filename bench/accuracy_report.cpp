@@ -0,0 +1,165 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include <photoropter/version.h>
+
+#include "parseconf.h"
+#include "accuracy_parseconf.h"
+#include "accuracy_report.h"
+
+namespace
+{
+
+    std::string interp_string(const InterpSpec& interp)
+    {
+        std::ostringstream sstr;
+        sstr << interpolation_name(interp.type);
+        if (interp.type == phtr::Interpolation::lanczos)
+        {
+            sstr << interp.support;
+        }
+
+        return sstr.str();
+    }
+
+} // anonymous namespace
+
+double speedup(const AccuracyResult& result)
+{
+    if (result.fast_time <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return result.ref_time / result.fast_time;
+}
+
+void write_accuracy_header(std::ostream& os)
+{
+    os << std::left
+       << std::setw(9) << "storage"
+       << std::setw(10) << "interp"
+       << std::setw(8) << "models"
+       << std::setw(10) << "chart"
+       << std::setw(13) << "mode"
+       << std::right
+       << std::setw(11) << "max_err"
+       << std::setw(11) << "mean_err"
+       << std::setw(9) << "PSNR"
+       << std::setw(10) << "ref[ms]"
+       << std::setw(10) << "fast[ms]"
+       << std::setw(9) << "speedup"
+       << std::setw(7) << "result"
+       << std::endl;
+}
+
+void write_accuracy_line(std::ostream& os, const AccuracyResult& result)
+{
+    std::ostringstream psnr_str;
+    if (result.psnr > 1e3)
+    {
+        psnr_str << "inf";
+    }
+    else
+    {
+        psnr_str << std::fixed << std::setprecision(2) << result.psnr;
+    }
+
+    os << std::left
+       << std::setw(9) << storage_name(result.storage_type)
+       << std::setw(10) << interp_string(result.interp)
+       << std::setw(8) << model_chain_name(result.chain)
+       << std::setw(10) << chart_name(result.chart)
+       << std::setw(13) << fast_mode_name(result.mode)
+       << std::right
+       << std::fixed << std::setprecision(1)
+       << std::setw(11) << result.max_error
+       << std::setprecision(4)
+       << std::setw(11) << result.mean_error
+       << std::setw(9) << psnr_str.str()
+       << std::setprecision(2)
+       << std::setw(10) << result.ref_time * 1e3
+       << std::setw(10) << result.fast_time * 1e3
+       << std::setw(9) << speedup(result)
+       << std::setw(7) << (result.passed ? "ok" : "FAIL")
+       << std::endl;
+}
+
+void write_accuracy_json(std::ostream& os, const AccuracySettings& settings,
+                         const std::vector<AccuracyResult>& results)
+{
+    os << std::setprecision(6);
+
+    os << "{" << std::endl;
+    os << "  \"photoropter_version\": \"" << phtr::PHTR_VERSION << "\"," << std::endl;
+    os << "  \"width\": " << settings.width << "," << std::endl;
+    os << "  \"height\": " << settings.height << "," << std::endl;
+    os << "  \"repeat\": " << settings.repeat << "," << std::endl;
+    os << "  \"max_error_8bit\": " << settings.max_error << "," << std::endl;
+    os << "  \"max_mean_error_8bit\": " << settings.max_mean_error << "," << std::endl;
+    os << "  \"min_psnr\": " << settings.min_psnr << "," << std::endl;
+    os << "  \"results\": [" << std::endl;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const AccuracyResult& result = results[i];
+
+        os << "    {"
+           << "\"storage\": \"" << storage_name(result.storage_type) << "\", "
+           << "\"interpolation\": \"" << interpolation_name(result.interp.type) << "\", "
+           << "\"support\": " << result.interp.support << ", "
+           << "\"models\": \"" << model_chain_name(result.chain) << "\", "
+           << "\"chart\": \"" << chart_name(result.chart) << "\", "
+           << "\"mode\": \"" << fast_mode_name(result.mode) << "\", "
+           << "\"max_error\": " << result.max_error << ", "
+           << "\"mean_error\": " << result.mean_error << ", ";
+
+        // JSON has no infinity (identical output)
+        os << "\"psnr\": ";
+        if (result.psnr > 1e3)
+        {
+            os << "null";
+        }
+        else
+        {
+            os << result.psnr;
+        }
+
+        os << ", \"ref_s\": " << result.ref_time
+           << ", \"fast_s\": " << result.fast_time
+           << ", \"speedup\": " << speedup(result)
+           << ", \"passed\": " << (result.passed ? "true" : "false")
+           << "}";
+
+        if (i + 1 < results.size())
+        {
+            os << ",";
+        }
+        os << std::endl;
+    }
+
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
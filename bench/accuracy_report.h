@@ -0,0 +1,39 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_ACCURACY_REPORT_H__
+#define PHTR_BENCH_ACCURACY_REPORT_H__
+
+#include <ostream>
+#include <vector>
+
+#include "accuracy_runner.h"
+
+// speedup of the fast path over the reference path
+double speedup(const AccuracyResult& result);
+
+void write_accuracy_header(std::ostream& os);
+void write_accuracy_line(std::ostream& os, const AccuracyResult& result);
+
+void write_accuracy_json(std::ostream& os, const AccuracySettings& settings,
+                         const std::vector<AccuracyResult>& results);
+
+#endif // PHTR_BENCH_ACCURACY_REPORT_H__
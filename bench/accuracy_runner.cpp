@@ -0,0 +1,72 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "accuracy_runner.h"
+
+AccuracyRunnerBase*
+AccuracyRunnerBase::
+get_instance(phtr::mem::Storage::type storage_type, const ChartImage& chart)
+{
+    using phtr::mem::Storage;
+
+    switch (storage_type)
+    {
+        case Storage::rgb_8_inter:
+            return new AccuracyRunner<Storage::rgb_8_inter>(chart);
+
+        case Storage::rgb_16_inter:
+            return new AccuracyRunner<Storage::rgb_16_inter>(chart);
+
+        case Storage::rgb_32_inter:
+            return new AccuracyRunner<Storage::rgb_32_inter>(chart);
+
+        case Storage::rgb_8_planar:
+            return new AccuracyRunner<Storage::rgb_8_planar>(chart);
+
+        case Storage::rgb_16_planar:
+            return new AccuracyRunner<Storage::rgb_16_planar>(chart);
+
+        case Storage::rgb_32_planar:
+            return new AccuracyRunner<Storage::rgb_32_planar>(chart);
+
+        case Storage::rgba_8_inter:
+            return new AccuracyRunner<Storage::rgba_8_inter>(chart);
+
+        case Storage::rgba_16_inter:
+            return new AccuracyRunner<Storage::rgba_16_inter>(chart);
+
+        case Storage::rgba_32_inter:
+            return new AccuracyRunner<Storage::rgba_32_inter>(chart);
+
+        case Storage::rgba_8_planar:
+            return new AccuracyRunner<Storage::rgba_8_planar>(chart);
+
+        case Storage::rgba_16_planar:
+            return new AccuracyRunner<Storage::rgba_16_planar>(chart);
+
+        case Storage::rgba_32_planar:
+            return new AccuracyRunner<Storage::rgba_32_planar>(chart);
+
+        case Storage::unknown:
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,153 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_ACCURACY_RUNNER_H__
+#define PHTR_BENCH_ACCURACY_RUNNER_H__
+
+#include <memory>
+
+#include "accuracy_settings.h"
+#include "chart.h"
+
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/channel_storage.h>
+#include <photoropter/image_buffer.h>
+#include <photoropter/mem_image_view_r.h>
+#include <photoropter/mem_image_view_w.h>
+#include <photoropter/image_transform.h>
+
+/**
+ * @brief Result of one accuracy check (one fast mode against the reference path).
+ */
+struct AccuracyResult
+{
+    AccuracyResult(phtr::mem::Storage::type storage_type_, const InterpSpec& interp_,
+                   ModelChain::type chain_, TestChart::type chart_, FastMode::type mode_)
+            : storage_type(storage_type_),
+            interp(interp_),
+            chain(chain_),
+            chart(chart_),
+            mode(mode_),
+            max_error(0.0),
+            mean_error(0.0),
+            psnr(0.0),
+            ref_time(0.0),
+            fast_time(0.0),
+            passed(false)
+    {
+        //NIL
+    }
+
+    phtr::mem::Storage::type storage_type;
+    InterpSpec interp;
+    ModelChain::type chain;
+    TestChart::type chart;
+    FastMode::type mode;
+
+    // errors in output code values (of the storage type)
+    double max_error;
+    double mean_error;
+
+    // peak signal-to-noise ratio in dB (infinite for identical output)
+    double psnr;
+
+    // fastest transformation times in seconds
+    double ref_time;
+    double fast_time;
+
+    // within the configured error bounds?
+    bool passed;
+};
+
+class AccuracyRunnerBase
+{
+
+    public:
+        /**
+         * @ brief (Dummy) Destructor.
+         */
+        virtual ~AccuracyRunnerBase() {};
+
+    public:
+        /**
+         * @brief Create a runner (including the input image filled with the chart) for the given storage type.
+         */
+        static AccuracyRunnerBase* get_instance(phtr::mem::Storage::type storage_type, const ChartImage& chart);
+
+        /**
+         * @brief The maximum output code value.
+         */
+        virtual double max_code() const = 0;
+
+        /**
+         * @brief Run the reference and the fast path and fill in errors and timings.
+         * @details The reference output is kept for subsequent calls with the same
+         * interpolation and model chain.
+         */
+        virtual void compare(AccuracyResult& result, unsigned int repeat) = 0;
+
+};
+
+template <phtr::mem::Storage::type storage_T>
+class AccuracyRunner : public AccuracyRunnerBase
+{
+    public:
+        typedef phtr::ImageBuffer<storage_T> buffer_t;
+        typedef phtr::MemImageViewR<storage_T> view_r_t;
+        typedef phtr::MemImageViewW<storage_T> view_w_t;
+        typedef typename phtr::mem::ChannelStorage<storage_T>::type channel_storage_t;
+
+        typedef phtr::InterpolatorLanczos<view_r_t> interp_lanczos_t;
+        typedef phtr::ImageTransform<interp_lanczos_t, view_w_t> transform_lanczos_t;
+
+    public:
+        AccuracyRunner(const ChartImage& chart);
+        double max_code() const;
+        void compare(AccuracyResult& result, unsigned int repeat);
+
+    private:
+        void fill_input(const ChartImage& chart);
+        double run(const InterpSpec& interp, ModelChain::type chain, unsigned int modes,
+                   view_w_t& output_view, unsigned int repeat);
+        void measure_error(AccuracyResult& result) const;
+
+    private:
+        size_t width_;
+        size_t height_;
+
+        std::auto_ptr<buffer_t> input_buffer_;
+        std::auto_ptr<buffer_t> ref_buffer_;
+        std::auto_ptr<buffer_t> fast_buffer_;
+
+        std::auto_ptr<view_r_t> input_view_;
+        std::auto_ptr<view_w_t> ref_view_;
+        std::auto_ptr<view_w_t> fast_view_;
+
+        // the case the reference output belongs to
+        bool ref_valid_;
+        InterpSpec ref_interp_;
+        ModelChain::type ref_chain_;
+        double ref_time_;
+};
+
+#include "accuracy_runner.tpl.h"
+
+#endif // PHTR_BENCH_ACCURACY_RUNNER_H__
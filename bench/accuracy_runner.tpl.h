@@ -0,0 +1,206 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cmath>
+#include <limits>
+
+#include <photoropter/mem/channel_range.h>
+#include <photoropter/gamma_func.h>
+#include <photoropter/model/scaler_pixel_model.h>
+#include <photoropter/wall_timer.h>
+
+#include "model_chain.h"
+
+template <phtr::mem::Storage::type storage_T>
+AccuracyRunner<storage_T>::
+AccuracyRunner(const ChartImage& chart)
+        : width_(chart.width),
+        height_(chart.height),
+        ref_valid_(false),
+        ref_interp_(phtr::Interpolation::bilinear, 0),
+        ref_chain_(ModelChain::none),
+        ref_time_(0.0)
+{
+    input_buffer_.reset(new buffer_t(width_, height_));
+    ref_buffer_.reset(new buffer_t(width_, height_));
+    fast_buffer_.reset(new buffer_t(width_, height_));
+    input_view_.reset(new view_r_t(input_buffer_->data(), width_, height_));
+    ref_view_.reset(new view_w_t(ref_buffer_->data(), width_, height_));
+    fast_view_.reset(new view_w_t(fast_buffer_->data(), width_, height_));
+
+    fill_input(chart);
+}
+
+template <phtr::mem::Storage::type storage_T>
+double
+AccuracyRunner<storage_T>::
+max_code() const
+{
+    return static_cast<double>(phtr::mem::ChannelRange<storage_T>::max());
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+AccuracyRunner<storage_T>::
+fill_input(const ChartImage& chart)
+{
+    typedef typename view_r_t::storage_info_t::mem_layout_t mem_layout_t;
+    typedef typename mem_layout_t::colour_tuple_t colour_tuple_t;
+
+    const size_t num_vals = colour_tuple_t::num_vals;
+    const channel_storage_t max_val = phtr::mem::ChannelRange<storage_T>::max();
+    const double scale = static_cast<double>(max_val);
+
+    view_w_t input_view_w(input_buffer_->data(), width_, height_);
+
+    // opaque alpha channel (if any)
+    std::vector<channel_storage_t> row_codes(width_ * num_vals, max_val);
+
+    for (size_t y = 0; y < height_; ++y)
+    {
+        for (size_t x = 0; x < width_; ++x)
+        {
+            channel_storage_t* codes = &row_codes[x * num_vals];
+            codes[mem_layout_t::idx_red] = static_cast<channel_storage_t>(chart.value(x, y, 0) * scale + 0.5);
+            codes[mem_layout_t::idx_green] = static_cast<channel_storage_t>(chart.value(x, y, 1) * scale + 0.5);
+            codes[mem_layout_t::idx_blue] = static_cast<channel_storage_t>(chart.value(x, y, 2) * scale + 0.5);
+        }
+
+        typename view_w_t::iter_t iter(input_view_w.get_iter(0, y));
+        iter.template write_codes<colour_tuple_t>(&row_codes[0], width_);
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+double
+AccuracyRunner<storage_T>::
+run(const InterpSpec& interp, ModelChain::type chain, unsigned int modes,
+    view_w_t& output_view, unsigned int repeat)
+{
+    using phtr::Interpolation;
+
+    double best_time(0.0);
+
+    for (unsigned int i = 0; i < repeat; ++i)
+    {
+        std::auto_ptr<phtr::IImageTransform> transform(
+            phtr::get_image_transform(interp.type, *input_view_, output_view));
+
+        if (interp.type == Interpolation::lanczos)
+        {
+            transform_lanczos_t& lanczos_transform = dynamic_cast<transform_lanczos_t&>(*transform);
+            lanczos_transform.interpolator().set_support(interp.support);
+        }
+
+        // reference: finer gamma and encoding tables
+        if (!(modes & FastMode::tables))
+        {
+            transform->set_gamma_precision(16384);
+            transform->set_gamma(phtr::gamma::GammaSRGB());
+            transform->set_encode_precision(1 << 20);
+        }
+
+        transform->enable_int_lut((modes & FastMode::int_lut) != 0);
+        transform->pixel_queue().enable_radial_collapse((modes & FastMode::radial_collapse) != 0);
+        transform->subpixel_queue().enable_radial_collapse((modes & FastMode::radial_collapse) != 0);
+
+        add_model_chain(*transform, chain, input_view_->aspect_ratio(),
+                        view_r_t::storage_info_t::mem_layout_t::idx_red,
+                        view_r_t::storage_info_t::mem_layout_t::idx_blue,
+                        (modes & FastMode::geom_lut) != 0,
+                        (modes & FastMode::vign_lut) != 0);
+
+        // an identity scaling forces the resampling path for colour-only chains
+        if (!(modes & FastMode::colour_path) && (chain == ModelChain::none || chain == ModelChain::vignetting))
+        {
+            phtr::model::ScalerPixelModel identity_mod(input_view_->aspect_ratio());
+            identity_mod.set_model_param(1.0);
+            transform->pixel_queue().add_model(identity_mod);
+        }
+
+        phtr::WallTimer timer;
+        transform->do_transform();
+        double time = timer.elapsed();
+
+        if (i == 0 || time < best_time)
+        {
+            best_time = time;
+        }
+    }
+
+    return best_time;
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+AccuracyRunner<storage_T>::
+compare(AccuracyResult& result, unsigned int repeat)
+{
+    const bool same_case = ref_valid_
+                           && ref_interp_.type == result.interp.type
+                           && ref_interp_.support == result.interp.support
+                           && ref_chain_ == result.chain;
+
+    if (!same_case)
+    {
+        ref_time_ = run(result.interp, result.chain, 0, *ref_view_, repeat);
+        ref_interp_ = result.interp;
+        ref_chain_ = result.chain;
+        ref_valid_ = true;
+    }
+
+    result.ref_time = ref_time_;
+    result.fast_time = run(result.interp, result.chain, result.mode, *fast_view_, repeat);
+
+    measure_error(result);
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+AccuracyRunner<storage_T>::
+measure_error(AccuracyResult& result) const
+{
+    // both buffers have the same layout, so the channel values can be compared directly
+    const channel_storage_t* ref_data = static_cast<const channel_storage_t*>(ref_buffer_->data());
+    const channel_storage_t* fast_data = static_cast<const channel_storage_t*>(fast_buffer_->data());
+    const size_t num_vals = ref_buffer_->num_bytes() / sizeof(channel_storage_t);
+
+    double max_err(0.0);
+    double sum_err(0.0);
+    double sum_sq_err(0.0);
+
+    for (size_t i = 0; i < num_vals; ++i)
+    {
+        double err = std::fabs(static_cast<double>(fast_data[i]) - static_cast<double>(ref_data[i]));
+        max_err = (err > max_err) ? err : max_err;
+        sum_err += err;
+        sum_sq_err += err * err;
+    }
+
+    const double num = static_cast<double>(num_vals);
+    result.max_error = max_err;
+    result.mean_error = sum_err / num;
+
+    const double mse = sum_sq_err / num;
+    result.psnr = (mse > 0.0)
+                  ? 10.0 * std::log10(max_code() * max_code() / mse)
+                  : std::numeric_limits<double>::infinity();
+}
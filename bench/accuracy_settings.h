@@ -0,0 +1,117 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_ACCURACY_SETTINGS_H__
+#define PHTR_BENCH_ACCURACY_SETTINGS_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "settings.h"
+
+/**
+ * @brief The approximations ("fast paths") checked against the reference path.
+ * @details The values are bit flags; 'combined' enables all of them (which
+ * corresponds to the production configuration).
+ */
+struct FastMode
+{
+    enum type
+    {
+        // integer decoding table (ImageTransform::enable_int_lut())
+        int_lut = 1,
+        // radial model chains collapsed into one table (PixelCorrectionQueue::enable_radial_collapse())
+        radial_collapse = 2,
+        // radial lookup table of the geometry conversion
+        geom_lut = 4,
+        // r^2 lookup table of the vignetting model
+        vign_lut = 8,
+        // colour-only transformation without resampling
+        colour_path = 16,
+        // default precision of the gamma and output encoding tables
+        tables = 32,
+        combined = 63
+    };
+};
+
+struct TestChart
+{
+    enum type
+    {
+        noise,
+        gradient,
+        star,
+        file
+    };
+};
+
+struct AccuracySettings
+{
+    AccuracySettings()
+            : help(false),
+            verbose(false),
+            width(1500),
+            height(1000),
+            repeat(3),
+            max_error(2.0),
+            max_mean_error(0.05),
+            min_psnr(60.0),
+            json(false)
+    {
+        //NIL
+    }
+
+    // only the option list was requested
+    bool help;
+
+    bool verbose;
+
+    // size of the synthetic test charts
+    size_t width;
+    size_t height;
+
+    // number of timed runs per case (the fastest one is reported)
+    unsigned int repeat;
+
+    // sweep parameters
+    std::vector<phtr::mem::Storage::type> storage_types;
+    std::vector<InterpSpec> interpolations;
+    std::vector<ModelChain::type> model_chains;
+    std::vector<FastMode::type> fast_modes;
+    std::vector<TestChart::type> charts;
+
+    // real test chart (PPM/PGM file)
+    std::string chart_file;
+
+    // error bounds (in 8 bit code values, scaled for higher bit depths)
+    double max_error;
+    double max_mean_error;
+
+    // error bound: minimum PSNR in dB
+    double min_psnr;
+
+    // output
+    bool json;
+    std::string outp_file;
+};
+
+#endif // PHTR_BENCH_ACCURACY_SETTINGS_H__
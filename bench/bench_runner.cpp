@@ -0,0 +1,72 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "bench_runner.h"
+
+BenchRunnerBase*
+BenchRunnerBase::
+get_instance(phtr::mem::Storage::type storage_type, size_t width, size_t height)
+{
+    using phtr::mem::Storage;
+
+    switch (storage_type)
+    {
+        case Storage::rgb_8_inter:
+            return new BenchRunner<Storage::rgb_8_inter>(width, height);
+
+        case Storage::rgb_16_inter:
+            return new BenchRunner<Storage::rgb_16_inter>(width, height);
+
+        case Storage::rgb_32_inter:
+            return new BenchRunner<Storage::rgb_32_inter>(width, height);
+
+        case Storage::rgb_8_planar:
+            return new BenchRunner<Storage::rgb_8_planar>(width, height);
+
+        case Storage::rgb_16_planar:
+            return new BenchRunner<Storage::rgb_16_planar>(width, height);
+
+        case Storage::rgb_32_planar:
+            return new BenchRunner<Storage::rgb_32_planar>(width, height);
+
+        case Storage::rgba_8_inter:
+            return new BenchRunner<Storage::rgba_8_inter>(width, height);
+
+        case Storage::rgba_16_inter:
+            return new BenchRunner<Storage::rgba_16_inter>(width, height);
+
+        case Storage::rgba_32_inter:
+            return new BenchRunner<Storage::rgba_32_inter>(width, height);
+
+        case Storage::rgba_8_planar:
+            return new BenchRunner<Storage::rgba_8_planar>(width, height);
+
+        case Storage::rgba_16_planar:
+            return new BenchRunner<Storage::rgba_16_planar>(width, height);
+
+        case Storage::rgba_32_planar:
+            return new BenchRunner<Storage::rgba_32_planar>(width, height);
+
+        case Storage::unknown:
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,121 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_BENCH_RUNNER_H__
+#define PHTR_BENCH_BENCH_RUNNER_H__
+
+#include <memory>
+
+#include "settings.h"
+#include "perf_counters.h"
+
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/channel_storage.h>
+#include <photoropter/image_buffer.h>
+#include <photoropter/mem_image_view_r.h>
+#include <photoropter/mem_image_view_w.h>
+#include <photoropter/image_transform.h>
+#include <photoropter/transform_stats.h>
+
+/**
+ * @brief Timing results of a single benchmark run.
+ */
+struct BenchTiming
+{
+    BenchTiming()
+            : setup(0.0),
+            transform(0.0)
+    {
+        //NIL
+    }
+
+    // time taken to set up the transformation (models, lookup tables)
+    double setup;
+
+    // time taken by ImageTransform::do_transform()
+    double transform;
+
+    // per-stage statistics (only collected if built with PHTR_INSTRUMENT)
+    phtr::TransformStats stats;
+
+    // performance counters of setup and transformation (only if requested)
+    PerfCounts setup_counts;
+    PerfCounts transform_counts;
+};
+
+class BenchRunnerBase
+{
+
+    public:
+        /**
+         * @ brief (Dummy) Destructor.
+         */
+        virtual ~BenchRunnerBase() {};
+
+    public:
+        /**
+         * @brief Create a runner (including the synthetic test images) for the given storage type.
+         */
+        static BenchRunnerBase* get_instance(phtr::mem::Storage::type storage_type, size_t width, size_t height);
+
+        /**
+         * @brief Set up and perform one transformation.
+         * @details If @c counters is not null, the performance counters are read, too.
+         */
+        virtual BenchTiming run(const InterpSpec& interp, ModelChain::type chain, unsigned int oversampling,
+                                PerfCounters* counters) = 0;
+
+};
+
+template <phtr::mem::Storage::type storage_T>
+class BenchRunner : public BenchRunnerBase
+{
+    public:
+        typedef phtr::ImageBuffer<storage_T> buffer_t;
+        typedef phtr::MemImageViewR<storage_T> view_r_t;
+        typedef phtr::MemImageViewW<storage_T> view_w_t;
+        typedef typename phtr::mem::ChannelStorage<storage_T>::type channel_storage_t;
+
+        typedef phtr::InterpolatorLanczos<view_r_t> interp_lanczos_t;
+        typedef phtr::ImageTransform<interp_lanczos_t, view_w_t> transform_lanczos_t;
+
+    public:
+        BenchRunner(size_t width, size_t height);
+        BenchTiming run(const InterpSpec& interp, ModelChain::type chain, unsigned int oversampling,
+                        PerfCounters* counters);
+
+    private:
+        void fill_input();
+
+    private:
+        size_t width_;
+        size_t height_;
+
+        std::auto_ptr<buffer_t> input_buffer_;
+        std::auto_ptr<buffer_t> output_buffer_;
+
+        std::auto_ptr<view_r_t> input_view_;
+        std::auto_ptr<view_w_t> output_view_;
+};
+
+#include "bench_runner.tpl.h"
+
+#endif // PHTR_BENCH_BENCH_RUNNER_H__
@@ -0,0 +1,104 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <photoropter/wall_timer.h>
+
+#include "model_chain.h"
+
+template <phtr::mem::Storage::type storage_T>
+BenchRunner<storage_T>::
+BenchRunner(size_t width, size_t height)
+        : width_(width),
+        height_(height)
+{
+    input_buffer_.reset(new buffer_t(width_, height_));
+    output_buffer_.reset(new buffer_t(width_, height_));
+    input_view_.reset(new view_r_t(input_buffer_->data(), width_, height_));
+    output_view_.reset(new view_w_t(output_buffer_->data(), width_, height_));
+
+    fill_input();
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+BenchRunner<storage_T>::
+fill_input()
+{
+    // deterministic pseudo-random content over the full channel range
+    // (so that no interpolation or gamma shortcut is favoured)
+    channel_storage_t* data = static_cast<channel_storage_t*>(input_buffer_->data());
+    size_t num_vals = input_buffer_->num_bytes() / sizeof(channel_storage_t);
+    const unsigned int shift = 32 - 8 * sizeof(channel_storage_t);
+
+    uint32_t state(0x12345678);
+    for (size_t i = 0; i < num_vals; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        data[i] = static_cast<channel_storage_t>(state >> shift);
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+BenchTiming
+BenchRunner<storage_T>::
+run(const InterpSpec& interp, ModelChain::type chain, unsigned int oversampling,
+    PerfCounters* counters)
+{
+    using phtr::Interpolation;
+
+    BenchTiming timing;
+    if (counters)
+    {
+        counters->start();
+    }
+    phtr::WallTimer timer;
+
+    std::auto_ptr<phtr::IImageTransform> transform(
+        phtr::get_image_transform(interp.type, *input_view_, *output_view_));
+
+    if (interp.type == Interpolation::lanczos)
+    {
+        transform_lanczos_t& lanczos_transform = dynamic_cast<transform_lanczos_t&>(*transform);
+        lanczos_transform.interpolator().set_support(interp.support);
+    }
+
+    add_model_chain(*transform, chain, input_view_->aspect_ratio(),
+                    view_r_t::storage_info_t::mem_layout_t::idx_red,
+                    view_r_t::storage_info_t::mem_layout_t::idx_blue);
+    transform->set_sampling_fact(oversampling);
+    timing.setup = timer.elapsed();
+    if (counters)
+    {
+        timing.setup_counts = counters->stop();
+        counters->start();
+    }
+
+    timer.start();
+    transform->do_transform();
+    timing.transform = timer.elapsed();
+    if (counters)
+    {
+        timing.transform_counts = counters->stop();
+    }
+    timing.stats = transform->stats();
+
+    return timing;
+}
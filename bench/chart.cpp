@@ -0,0 +1,181 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <stdint.h>
+
+#include "chart.h"
+
+namespace
+{
+
+    const double pi = 3.14159265358979323846;
+
+    // read the next header token of a PNM file (skipping comments)
+    bool read_pnm_token(std::istream& is, std::string& token)
+    {
+        token.clear();
+
+        int c = is.get();
+        while (is && (std::isspace(c) || c == '#'))
+        {
+            if (c == '#')
+            {
+                while (is && c != '\n')
+                {
+                    c = is.get();
+                }
+            }
+            c = is.get();
+        }
+
+        while (is && !std::isspace(c))
+        {
+            token.push_back(static_cast<char>(c));
+            c = is.get();
+        }
+
+        // exactly one whitespace character separates the header from the data
+        return !token.empty();
+    }
+
+} // anonymous namespace
+
+void make_chart(TestChart::type chart, size_t width, size_t height, ChartImage& image)
+{
+    image.width = width;
+    image.height = height;
+    image.values.resize(width * height * 3);
+
+    const double x_c = 0.5 * static_cast<double>(width - 1);
+    const double y_c = 0.5 * static_cast<double>(height - 1);
+
+    uint32_t state(0x12345678);
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            double* px = &image.values[(y * width + x) * 3];
+
+            const double dx = static_cast<double>(x) - x_c;
+            const double dy = static_cast<double>(y) - y_c;
+
+            switch (chart)
+            {
+                case TestChart::noise:
+                    // uncorrelated pseudo-random values (worst case for interpolation errors)
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        state = state * 1664525u + 1013904223u;
+                        px[c] = static_cast<double>(state) / 4294967295.0;
+                    }
+                    break;
+
+                case TestChart::gradient:
+                    // linear ramps and low-frequency rings (checks the tone curve tables)
+                    px[0] = static_cast<double>(x) / static_cast<double>(width - 1);
+                    px[1] = static_cast<double>(y) / static_cast<double>(height - 1);
+                    px[2] = 0.5 + 0.5 * std::cos(2.0 * pi * std::sqrt(dx * dx + dy * dy)
+                                                 / (0.125 * static_cast<double>(height)));
+                    break;
+
+                case TestChart::star:
+                default:
+                {
+                    // Siemens star with 36 spokes (sharp edges in all directions)
+                    const bool bright = std::sin(36.0 * std::atan2(dy, dx)) >= 0.0;
+                    px[0] = bright ? 0.9 : 0.1;
+                    px[1] = bright ? 0.8 : 0.2;
+                    px[2] = bright ? 0.1 : 0.9;
+                }
+                break;
+            }
+        }
+    }
+}
+
+bool load_pnm(const std::string& file_name, ChartImage& image)
+{
+    std::ifstream file(file_name.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Error: cannot open chart file '" << file_name << "'" << std::endl;
+        return false;
+    }
+
+    std::string magic;
+    std::string width_str;
+    std::string height_str;
+    std::string max_str;
+    if (!read_pnm_token(file, magic) || !read_pnm_token(file, width_str)
+        || !read_pnm_token(file, height_str) || !read_pnm_token(file, max_str)
+        || (magic != "P5" && magic != "P6"))
+    {
+        std::cerr << "Error: '" << file_name << "' is not a binary PPM/PGM file" << std::endl;
+        return false;
+    }
+
+    const size_t width = static_cast<size_t>(std::atol(width_str.c_str()));
+    const size_t height = static_cast<size_t>(std::atol(height_str.c_str()));
+    const long max_val = std::atol(max_str.c_str());
+    if (width < 2 || height < 2 || max_val < 1 || max_val > 65535)
+    {
+        std::cerr << "Error: unsupported PPM/PGM header in '" << file_name << "'" << std::endl;
+        return false;
+    }
+
+    const size_t num_chan = (magic == "P6") ? 3 : 1;
+    const size_t bytes_per_val = (max_val > 255) ? 2 : 1;
+    std::vector<unsigned char> data(width * height * num_chan * bytes_per_val);
+
+    file.read(reinterpret_cast<char*>(&data[0]), static_cast<std::streamsize>(data.size()));
+    if (!file)
+    {
+        std::cerr << "Error: '" << file_name << "' is truncated" << std::endl;
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.values.resize(width * height * 3);
+
+    const double scale = 1.0 / static_cast<double>(max_val);
+    for (size_t i = 0; i < width * height; ++i)
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            // grey images are replicated into all channels
+            size_t k = i * num_chan + ((num_chan == 3) ? c : 0);
+            unsigned int val = (bytes_per_val == 2)
+                               ? ((static_cast<unsigned int>(data[2 * k]) << 8) | data[2 * k + 1])
+                               : data[k];
+            image.values[i * 3 + c] = static_cast<double>(val) * scale;
+        }
+    }
+
+    return true;
+}
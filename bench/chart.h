@@ -0,0 +1,61 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_CHART_H__
+#define PHTR_BENCH_CHART_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "accuracy_settings.h"
+
+/**
+ * @brief A test chart: RGB values in [0, 1].
+ */
+struct ChartImage
+{
+    ChartImage()
+            : width(0),
+            height(0)
+    {
+        //NIL
+    }
+
+    double value(size_t x, size_t y, size_t channel) const
+    {
+        return values[(y * width + x) * 3 + channel];
+    }
+
+    size_t width;
+    size_t height;
+
+    // RGB triplets, row by row
+    std::vector<double> values;
+};
+
+// create a synthetic chart (noise, gradient or star)
+void make_chart(TestChart::type chart, size_t width, size_t height, ChartImage& image);
+
+// load a binary PPM (P6) or PGM (P5) file with 8 or 16 bits per channel
+bool load_pnm(const std::string& file_name, ChartImage& image);
+
+#endif // PHTR_BENCH_CHART_H__
@@ -0,0 +1,383 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/image_buffer.h>
+#include <photoropter/mem_image_view_r.h>
+#include <photoropter/interpolator/interpolator_nn.h>
+#include <photoropter/interpolator/interpolator_bilinear.h>
+#include <photoropter/interpolator/interpolator_lanczos.h>
+#include <photoropter/geom/rectilinear.h>
+#include <photoropter/geom/fisheye_equidist.h>
+#include <photoropter/geom/fisheye_equisolid.h>
+#include <photoropter/geom/fisheye_ortho.h>
+#include <photoropter/geom/fisheye_stereo.h>
+#include <photoropter/model/ptlens_pixel_model.h>
+#include <photoropter/model/vignetting_colour_model.h>
+#include <photoropter/gamma_func.h>
+#include <photoropter/wall_timer.h>
+
+#include "microbench.h"
+
+namespace
+{
+
+    using namespace phtr;
+
+    const double pi = 3.14159265358979323846;
+
+    // the input batch: a grid of positions in normalised coordinates (row by row,
+    // i.e., in the order a transformation visits them), plus derived inputs
+    struct Batch
+    {
+        Batch(size_t width, size_t height)
+                : aspect(static_cast<double>(width) / static_cast<double>(height)),
+                num(width * height),
+                x(num),
+                y(num),
+                phi(num),
+                theta(num),
+                val(num)
+        {
+            for (size_t j = 0; j < height; ++j)
+            {
+                for (size_t i = 0; i < width; ++i)
+                {
+                    // pixel centres (never exactly on the optical axis)
+                    const size_t k = j * width + i;
+                    x[k] = ((static_cast<double>(i) + 0.5) / static_cast<double>(width) * 2.0 - 1.0) * aspect;
+                    y[k] = (static_cast<double>(j) + 0.5) / static_cast<double>(height) * 2.0 - 1.0;
+
+                    // angles covering up to ~70 degrees off-axis
+                    phi[k] = std::atan2(y[k], x[k]);
+                    theta[k] = 1.2 * std::sqrt(x[k] * x[k] + y[k] * y[k]) / std::sqrt(1.0 + aspect * aspect);
+
+                    // channel values in [0, 1]
+                    val[k] = static_cast<double>(k % 4096) / 4095.0;
+                }
+            }
+        }
+
+        double aspect;
+        size_t num;
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> phi;
+        std::vector<double> theta;
+        std::vector<double> val;
+    };
+
+    // time op(k) for all positions of the batch, return the fastest run in ns per position
+    template <typename op_T>
+    double time_op(const op_T& op, size_t num, unsigned int repeat, double& checksum)
+    {
+        double best_time(0.0);
+
+        for (unsigned int r = 0; r < repeat; ++r)
+        {
+            double sum(0.0);
+
+            WallTimer timer;
+            for (size_t k = 0; k < num; ++k)
+            {
+                sum += op(k);
+            }
+            double time = timer.elapsed();
+
+            if (r == 0 || time < best_time)
+            {
+                best_time = time;
+            }
+            checksum = sum;
+        }
+
+        return best_time * 1e9 / static_cast<double>(num);
+    }
+
+    // components
+
+    template <typename coord_tuple_T>
+    struct PTLensOp
+    {
+        PTLensOp(const model::PTLensPixelModel& model_, const Batch& batch_)
+                : model(model_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            coord_tuple_T coords;
+            const size_t num_vals = sizeof(coords.x) / sizeof(coords.x[0]);
+            for (size_t c = 0; c < num_vals; ++c)
+            {
+                coords.x[c] = batch.x[k];
+                coords.y[c] = batch.y[k];
+            }
+            model.get_src_coords(coords);
+            return coords.x[0] + coords.y[num_vals - 1];
+        }
+
+        const model::PTLensPixelModel& model;
+        const Batch& batch;
+    };
+
+    template <typename geom_T>
+    struct ToSphericalOp
+    {
+        ToSphericalOp(const geom_T& geom_, const Batch& batch_)
+                : geom(geom_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            double phi(0);
+            double theta(0);
+            return geom.to_spherical_coords(batch.x[k], batch.y[k], phi, theta) ? (phi + theta) : 0.0;
+        }
+
+        const geom_T& geom;
+        const Batch& batch;
+    };
+
+    template <typename geom_T>
+    struct ToCartesianOp
+    {
+        ToCartesianOp(const geom_T& geom_, const Batch& batch_)
+                : geom(geom_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            double x(0);
+            double y(0);
+            return geom.to_cartesian_coords(batch.phi[k], batch.theta[k], x, y) ? (x + y) : 0.0;
+        }
+
+        const geom_T& geom;
+        const Batch& batch;
+    };
+
+    struct VignettingOp
+    {
+        VignettingOp(const model::VignettingColourModel& model_, const Batch& batch_)
+                : model(model_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            mem::CoordTupleRGB coords;
+            mem::ColourTupleRGB factors;
+            for (size_t c = 0; c < 3; ++c)
+            {
+                coords.x[c] = batch.x[k];
+                coords.y[c] = batch.y[k];
+            }
+            model.get_correction_factors(coords, factors);
+            return factors.value[0];
+        }
+
+        const model::VignettingColourModel& model;
+        const Batch& batch;
+    };
+
+    template <typename interpolator_T>
+    struct InterpolatorOp
+    {
+        InterpolatorOp(const interpolator_T& interpolator_, const Batch& batch_)
+                : interpolator(interpolator_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            return interpolator.get_px_val(Channel::red, batch.x[k], batch.y[k]);
+        }
+
+        const interpolator_T& interpolator;
+        const Batch& batch;
+    };
+
+    struct GammaOp
+    {
+        GammaOp(const gamma::IGammaFunc& func_, bool inverse_, const Batch& batch_)
+                : func(func_),
+                inverse(inverse_),
+                batch(batch_)
+        {
+            //NIL
+        }
+
+        double operator()(size_t k) const
+        {
+            return inverse ? func.inv_gamma(batch.val[k]) : func.gamma(batch.val[k]);
+        }
+
+        const gamma::IGammaFunc& func;
+        bool inverse;
+        const Batch& batch;
+    };
+
+    // runs the components, skipping the ones not selected by the filters
+    class MicroRunner
+    {
+        public:
+            MicroRunner(const MicroSettings& settings, const Batch& batch, std::vector<MicroResult>& results)
+                    : settings_(settings),
+                    batch_(batch),
+                    results_(results)
+            {
+                //NIL
+            }
+
+            template <typename op_T>
+            void run(const std::string& name, const op_T& op)
+            {
+                if (!selected(name))
+                {
+                    return;
+                }
+
+                double checksum(0.0);
+                double ns_per_px = time_op(op, batch_.num, settings_.repeat, checksum);
+                results_.push_back(MicroResult(name, ns_per_px, checksum));
+
+                if (settings_.verbose)
+                {
+                    std::cerr << name << ": " << ns_per_px << " ns/px" << std::endl;
+                }
+            }
+
+            template <typename geom_T>
+            void run_geom(const std::string& name)
+            {
+                geom_T geom;
+                geom.set_focal_length(2.0);
+                run(name + "::to_spherical_coords", ToSphericalOp<geom_T>(geom, batch_));
+                run(name + "::to_cartesian_coords", ToCartesianOp<geom_T>(geom, batch_));
+            }
+
+        private:
+            bool selected(const std::string& name) const
+            {
+                if (settings_.filters.empty())
+                {
+                    return true;
+                }
+
+                for (size_t i = 0; i < settings_.filters.size(); ++i)
+                {
+                    if (name.find(settings_.filters[i]) != std::string::npos)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        private:
+            const MicroSettings& settings_;
+            const Batch& batch_;
+            std::vector<MicroResult>& results_;
+    };
+
+} // anonymous namespace
+
+void run_micro_benchmarks(const MicroSettings& settings, std::vector<MicroResult>& results)
+{
+    typedef MemImageViewR<mem::Storage::rgb_8_inter> view_r_t;
+
+    const Batch batch(settings.width, settings.height);
+    MicroRunner runner(settings, batch, results);
+
+    // pixel model (typical wide-angle parameters, cf. phtr-bench)
+    model::PTLensPixelModel ptlens_mod(batch.aspect);
+    ptlens_mod.set_model_params(0.0, 0.00987, -0.05127);
+    runner.run("PTLensPixelModel::get_src_coords(mono)", PTLensOp<mem::CoordTupleMono>(ptlens_mod, batch));
+    runner.run("PTLensPixelModel::get_src_coords(rgb)", PTLensOp<mem::CoordTupleRGB>(ptlens_mod, batch));
+
+    // projections
+    runner.run_geom<geom::Rectilinear>("geom::Rectilinear");
+    runner.run_geom<geom::FisheyeEquidist>("geom::FisheyeEquidist");
+    runner.run_geom<geom::FisheyeEquisolid>("geom::FisheyeEquisolid");
+    runner.run_geom<geom::FisheyeOrtho>("geom::FisheyeOrtho");
+    runner.run_geom<geom::FisheyeStereo>("geom::FisheyeStereo");
+
+    // colour models
+    model::HuginVignettingModel vign_mod(batch.aspect);
+    vign_mod.set_model_params(0.0, 0.0, -0.3);
+    runner.run("HuginVignettingModel::get_correction_factors", VignettingOp(vign_mod, batch));
+    vign_mod.enable_radial_lut(true);
+    runner.run("HuginVignettingModel::get_correction_factors(lut)", VignettingOp(vign_mod, batch));
+
+    // interpolators (pseudo-random 8 bit image of the batch size)
+    ImageBuffer<mem::Storage::rgb_8_inter> buffer(settings.width, settings.height);
+    unsigned char* data = static_cast<unsigned char*>(buffer.data());
+    unsigned long state(0x12345678);
+    for (size_t i = 0; i < buffer.num_bytes(); ++i)
+    {
+        state = (state * 1664525ul + 1013904223ul) & 0xfffffffful;
+        data[i] = static_cast<unsigned char>(state >> 24);
+    }
+    view_r_t view(buffer.data(), settings.width, settings.height);
+
+    InterpolatorNN<view_r_t> interp_nn(view);
+    runner.run("InterpolatorNN::get_px_val", InterpolatorOp<InterpolatorNN<view_r_t> >(interp_nn, batch));
+    InterpolatorBilinear<view_r_t> interp_bilin(view);
+    runner.run("InterpolatorBilinear::get_px_val",
+               InterpolatorOp<InterpolatorBilinear<view_r_t> >(interp_bilin, batch));
+    for (unsigned int support = 2; support <= 4; ++support)
+    {
+        std::ostringstream name;
+        name << "InterpolatorLanczos" << support << "::get_px_val";
+        InterpolatorLanczos<view_r_t> interp_lanczos(view);
+        interp_lanczos.set_support(support);
+        runner.run(name.str(), InterpolatorOp<InterpolatorLanczos<view_r_t> >(interp_lanczos, batch));
+    }
+
+    // gamma functions (default EMoR coefficients, i.e., the mean curve)
+    gamma::GammaSRGB gamma_srgb;
+    runner.run("GammaSRGB::gamma", GammaOp(gamma_srgb, false, batch));
+    runner.run("GammaSRGB::inv_gamma", GammaOp(gamma_srgb, true, batch));
+    gamma::GammaEMOR gamma_emor;
+    runner.run("GammaEMOR::gamma", GammaOp(gamma_emor, false, batch));
+    runner.run("GammaEMOR::inv_gamma", GammaOp(gamma_emor, true, batch));
+    gamma::GammaInvEMOR gamma_inv_emor;
+    runner.run("GammaInvEMOR::gamma", GammaOp(gamma_inv_emor, false, batch));
+    runner.run("GammaInvEMOR::inv_gamma", GammaOp(gamma_inv_emor, true, batch));
+}
@@ -0,0 +1,87 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_MICROBENCH_H__
+#define PHTR_BENCH_MICROBENCH_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MicroSettings
+{
+    MicroSettings()
+            : help(false),
+            verbose(false),
+            width(1500),
+            height(1000),
+            repeat(5),
+            json(false)
+    {
+        //NIL
+    }
+
+    // only the option list was requested
+    bool help;
+
+    bool verbose;
+
+    // size of the coordinate batch (and of the interpolators' test image)
+    size_t width;
+    size_t height;
+
+    // number of timed runs per component (the fastest one is reported)
+    unsigned int repeat;
+
+    // only run components whose name contains one of these strings (all if empty)
+    std::vector<std::string> filters;
+
+    // output
+    bool json;
+    std::string outp_file;
+};
+
+/**
+ * @brief Timing of one component.
+ */
+struct MicroResult
+{
+    MicroResult(const std::string& name_, double ns_per_px_, double checksum_)
+            : name(name_),
+            ns_per_px(ns_per_px_),
+            checksum(checksum_)
+    {
+        //NIL
+    }
+
+    std::string name;
+
+    // time per evaluation (i.e., per pixel) in nanoseconds, fastest run
+    double ns_per_px;
+
+    // sum of all results (keeps the compiler from discarding the work)
+    double checksum;
+};
+
+// time all (selected) components, single-threaded
+void run_micro_benchmarks(const MicroSettings& settings, std::vector<MicroResult>& results);
+
+#endif // PHTR_BENCH_MICROBENCH_H__
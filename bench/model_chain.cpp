@@ -0,0 +1,70 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <memory>
+
+#include <photoropter/model/vignetting_colour_model.h>
+#include <photoropter/model/ptlens_pixel_model.h>
+#include <photoropter/model/scaler_pixel_model.h>
+#include <photoropter/model/geometry_convert_pixel_model.h>
+
+#include "model_chain.h"
+
+void add_model_chain(phtr::IImageTransform& transform, ModelChain::type chain, double image_aspect,
+                     size_t idx_red, size_t idx_blue, bool geom_lut, bool vign_lut)
+{
+    using namespace phtr;
+
+    double param_aspect = (image_aspect > 1) ? image_aspect : (1 / image_aspect);
+
+    if (chain == ModelChain::tca || chain == ModelChain::all)
+    {
+        model::ScalerPixelModel scaler_tca_mod(param_aspect, image_aspect, 1.0, 1.0);
+        scaler_tca_mod.set_model_param_single(idx_red, 1.0003);
+        scaler_tca_mod.set_model_param_single(idx_blue, 0.9997);
+        transform.subpixel_queue().add_model(scaler_tca_mod);
+    }
+
+    if (chain == ModelChain::ptlens || chain == ModelChain::all)
+    {
+        model::PTLensPixelModel ptlens_mod(param_aspect, image_aspect, 1.0, 1.0);
+        ptlens_mod.set_model_params(0.0, 0.00987, -0.05127);
+        transform.pixel_queue().add_model(ptlens_mod);
+    }
+
+    if (chain == ModelChain::geometry || chain == ModelChain::all)
+    {
+        std::auto_ptr<model::IGeometryConvertPixelModel> geom_conv_mod(
+            model::get_geometry_conversion(Geometry::fisheye_equisolid, Geometry::rectilinear,
+                                           image_aspect, 1.0));
+        geom_conv_mod->set_focal_lengths(10.0, 10.0);
+        geom_conv_mod->enable_radial_lut(geom_lut);
+        transform.pixel_queue().add_model(*geom_conv_mod);
+    }
+
+    if (chain == ModelChain::vignetting || chain == ModelChain::all)
+    {
+        model::HuginVignettingModel vign_mod(param_aspect, image_aspect, 1.0, 1.0);
+        vign_mod.set_model_params(0.0, 0.0, -0.3);
+        vign_mod.enable_radial_lut(vign_lut);
+        transform.colour_queue().add_model(vign_mod);
+    }
+}
@@ -0,0 +1,44 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_MODEL_CHAIN_H__
+#define PHTR_BENCH_MODEL_CHAIN_H__
+
+#include <cstddef>
+
+#include <photoropter/image_transform.h>
+
+#include "settings.h"
+
+/**
+ * @brief Add the correction models of a model chain (typical parameters of a wide-angle zoom lens).
+ * @param transform    The transformation.
+ * @param chain        The model chain.
+ * @param image_aspect The aspect ratio of the input image.
+ * @param idx_red      Tuple index of the red channel (cf. mem::MemLayout).
+ * @param idx_blue     Tuple index of the blue channel.
+ * @param geom_lut     Enable the radial lookup table of the geometry conversion.
+ * @param vign_lut     Enable the radial lookup table of the vignetting model.
+ */
+void add_model_chain(phtr::IImageTransform& transform, ModelChain::type chain, double image_aspect,
+                     size_t idx_red, size_t idx_blue, bool geom_lut = false, bool vign_lut = false);
+
+#endif // PHTR_BENCH_MODEL_CHAIN_H__
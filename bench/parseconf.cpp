@@ -0,0 +1,480 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <iostream>
+#include <sstream>
+#include <list>
+
+#include <boost/program_options.hpp>
+#include <boost/tokenizer.hpp>
+namespace po = boost::program_options;
+
+#include "parseconf.h"
+
+namespace
+{
+
+    struct StorageName
+    {
+        const char* name;
+        phtr::mem::Storage::type storage_type;
+    };
+
+    const StorageName storage_names[] =
+    {
+        { "rgb8", phtr::mem::Storage::rgb_8_inter },
+        { "rgb16", phtr::mem::Storage::rgb_16_inter },
+        { "rgb32", phtr::mem::Storage::rgb_32_inter },
+        { "rgb8p", phtr::mem::Storage::rgb_8_planar },
+        { "rgb16p", phtr::mem::Storage::rgb_16_planar },
+        { "rgb32p", phtr::mem::Storage::rgb_32_planar },
+        { "rgba8", phtr::mem::Storage::rgba_8_inter },
+        { "rgba16", phtr::mem::Storage::rgba_16_inter },
+        { "rgba32", phtr::mem::Storage::rgba_32_inter },
+        { "rgba8p", phtr::mem::Storage::rgba_8_planar },
+        { "rgba16p", phtr::mem::Storage::rgba_16_planar },
+        { "rgba32p", phtr::mem::Storage::rgba_32_planar }
+    };
+
+    const size_t num_storage_names = sizeof(storage_names) / sizeof(storage_names[0]);
+
+    struct ModelChainName
+    {
+        const char* name;
+        ModelChain::type chain;
+    };
+
+    const ModelChainName model_chain_names[] =
+    {
+        { "none", ModelChain::none },
+        { "ptlens", ModelChain::ptlens },
+        { "tca", ModelChain::tca },
+        { "vign", ModelChain::vignetting },
+        { "geom", ModelChain::geometry },
+        { "full", ModelChain::all }
+    };
+
+    const size_t num_model_chain_names = sizeof(model_chain_names) / sizeof(model_chain_names[0]);
+
+    // the Lanczos supports used for '--interpolation all'
+    const unsigned int lanczos_supports[] = { 2, 3, 4 };
+
+    const size_t num_lanczos_supports = sizeof(lanczos_supports) / sizeof(lanczos_supports[0]);
+
+    std::list<std::string> split_list(const std::string& param_string)
+    {
+        typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+        typedef boost::char_separator<char> separator_t;
+
+        separator_t sep(",;");
+        tokenizer_t tokens(param_string, sep);
+
+        std::list<std::string> tmp_list;
+        for (tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        {
+            tmp_list.push_back(*it);
+        }
+
+        return tmp_list;
+    }
+
+} // anonymous namespace
+
+bool parse_storage_list(const std::string& param_string, std::vector<phtr::mem::Storage::type>& storage_types)
+{
+    std::list<std::string> tokens = split_list(param_string);
+
+    for (std::list<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+    {
+        if (*it == "all")
+        {
+            for (size_t i = 0; i < num_storage_names; ++i)
+            {
+                storage_types.push_back(storage_names[i].storage_type);
+            }
+            continue;
+        }
+
+        bool found(false);
+        for (size_t i = 0; i < num_storage_names; ++i)
+        {
+            if (*it == storage_names[i].name)
+            {
+                storage_types.push_back(storage_names[i].storage_type);
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            std::cerr << "Error: unknown storage type '" << *it << "'" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool parse_interpolation_list(const std::string& param_string, std::vector<InterpSpec>& interpolations)
+{
+    using phtr::Interpolation;
+
+    std::list<std::string> tokens = split_list(param_string);
+    const std::string lanczos_prefix("lanczos");
+
+    for (std::list<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+    {
+        if (*it == "all")
+        {
+            interpolations.push_back(InterpSpec(Interpolation::nearest_neighbour, 0));
+            interpolations.push_back(InterpSpec(Interpolation::bilinear, 0));
+            for (size_t i = 0; i < num_lanczos_supports; ++i)
+            {
+                interpolations.push_back(InterpSpec(Interpolation::lanczos, lanczos_supports[i]));
+            }
+        }
+        else if (*it == "nn")
+        {
+            interpolations.push_back(InterpSpec(Interpolation::nearest_neighbour, 0));
+        }
+        else if (*it == "bilin")
+        {
+            interpolations.push_back(InterpSpec(Interpolation::bilinear, 0));
+        }
+        else if (it->compare(0, lanczos_prefix.size(), lanczos_prefix) == 0)
+        {
+            // 'lanczos' (default support) or 'lanczosN'
+            unsigned int support(2);
+            if (it->size() > lanczos_prefix.size())
+            {
+                std::stringstream sstr(it->substr(lanczos_prefix.size()));
+                sstr >> support;
+                if (sstr.fail() || support < 1)
+                {
+                    std::cerr << "Error: invalid Lanczos support in '" << *it << "'" << std::endl;
+                    return false;
+                }
+            }
+            interpolations.push_back(InterpSpec(Interpolation::lanczos, support));
+        }
+        else
+        {
+            std::cerr << "Error: unknown interpolation type '" << *it << "'" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool parse_model_chain_list(const std::string& param_string, std::vector<ModelChain::type>& model_chains)
+{
+    std::list<std::string> tokens = split_list(param_string);
+
+    for (std::list<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+    {
+        if (*it == "all")
+        {
+            for (size_t i = 0; i < num_model_chain_names; ++i)
+            {
+                model_chains.push_back(model_chain_names[i].chain);
+            }
+            continue;
+        }
+
+        bool found(false);
+        for (size_t i = 0; i < num_model_chain_names; ++i)
+        {
+            if (*it == model_chain_names[i].name)
+            {
+                model_chains.push_back(model_chain_names[i].chain);
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            std::cerr << "Error: unknown model chain '" << *it << "'" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool parse_uint_list(const std::string& param_string, const char* what, std::vector<unsigned int>& values)
+{
+    std::list<std::string> tokens = split_list(param_string);
+
+    for (std::list<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+    {
+        std::stringstream sstr(*it);
+        unsigned int tmp_val(0);
+        sstr >> tmp_val;
+
+        if (sstr.fail() || tmp_val < 1)
+        {
+            std::cerr << "Error: invalid value '" << *it << "' for " << what << std::endl;
+            return false;
+        }
+
+        values.push_back(tmp_val);
+    }
+
+    return true;
+}
+
+bool parse_image_size(const std::string& param_string, size_t& width, size_t& height)
+{
+    std::stringstream sstr(param_string);
+    size_t tmp_width(0);
+    size_t tmp_height(0);
+    char sep(0);
+    sstr >> tmp_width >> sep >> tmp_height;
+
+    if (sstr.fail() || (sep != 'x' && sep != 'X') || tmp_width < 2 || tmp_height < 2)
+    {
+        std::cerr << "Error: invalid image size '" << param_string << "'" << std::endl;
+        return false;
+    }
+
+    width = tmp_width;
+    height = tmp_height;
+    return true;
+}
+
+const char* storage_name(phtr::mem::Storage::type storage_type)
+{
+    for (size_t i = 0; i < num_storage_names; ++i)
+    {
+        if (storage_names[i].storage_type == storage_type)
+        {
+            return storage_names[i].name;
+        }
+    }
+
+    return "unknown";
+}
+
+const char* interpolation_name(phtr::Interpolation::type interp_type)
+{
+    using phtr::Interpolation;
+
+    switch (interp_type)
+    {
+        case Interpolation::nearest_neighbour:
+            return "nn";
+
+        case Interpolation::bilinear:
+            return "bilin";
+
+        case Interpolation::lanczos:
+            return "lanczos";
+
+        default:
+            return "unknown";
+    }
+}
+
+const char* model_chain_name(ModelChain::type chain)
+{
+    for (size_t i = 0; i < num_model_chain_names; ++i)
+    {
+        if (model_chain_names[i].chain == chain)
+        {
+            return model_chain_names[i].name;
+        }
+    }
+
+    return "unknown";
+}
+
+bool parse_command_line(int argc, char* argv[], Settings& settings)
+{
+
+    try
+    {
+
+        po::options_description opt_desc("Allowed options");
+        opt_desc.add_options()
+        ("help,h", "show options")
+        ("verbose,v", "be verbose")
+        ("size,s", po::value<std::string>(), "Size of the synthetic test image: WxH (default: 3000x2000)")
+        ("storage", po::value<std::string>(), "Comma-separated list of storage types, or 'all' (default: rgb8,rgb16):\n"
+         "  rgb8, rgb16, rgb32       - RGB, interleaved\n"
+         "  rgb8p, rgb16p, rgb32p    - RGB, planar\n"
+         "  rgba8, rgba16, rgba32    - RGBA, interleaved\n"
+         "  rgba8p, rgba16p, rgba32p - RGBA, planar")
+        ("interpolation,i", po::value<std::string>(), "Comma-separated list of interpolation types, or 'all'"
+         " (default: nn,bilin,lanczos2,lanczos3):\n"
+         "  nn       - Nearest Neighbour\n"
+         "  bilin    - Bilinear\n"
+         "  lanczosN - Lanczos with support N")
+        ("models,m", po::value<std::string>(), "Comma-separated list of model chains, or 'all'"
+         " (default: ptlens,tca,vign,geom,full):\n"
+         "  none   - no correction models\n"
+         "  ptlens - PTLens geometric correction\n"
+         "  tca    - linear TCA correction\n"
+         "  vign   - vignetting correction\n"
+         "  geom   - equisolid fisheye to rectilinear conversion\n"
+         "  full   - all of the above")
+        ("oversample", po::value<std::string>(), "Comma-separated list of sampling factors (default: 1)")
+        ("threads,t", po::value<std::string>(), "Comma-separated list of thread counts"
+         " (default: maximum number of threads)")
+        ("repeat,n", po::value<unsigned>(), "Number of timed runs per case (default: 3)")
+        ("perf", "Read hardware performance counters (Linux perf_event_open)")
+        ("json", "Write results as JSON")
+        ("output-file,o", po::value<std::string>(), "Output file (default: standard output)");
+
+        po::variables_map options_map;
+        po::store(po::parse_command_line(argc, argv, opt_desc), options_map);
+        po::notify(options_map);
+
+        if (options_map.count("help"))
+        {
+            std::cout << opt_desc << std::endl;
+            settings.help = true;
+            return true;
+        }
+
+        if (options_map.count("verbose"))
+        {
+            settings.verbose = true;
+        }
+
+        if (options_map.count("size"))
+        {
+            if (!parse_image_size(options_map["size"].as<std::string>(), settings.width, settings.height))
+            {
+                return false;
+            }
+        }
+
+        if (options_map.count("storage"))
+        {
+            if (!parse_storage_list(options_map["storage"].as<std::string>(), settings.storage_types))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            settings.storage_types.push_back(phtr::mem::Storage::rgb_8_inter);
+            settings.storage_types.push_back(phtr::mem::Storage::rgb_16_inter);
+        }
+
+        if (options_map.count("interpolation"))
+        {
+            if (!parse_interpolation_list(options_map["interpolation"].as<std::string>(), settings.interpolations))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            using phtr::Interpolation;
+            settings.interpolations.push_back(InterpSpec(Interpolation::nearest_neighbour, 0));
+            settings.interpolations.push_back(InterpSpec(Interpolation::bilinear, 0));
+            settings.interpolations.push_back(InterpSpec(Interpolation::lanczos, 2));
+            settings.interpolations.push_back(InterpSpec(Interpolation::lanczos, 3));
+        }
+
+        if (options_map.count("models"))
+        {
+            if (!parse_model_chain_list(options_map["models"].as<std::string>(), settings.model_chains))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            settings.model_chains.push_back(ModelChain::ptlens);
+            settings.model_chains.push_back(ModelChain::tca);
+            settings.model_chains.push_back(ModelChain::vignetting);
+            settings.model_chains.push_back(ModelChain::geometry);
+            settings.model_chains.push_back(ModelChain::all);
+        }
+
+        if (options_map.count("oversample"))
+        {
+            if (!parse_uint_list(options_map["oversample"].as<std::string>(), "sampling factor",
+                                 settings.oversampling))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            settings.oversampling.push_back(1);
+        }
+
+        // an empty list means 'use the default number of threads'
+        if (options_map.count("threads"))
+        {
+            if (!parse_uint_list(options_map["threads"].as<std::string>(), "thread count",
+                                 settings.threads))
+            {
+                return false;
+            }
+        }
+
+        if (options_map.count("repeat"))
+        {
+            settings.repeat = options_map["repeat"].as<unsigned>();
+            if (settings.repeat < 1)
+            {
+                std::cerr << "Error: repeat count has to be at least 1" << std::endl;
+                return false;
+            }
+        }
+
+        if (options_map.count("perf"))
+        {
+            settings.perf_counters = true;
+        }
+
+        if (options_map.count("json"))
+        {
+            settings.json = true;
+        }
+
+        if (options_map.count("output-file"))
+        {
+            settings.outp_file = options_map["output-file"].as<std::string>();
+        }
+
+    }
+    catch (po::unknown_option& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "Try option '--help'" << std::endl;
+        return false;
+    }
+    catch (po::error& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
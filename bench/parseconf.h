@@ -0,0 +1,43 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_PARSECONF_H__
+#define PHTR_BENCH_PARSECONF_H__
+
+#include <string>
+#include <vector>
+
+#include "settings.h"
+
+bool parse_command_line(int argc, char* argv[], Settings& settings);
+
+// helpers for comma-separated lists (shared with phtr-accuracy); print an error and return false on failure
+bool parse_storage_list(const std::string& param_string, std::vector<phtr::mem::Storage::type>& storage_types);
+bool parse_interpolation_list(const std::string& param_string, std::vector<InterpSpec>& interpolations);
+bool parse_model_chain_list(const std::string& param_string, std::vector<ModelChain::type>& model_chains);
+bool parse_uint_list(const std::string& param_string, const char* what, std::vector<unsigned int>& values);
+bool parse_image_size(const std::string& param_string, size_t& width, size_t& height);
+
+const char* storage_name(phtr::mem::Storage::type storage_type);
+const char* interpolation_name(phtr::Interpolation::type interp_type);
+const char* model_chain_name(ModelChain::type chain);
+
+#endif // PHTR_BENCH_PARSECONF_H__
@@ -0,0 +1,277 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+#include "perf_counters.h"
+
+PerfCounts::
+PerfCounts()
+{
+    clear();
+}
+
+void
+PerfCounts::
+clear()
+{
+    for (size_t e = 0; e < PerfEvent::num_events; ++e)
+    {
+        values[e] = 0;
+        valid[e] = false;
+    }
+}
+
+PerfCounts&
+PerfCounts::
+operator+=(const PerfCounts& other)
+{
+    for (size_t e = 0; e < PerfEvent::num_events; ++e)
+    {
+        values[e] += other.values[e];
+        valid[e] = valid[e] || other.valid[e];
+    }
+
+    return *this;
+}
+
+const char*
+PerfCounts::
+event_name(PerfEvent::type event)
+{
+    switch (event)
+    {
+        case PerfEvent::task_clock:
+            return "task_clock_ns";
+        case PerfEvent::cycles:
+            return "cycles";
+        case PerfEvent::instructions:
+            return "instructions";
+        case PerfEvent::l1d_misses:
+            return "l1d_read_misses";
+        case PerfEvent::llc_misses:
+            return "llc_read_misses";
+        case PerfEvent::branch_misses:
+            return "branch_misses";
+        default:
+            break;
+    }
+
+    return "unknown";
+}
+
+PerfCounters::
+PerfCounters()
+        : num_threads_(0)
+{
+    //NIL
+}
+
+PerfCounters::
+~PerfCounters()
+{
+#ifdef __linux__
+    for (size_t i = 0; i < fds_.size(); ++i)
+    {
+        if (fds_[i] >= 0)
+        {
+            close(fds_[i]);
+        }
+    }
+#endif
+}
+
+bool
+PerfCounters::
+open(unsigned int num_threads)
+{
+    num_threads_ = (num_threads > 0) ? num_threads : 1;
+    fds_.assign(num_threads_ * PerfEvent::num_events, -1);
+
+#ifdef HAVE_OPENMP
+    // the master thread is thread 0 of the team, the worker threads
+    // are kept in the OpenMP runtime's pool for the following regions
+    #pragma omp parallel num_threads(static_cast<int>(num_threads_))
+    {
+        open_thread(static_cast<size_t>(omp_get_thread_num()));
+    }
+#else
+    open_thread(0);
+#endif
+
+    start();
+    return available();
+}
+
+bool
+PerfCounters::
+available() const
+{
+    for (size_t i = 0; i < fds_.size(); ++i)
+    {
+        if (fds_[i] >= 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+PerfCounters::
+start()
+{
+    read_all(start_);
+}
+
+PerfCounts
+PerfCounters::
+stop() const
+{
+    std::vector<Reading> readings;
+    read_all(readings);
+
+    PerfCounts counts;
+    for (size_t i = 0; i < fds_.size(); ++i)
+    {
+        if (fds_[i] < 0)
+        {
+            continue;
+        }
+
+        // skip counters that could not be read
+        if (readings[i].time_enabled < start_[i].time_enabled || readings[i].value < start_[i].value)
+        {
+            continue;
+        }
+
+        const size_t e = i % PerfEvent::num_events;
+        const uint64_t value = readings[i].value - start_[i].value;
+        const uint64_t enabled = readings[i].time_enabled - start_[i].time_enabled;
+        const uint64_t running = readings[i].time_running - start_[i].time_running;
+
+        // extrapolate if the counter was multiplexed with others
+        double scaled = static_cast<double>(value);
+        if (running > 0 && running < enabled)
+        {
+            scaled *= static_cast<double>(enabled) / static_cast<double>(running);
+        }
+
+        counts.values[e] += static_cast<uint64_t>(scaled + 0.5);
+        counts.valid[e] = true;
+    }
+
+    return counts;
+}
+
+void
+PerfCounters::
+open_thread(size_t thread_idx)
+{
+#ifdef __linux__
+    if (thread_idx >= num_threads_)
+    {
+        return;
+    }
+
+    for (size_t e = 0; e < PerfEvent::num_events; ++e)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (static_cast<PerfEvent::type>(e))
+        {
+            case PerfEvent::task_clock:
+                attr.type = PERF_TYPE_SOFTWARE;
+                attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                break;
+            case PerfEvent::cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfEvent::instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfEvent::l1d_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D
+                              | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case PerfEvent::llc_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL
+                              | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case PerfEvent::branch_misses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            default:
+                continue;
+        }
+
+        // pid 0, cpu -1: count the calling thread on any CPU
+        long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        fds_[thread_idx * PerfEvent::num_events + e] = static_cast<int>(fd);
+    }
+#else
+    (void)thread_idx;
+#endif
+}
+
+void
+PerfCounters::
+read_all(std::vector<Reading>& readings) const
+{
+    Reading zero_reading = {0, 0, 0};
+    readings.assign(fds_.size(), zero_reading);
+
+#ifdef __linux__
+    for (size_t i = 0; i < fds_.size(); ++i)
+    {
+        if (fds_[i] >= 0)
+        {
+            if (read(fds_[i], &readings[i], sizeof(Reading)) != static_cast<ssize_t>(sizeof(Reading)))
+            {
+                readings[i] = zero_reading;
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,120 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_PERF_COUNTERS_H__
+#define PHTR_BENCH_PERF_COUNTERS_H__
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Hardware (and software) events counted during benchmark runs.
+ */
+struct PerfEvent
+{
+    enum type
+    {
+        task_clock,
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        num_events
+    };
+};
+
+/**
+ * @brief Event counts of one measured phase (summed over all threads).
+ */
+struct PerfCounts
+{
+    PerfCounts();
+
+    void clear();
+
+    PerfCounts& operator+=(const PerfCounts& other);
+
+    // name used in reports
+    static const char* event_name(PerfEvent::type event);
+
+    // counts (scaled if the kernel had to multiplex the counters)
+    uint64_t values[PerfEvent::num_events];
+
+    // false if the event is not supported (e.g., no PMU access in a virtual machine)
+    bool valid[PerfEvent::num_events];
+};
+
+/**
+ * @brief Access to the Linux perf_event_open() counters.
+ * @details The counters are opened per thread: for the calling thread and
+ * (if built with OpenMP) for every thread of the OpenMP thread pool. This
+ * relies on the OpenMP runtime re-using its worker threads across parallel
+ * regions (as e.g. libgomp does). Counters run freely once opened; a phase
+ * is measured as the difference of two snapshots. Kernel events are excluded.
+ * On other platforms, no event is available.
+ */
+class PerfCounters
+{
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        // open the counters for up to num_threads threads,
+        // returns false if no event is available at all
+        bool open(unsigned int num_threads);
+
+        bool available() const;
+
+        // take a snapshot (start of a phase)
+        void start();
+
+        // counts since the last call to start()
+        PerfCounts stop() const;
+
+    private:
+        PerfCounters(const PerfCounters&);
+        PerfCounters& operator=(const PerfCounters&);
+
+    private:
+        // per-thread counter values (raw value, time enabled, time running)
+        struct Reading
+        {
+            uint64_t value;
+            uint64_t time_enabled;
+            uint64_t time_running;
+        };
+
+    private:
+        void open_thread(size_t thread_idx);
+        void read_all(std::vector<Reading>& readings) const;
+
+    private:
+        size_t num_threads_;
+
+        // file descriptors, indexed [thread * num_events + event] (-1 if not available)
+        std::vector<int> fds_;
+
+        // snapshot taken by start()
+        std::vector<Reading> start_;
+};
+
+#endif // PHTR_BENCH_PERF_COUNTERS_H__
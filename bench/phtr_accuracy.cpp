@@ -0,0 +1,148 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "accuracy_parseconf.h"
+#include "accuracy_report.h"
+#include "accuracy_runner.h"
+#include "chart.h"
+
+#include <photoropter/version.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+const char APP_NAME[] = "phtr-accuracy";
+
+int main(int argc, char* argv[])
+{
+    AccuracySettings settings;
+    std::cerr << "This is " << APP_NAME << std::endl;
+    std::cerr << "Using Photoropter version " << phtr::PHTR_VERSION << std::endl;
+
+    if (!parse_accuracy_command_line(argc, argv, settings))
+    {
+        std::cerr << "Command line error." << std::endl;
+        return 1;
+    }
+
+    if (settings.help)
+    {
+        return 0;
+    }
+
+    std::ofstream outp_file;
+    if (!settings.outp_file.empty())
+    {
+        outp_file.open(settings.outp_file.c_str());
+        if (!outp_file)
+        {
+            std::cerr << "Error: cannot open output file '" << settings.outp_file << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = settings.outp_file.empty() ? std::cout : outp_file;
+
+    // create (or load) the test charts
+    std::vector<ChartImage> charts(settings.charts.size());
+    for (size_t i_ch = 0; i_ch < settings.charts.size(); ++i_ch)
+    {
+        if (settings.charts[i_ch] == TestChart::file)
+        {
+            if (!load_pnm(settings.chart_file, charts[i_ch]))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            make_chart(settings.charts[i_ch], settings.width, settings.height, charts[i_ch]);
+        }
+    }
+
+    if (!settings.json)
+    {
+        write_accuracy_header(os);
+    }
+
+    std::vector<AccuracyResult> results;
+    size_t num_failed(0);
+
+    for (size_t i_st = 0; i_st < settings.storage_types.size(); ++i_st)
+    {
+        for (size_t i_ch = 0; i_ch < settings.charts.size(); ++i_ch)
+        {
+            std::auto_ptr<AccuracyRunnerBase> runner(
+                AccuracyRunnerBase::get_instance(settings.storage_types[i_st], charts[i_ch]));
+
+            // the bounds are given in 8 bit code values
+            const double code_scale = runner->max_code() / 255.0;
+
+            for (size_t i_ip = 0; i_ip < settings.interpolations.size(); ++i_ip)
+            {
+                for (size_t i_mc = 0; i_mc < settings.model_chains.size(); ++i_mc)
+                {
+                    for (size_t i_md = 0; i_md < settings.fast_modes.size(); ++i_md)
+                    {
+                        AccuracyResult result(settings.storage_types[i_st], settings.interpolations[i_ip],
+                                              settings.model_chains[i_mc], settings.charts[i_ch],
+                                              settings.fast_modes[i_md]);
+
+                        runner->compare(result, settings.repeat);
+
+                        result.passed = (result.max_error <= settings.max_error * code_scale)
+                                        && (result.mean_error <= settings.max_mean_error * code_scale)
+                                        && (result.psnr >= settings.min_psnr);
+
+                        if (!result.passed)
+                        {
+                            ++num_failed;
+                        }
+
+                        if (!settings.json)
+                        {
+                            write_accuracy_line(os, result);
+                        }
+                        else if (settings.verbose)
+                        {
+                            write_accuracy_line(std::cerr, result);
+                        }
+
+                        results.push_back(result);
+                    }
+                }
+            }
+        }
+    }
+
+    if (settings.json)
+    {
+        write_accuracy_json(os, settings, results);
+    }
+
+    if (num_failed > 0)
+    {
+        std::cerr << num_failed << " of " << results.size() << " case(s) exceed the error bounds." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+  Usage example :
+  phtr-bench --size 6000x4000 --storage rgb8,rgb16 --interpolation bilin,lanczos3 --threads 1,4 --json
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "parseconf.h"
+#include "bench_runner.h"
+#include "report.h"
+
+#include <photoropter/version.h>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+const char APP_NAME[] = "phtr-bench";
+
+#ifdef HAVE_OPENMP
+const bool have_openmp = true;
+#else
+const bool have_openmp = false;
+#endif
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    std::cerr << "This is " << APP_NAME << std::endl;
+    std::cerr << "Using Photoropter version " << phtr::PHTR_VERSION << std::endl;
+
+    if (!parse_command_line(argc, argv, settings))
+    {
+        std::cerr << "Command line error." << std::endl;
+        return 1;
+    }
+
+    if (settings.help)
+    {
+        return 0;
+    }
+
+    // thread counts: without OpenMP, everything runs in a single thread
+    if (settings.threads.empty())
+    {
+#ifdef HAVE_OPENMP
+        settings.threads.push_back(static_cast<unsigned int>(omp_get_max_threads()));
+#else
+        settings.threads.push_back(1);
+#endif
+    }
+#ifndef HAVE_OPENMP
+    else if (*std::max_element(settings.threads.begin(), settings.threads.end()) > 1)
+    {
+        std::cerr << "Built without OpenMP support, using a single thread." << std::endl;
+        settings.threads.assign(1, 1);
+    }
+#endif
+
+    std::ofstream outp_file;
+    if (!settings.outp_file.empty())
+    {
+        outp_file.open(settings.outp_file.c_str());
+        if (!outp_file)
+        {
+            std::cerr << "Error: cannot open output file '" << settings.outp_file << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = settings.outp_file.empty() ? std::cout : outp_file;
+
+    std::cerr << "Image size: " << settings.width << "x" << settings.height
+              << ", " << settings.repeat << " run(s) per case." << std::endl;
+
+    PerfCounters counters;
+    if (settings.perf_counters)
+    {
+        // open the counters for the largest thread team used
+        unsigned int max_threads = *std::max_element(settings.threads.begin(), settings.threads.end());
+        if (!counters.open(max_threads))
+        {
+            std::cerr << "Warning: no performance counters available"
+                      << " (check /proc/sys/kernel/perf_event_paranoid)." << std::endl;
+        }
+    }
+    PerfCounters* counters_ptr = settings.perf_counters ? &counters : 0;
+
+    if (!settings.json)
+    {
+        write_text_header(os, settings);
+    }
+
+    std::vector<BenchResult> results;
+
+    for (size_t i_st = 0; i_st < settings.storage_types.size(); ++i_st)
+    {
+        std::auto_ptr<BenchRunnerBase> runner(
+            BenchRunnerBase::get_instance(settings.storage_types[i_st], settings.width, settings.height));
+
+        for (size_t i_ip = 0; i_ip < settings.interpolations.size(); ++i_ip)
+        {
+            for (size_t i_ch = 0; i_ch < settings.model_chains.size(); ++i_ch)
+            {
+                for (size_t i_os = 0; i_os < settings.oversampling.size(); ++i_os)
+                {
+                    for (size_t i_th = 0; i_th < settings.threads.size(); ++i_th)
+                    {
+                        BenchResult result(settings.storage_types[i_st], settings.interpolations[i_ip],
+                                           settings.model_chains[i_ch], settings.oversampling[i_os],
+                                           settings.threads[i_th]);
+
+#ifdef HAVE_OPENMP
+                        omp_set_num_threads(static_cast<int>(result.threads));
+#endif
+
+                        // warm-up run (page faults, thread pool start-up), not timed
+                        runner->run(result.interp, result.chain, result.oversampling, 0);
+
+                        double sum(0.0);
+                        for (unsigned int i = 0; i < settings.repeat; ++i)
+                        {
+                            BenchTiming timing = runner->run(result.interp, result.chain, result.oversampling,
+                                                             counters_ptr);
+                            sum += timing.transform;
+
+                            if (i == 0 || timing.transform < result.transform_min)
+                            {
+                                result.transform_min = timing.transform;
+                                result.stats = timing.stats;
+                                result.setup_counts = timing.setup_counts;
+                                result.transform_counts = timing.transform_counts;
+                            }
+                            if (i == 0 || timing.setup < result.setup_min)
+                            {
+                                result.setup_min = timing.setup;
+                            }
+                        }
+                        result.transform_mean = sum / static_cast<double>(settings.repeat);
+
+                        if (!settings.json)
+                        {
+                            write_text_line(os, settings, result);
+                        }
+                        else if (settings.verbose)
+                        {
+                            write_text_line(std::cerr, settings, result);
+                        }
+
+                        results.push_back(result);
+                    }
+                }
+            }
+        }
+    }
+
+    if (settings.json)
+    {
+        write_json(os, settings, have_openmp, results);
+    }
+
+    return 0;
+}
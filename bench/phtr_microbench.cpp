@@ -0,0 +1,238 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <boost/program_options.hpp>
+#include <boost/tokenizer.hpp>
+namespace po = boost::program_options;
+
+#include <photoropter/version.h>
+
+#include "parseconf.h"
+#include "microbench.h"
+
+const char APP_NAME[] = "phtr-microbench";
+
+namespace
+{
+
+    bool parse_micro_command_line(int argc, char* argv[], MicroSettings& settings)
+    {
+
+        try
+        {
+
+            po::options_description opt_desc("Allowed options");
+            opt_desc.add_options()
+            ("help,h", "show options")
+            ("verbose,v", "be verbose")
+            ("size,s", po::value<std::string>(), "Size of the coordinate batch: WxH (default: 1500x1000)")
+            ("repeat,n", po::value<unsigned>(), "Number of timed runs per component (default: 5)")
+            ("filter,f", po::value<std::string>(), "Comma-separated list of name fragments; only"
+             " components whose name contains one of them are timed (e.g. 'geom::,Gamma')")
+            ("json", "Write results as JSON")
+            ("output-file,o", po::value<std::string>(), "Output file (default: standard output)");
+
+            po::variables_map options_map;
+            po::store(po::parse_command_line(argc, argv, opt_desc), options_map);
+            po::notify(options_map);
+
+            if (options_map.count("help"))
+            {
+                std::cout << opt_desc << std::endl;
+                settings.help = true;
+                return true;
+            }
+
+            if (options_map.count("verbose"))
+            {
+                settings.verbose = true;
+            }
+
+            if (options_map.count("size"))
+            {
+                if (!parse_image_size(options_map["size"].as<std::string>(), settings.width, settings.height))
+                {
+                    return false;
+                }
+            }
+
+            if (options_map.count("repeat"))
+            {
+                settings.repeat = options_map["repeat"].as<unsigned>();
+                if (settings.repeat < 1)
+                {
+                    std::cerr << "Error: repeat count has to be at least 1" << std::endl;
+                    return false;
+                }
+            }
+
+            if (options_map.count("filter"))
+            {
+                typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+                typedef boost::char_separator<char> separator_t;
+
+                separator_t sep(",;");
+                std::string param_string = options_map["filter"].as<std::string>();
+                tokenizer_t tokens(param_string, sep);
+
+                for (tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+                {
+                    settings.filters.push_back(*it);
+                }
+            }
+
+            if (options_map.count("json"))
+            {
+                settings.json = true;
+            }
+
+            if (options_map.count("output-file"))
+            {
+                settings.outp_file = options_map["output-file"].as<std::string>();
+            }
+
+        }
+        catch (po::unknown_option& e)
+        {
+            std::cerr << e.what() << std::endl;
+            std::cerr << "Try option '--help'" << std::endl;
+            return false;
+        }
+        catch (po::error& e)
+        {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void write_micro_text(std::ostream& os, const std::vector<MicroResult>& results)
+    {
+        os << std::left
+           << std::setw(52) << "component"
+           << std::right
+           << std::setw(10) << "ns/px"
+           << std::setw(10) << "Mpx/s"
+           << std::endl;
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const MicroResult& result = results[i];
+
+            os << std::left
+               << std::setw(52) << result.name
+               << std::right
+               << std::fixed << std::setprecision(2)
+               << std::setw(10) << result.ns_per_px
+               << std::setw(10) << ((result.ns_per_px > 0.0) ? 1e3 / result.ns_per_px : 0.0)
+               << std::endl;
+        }
+    }
+
+    void write_micro_json(std::ostream& os, const MicroSettings& settings,
+                          const std::vector<MicroResult>& results)
+    {
+        os << std::setprecision(6);
+
+        os << "{" << std::endl;
+        os << "  \"photoropter_version\": \"" << phtr::PHTR_VERSION << "\"," << std::endl;
+        os << "  \"width\": " << settings.width << "," << std::endl;
+        os << "  \"height\": " << settings.height << "," << std::endl;
+        os << "  \"repeat\": " << settings.repeat << "," << std::endl;
+        os << "  \"results\": [" << std::endl;
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const MicroResult& result = results[i];
+
+            os << "    {"
+               << "\"component\": \"" << result.name << "\", "
+               << "\"ns_per_px\": " << result.ns_per_px << ", "
+               << "\"checksum\": " << result.checksum
+               << "}";
+
+            if (i + 1 < results.size())
+            {
+                os << ",";
+            }
+            os << std::endl;
+        }
+
+        os << "  ]" << std::endl;
+        os << "}" << std::endl;
+    }
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    MicroSettings settings;
+    std::cerr << "This is " << APP_NAME << std::endl;
+    std::cerr << "Using Photoropter version " << phtr::PHTR_VERSION << std::endl;
+
+    if (!parse_micro_command_line(argc, argv, settings))
+    {
+        std::cerr << "Command line error." << std::endl;
+        return 1;
+    }
+
+    if (settings.help)
+    {
+        return 0;
+    }
+
+    std::ofstream outp_file;
+    if (!settings.outp_file.empty())
+    {
+        outp_file.open(settings.outp_file.c_str());
+        if (!outp_file)
+        {
+            std::cerr << "Error: cannot open output file '" << settings.outp_file << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = settings.outp_file.empty() ? std::cout : outp_file;
+
+    std::vector<MicroResult> results;
+    run_micro_benchmarks(settings, results);
+
+    if (results.empty())
+    {
+        std::cerr << "Error: no component matches the filter" << std::endl;
+        return 1;
+    }
+
+    if (settings.json)
+    {
+        write_micro_json(os, settings, results);
+    }
+    else
+    {
+        write_micro_text(os, results);
+    }
+
+    return 0;
+}
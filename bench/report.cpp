@@ -0,0 +1,213 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <iomanip>
+#include <sstream>
+
+#include <photoropter/version.h>
+
+#include "parseconf.h"
+#include "report.h"
+
+double megapixels_per_second(const Settings& settings, const BenchResult& result)
+{
+    if (result.transform_min <= 0.0)
+    {
+        return 0.0;
+    }
+
+    double num_pixels = static_cast<double>(settings.width) * static_cast<double>(settings.height);
+    return num_pixels / result.transform_min * 1e-6;
+}
+
+namespace
+{
+
+    // write num / denom, or '-' if the value is not available
+    void write_ratio(std::ostream& os, int width, int precision, bool valid, double num, double denom)
+    {
+        if (valid && denom > 0.0)
+        {
+            os << std::setw(width) << std::setprecision(precision) << num / denom;
+        }
+        else
+        {
+            os << std::setw(width) << "-";
+        }
+    }
+
+    void write_json_counts(std::ostream& os, const PerfCounts& counts)
+    {
+        os << "{";
+        for (size_t e = 0; e < PerfEvent::num_events; ++e)
+        {
+            os << (e ? ", " : "") << "\"" << PerfCounts::event_name(static_cast<PerfEvent::type>(e)) << "\": ";
+            if (counts.valid[e])
+            {
+                os << counts.values[e];
+            }
+            else
+            {
+                os << "null";
+            }
+        }
+        os << "}";
+    }
+
+}
+
+void write_text_header(std::ostream& os, const Settings& settings)
+{
+    os << std::left
+       << std::setw(9) << "storage"
+       << std::setw(10) << "interp"
+       << std::setw(8) << "models"
+       << std::right
+       << std::setw(5) << "os"
+       << std::setw(8) << "threads"
+       << std::setw(11) << "setup[ms]"
+       << std::setw(10) << "best[ms]"
+       << std::setw(10) << "mean[ms]"
+       << std::setw(9) << "MP/s";
+
+    // transformation only: instructions per cycle and events per output pixel
+    if (settings.perf_counters)
+    {
+        os << std::setw(7) << "IPC"
+           << std::setw(9) << "L1m/px"
+           << std::setw(9) << "LLCm/px"
+           << std::setw(9) << "brm/px";
+    }
+
+    os << std::endl;
+}
+
+void write_text_line(std::ostream& os, const Settings& settings, const BenchResult& result)
+{
+    std::ostringstream interp_str;
+    interp_str << interpolation_name(result.interp.type);
+    if (result.interp.type == phtr::Interpolation::lanczos)
+    {
+        interp_str << result.interp.support;
+    }
+
+    os << std::left
+       << std::setw(9) << storage_name(result.storage_type)
+       << std::setw(10) << interp_str.str()
+       << std::setw(8) << model_chain_name(result.chain)
+       << std::right
+       << std::setw(5) << result.oversampling
+       << std::setw(8) << result.threads
+       << std::fixed << std::setprecision(2)
+       << std::setw(11) << result.setup_min * 1e3
+       << std::setw(10) << result.transform_min * 1e3
+       << std::setw(10) << result.transform_mean * 1e3
+       << std::setw(9) << megapixels_per_second(settings, result);
+
+    if (settings.perf_counters)
+    {
+        const PerfCounts& counts = result.transform_counts;
+        const double num_pixels = static_cast<double>(settings.width) * static_cast<double>(settings.height);
+
+        write_ratio(os, 7, 2, counts.valid[PerfEvent::instructions] && counts.valid[PerfEvent::cycles],
+                    static_cast<double>(counts.values[PerfEvent::instructions]),
+                    static_cast<double>(counts.values[PerfEvent::cycles]));
+        write_ratio(os, 9, 3, counts.valid[PerfEvent::l1d_misses],
+                    static_cast<double>(counts.values[PerfEvent::l1d_misses]), num_pixels);
+        write_ratio(os, 9, 3, counts.valid[PerfEvent::llc_misses],
+                    static_cast<double>(counts.values[PerfEvent::llc_misses]), num_pixels);
+        write_ratio(os, 9, 3, counts.valid[PerfEvent::branch_misses],
+                    static_cast<double>(counts.values[PerfEvent::branch_misses]), num_pixels);
+    }
+
+    os << std::endl;
+}
+
+void write_json(std::ostream& os, const Settings& settings, bool have_openmp,
+                const std::vector<BenchResult>& results)
+{
+    os << std::setprecision(6);
+
+    os << "{" << std::endl;
+    os << "  \"photoropter_version\": \"" << phtr::PHTR_VERSION << "\"," << std::endl;
+    os << "  \"openmp\": " << (have_openmp ? "true" : "false") << "," << std::endl;
+    os << "  \"width\": " << settings.width << "," << std::endl;
+    os << "  \"height\": " << settings.height << "," << std::endl;
+    os << "  \"repeat\": " << settings.repeat << "," << std::endl;
+    os << "  \"results\": [" << std::endl;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& result = results[i];
+
+        os << "    {"
+           << "\"storage\": \"" << storage_name(result.storage_type) << "\", "
+           << "\"interpolation\": \"" << interpolation_name(result.interp.type) << "\", "
+           << "\"support\": " << result.interp.support << ", "
+           << "\"models\": \"" << model_chain_name(result.chain) << "\", "
+           << "\"oversampling\": " << result.oversampling << ", "
+           << "\"threads\": " << result.threads << ", "
+           << "\"setup_s\": " << result.setup_min << ", "
+           << "\"transform_min_s\": " << result.transform_min << ", "
+           << "\"transform_mean_s\": " << result.transform_mean << ", "
+           << "\"mpix_per_s\": " << megapixels_per_second(settings, result);
+
+        // per-stage statistics (PHTR_INSTRUMENT builds only)
+        if (result.stats.enabled)
+        {
+            typedef phtr::TransformStats::Stage stage_t;
+
+            os << ", \"samples\": " << result.stats.samples
+               << ", \"out_of_bounds\": " << result.stats.out_of_bounds
+               << ", \"stages_s\": {";
+
+            for (size_t s = 0; s < stage_t::num_stages; ++s)
+            {
+                stage_t::type stage = static_cast<stage_t::type>(s);
+                os << (s ? ", " : "") << "\"" << phtr::TransformStats::stage_name(stage) << "\": "
+                   << result.stats.stage_time(stage);
+            }
+
+            os << "}";
+        }
+
+        // performance counters (if requested)
+        if (settings.perf_counters)
+        {
+            os << ", \"perf\": {\"setup\": ";
+            write_json_counts(os, result.setup_counts);
+            os << ", \"transform\": ";
+            write_json_counts(os, result.transform_counts);
+            os << "}";
+        }
+
+        os << "}";
+
+        if (i + 1 < results.size())
+        {
+            os << ",";
+        }
+        os << std::endl;
+    }
+
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
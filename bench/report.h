@@ -0,0 +1,80 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_REPORT_H__
+#define PHTR_BENCH_REPORT_H__
+
+#include <ostream>
+#include <vector>
+
+#include <photoropter/transform_stats.h>
+
+#include "settings.h"
+#include "perf_counters.h"
+
+/**
+ * @brief Result of one benchmark case (i.e., one point of the parameter sweep).
+ */
+struct BenchResult
+{
+    BenchResult(phtr::mem::Storage::type storage_type_, const InterpSpec& interp_,
+                ModelChain::type chain_, unsigned int oversampling_, unsigned int threads_)
+            : storage_type(storage_type_),
+            interp(interp_),
+            chain(chain_),
+            oversampling(oversampling_),
+            threads(threads_),
+            setup_min(0.0),
+            transform_min(0.0),
+            transform_mean(0.0)
+    {
+        //NIL
+    }
+
+    phtr::mem::Storage::type storage_type;
+    InterpSpec interp;
+    ModelChain::type chain;
+    unsigned int oversampling;
+    unsigned int threads;
+
+    // timings in seconds
+    double setup_min;
+    double transform_min;
+    double transform_mean;
+
+    // per-stage statistics of the fastest run
+    phtr::TransformStats stats;
+
+    // performance counters of the fastest run
+    PerfCounts setup_counts;
+    PerfCounts transform_counts;
+};
+
+// throughput in megapixels (output pixels) per second, based on the fastest run
+double megapixels_per_second(const Settings& settings, const BenchResult& result);
+
+void write_text_header(std::ostream& os, const Settings& settings);
+void write_text_line(std::ostream& os, const Settings& settings, const BenchResult& result);
+
+void write_json(std::ostream& os, const Settings& settings, bool have_openmp,
+                const std::vector<BenchResult>& results);
+
+#endif // PHTR_BENCH_REPORT_H__
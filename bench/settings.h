@@ -0,0 +1,101 @@
+/*
+
+  phtr-bench: Photoropter benchmark suite
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTR_BENCH_SETTINGS_H__
+#define PHTR_BENCH_SETTINGS_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <photoropter/interpolation_type.h>
+#include <photoropter/mem/storage_type.h>
+
+struct ModelChain
+{
+    enum type
+    {
+        none,
+        ptlens,
+        tca,
+        vignetting,
+        geometry,
+        all
+    };
+};
+
+struct InterpSpec
+{
+    InterpSpec(phtr::Interpolation::type type_, unsigned int support_)
+            : type(type_),
+            support(support_)
+    {
+        //NIL
+    }
+
+    phtr::Interpolation::type type;
+
+    // kernel support (only used for Lanczos interpolation)
+    unsigned int support;
+};
+
+struct Settings
+{
+    Settings()
+            : help(false),
+            verbose(false),
+            width(3000),
+            height(2000),
+            repeat(3),
+            perf_counters(false),
+            json(false)
+    {
+        //NIL
+    }
+
+    // only the option list was requested
+    bool help;
+
+    bool verbose;
+
+    // size of the synthetic test image
+    size_t width;
+    size_t height;
+
+    // number of timed runs per case (the fastest one is reported)
+    unsigned int repeat;
+
+    // sweep parameters
+    std::vector<phtr::mem::Storage::type> storage_types;
+    std::vector<InterpSpec> interpolations;
+    std::vector<ModelChain::type> model_chains;
+    std::vector<unsigned int> oversampling;
+    std::vector<unsigned int> threads;
+
+    // read hardware performance counters (Linux only)
+    bool perf_counters;
+
+    // output
+    bool json;
+    std::string outp_file;
+};
+
+#endif // PHTR_BENCH_SETTINGS_H__
@@ -29,6 +29,9 @@ THE SOFTWARE.
 
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <vector>
+#include <cassert>
 
 #include <photoropter/pixel_correction_queue.h>
 #include <photoropter/subpixel_correction_queue.h>
@@ -103,15 +106,51 @@ namespace phtr
              * internals
              * **************************************** */
 
+        private:
+            /**
+            * @brief Container type for the cached border sample coordinates.
+            */
+            typedef std::vector<interp_coord_t> coord_vec_t;
+
+        private:
+            /**
+            * @brief Sample the border of the destination image.
+            * @details The border points are distributed according to the image aspect ratio,
+            * with @c precision points along the longer side. The coordinates are determined
+            * once per search and then re-used for every iteration.
+            * @param[in]  precision The desired reciprocal precision (usually the number of pixels).
+            * @param[out] dst_x     Horizontal coordinates of the border points.
+            * @param[out] dst_y     Vertical coordinates of the border points.
+            */
+            void sample_border(size_t precision, coord_vec_t& dst_x, coord_vec_t& dst_y) const;
+
+        private:
+            /**
+            * @brief Perform fixed-point iteration.
+            * @details The start value is the closed-form solution for a purely linear
+            * (i.e., scaling) geometry transformation, which is refined by iterating
+            * @f$ s_{n+1} = s_n \cdot f(s_n) @f$, with @f$ f @f$ being the result of find_scale_step().
+            * @param[in]  precision The precision to be achieved (reciprocal value).
+            * @param[in]  dst_x     Horizontal coordinates of the border points.
+            * @param[in]  dst_y     Vertical coordinates of the border points.
+            * @param[out] scale     The scale (last iterate if not converged).
+            * @return 'true' if the iteration converged, 'false' otherwise.
+            */
+            bool iterate(size_t precision, const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+                         double& scale) const;
+
         private:
             /**
             * @brief Perform bisection search.
+            * @details This is the fallback if the fixed-point iteration does not converge.
             * @param[in] precision The precision to be achieved (reciprocal value).
-            * @param[in] step      The (remaining) search depth.
+            * @param[in] dst_x     Horizontal coordinates of the border points.
+            * @param[in] dst_y     Vertical coordinates of the border points.
             * @param[in,out] val1  The left bracketing value.
             * @param[in,out] val2  The right bracketing value.
             */
-            bool bisect(size_t precision, size_t step, double& val1, double& val2) const;
+            bool bisect(size_t precision, const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+                        double& val1, double& val2) const;
 
         private:
             /**
@@ -119,44 +158,27 @@ namespace phtr
             * @details In this first search, the given start value is examined whether the
             * corresponding scaling factor is >1.0 or <1.0; depending on the result, a
             * quick search for a fitting second value is performed.
-            * @param[in] precision The precision to be achieved (reciprocal value).
+            * @param[in] dst_x Horizontal coordinates of the border points.
+            * @param[in] dst_y Vertical coordinates of the border points.
             * @param[in,out] val1 The left bracketing value. Input is a arbitrary start value,
             * output the found left bracketing value (if any)
             * @param[out] val2 The right bracketing value.
             */
-            bool find_start_pair(size_t precision, double& val1, double& val2) const;
+            bool find_start_pair(const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+                                 double& val1, double& val2) const;
 
         private:
             /**
             * @brief Perform iteration step.
-            * @param[in] precision The desired reciprocal precision (usually the number of pixels).
+            * @details All border points are evaluated (in parallel if OpenMP is available)
+            * and the minimal ratio of destination to source radius is returned.
+            * @param[in] dst_x     Horizontal coordinates of the border points.
+            * @param[in] dst_y     Vertical coordinates of the border points.
             * @param[in] pre_scale Scaling factor from previous iterations.
+            * @return The scaling factor.
             */
-            double find_scale_step(size_t precision, double pre_scale) const;
-
-        private:
-            /**
-            * @brief Perform horizontal search.
-            * @details The top and bottom borders of the destination image are
-            * 'scanned' fo the minimal scaling factor.
-            * @param[in] aspect_ratio The image aspect ratio.
-            * @param[in] px_width The image's pixel width to be assumed.
-            * @param[in] pre_scale Scaling factor from previous iterations.
-            * @return The factor (squared).
-            */
-            double search_horizontal(double aspect_ratio, size_t px_width, double pre_scale) const;
-
-        private:
-            /**
-            * @brief Perform vertical search.
-            * @details The left and right borders of the destination image are
-            * 'scanned' fo the minimal scaling factor.
-            * @param[in] aspect_ratio The image aspect ratio.
-            * @param[in] px_height The image's pixel width to be assumed.
-            * @param[in] pre_scale Scaling factor from previous iterations.
-            * @return The factor (squared).
-            */
-            double search_vertical(double aspect_ratio, size_t px_height, double pre_scale) const;
+            double find_scale_step(const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+                                   double pre_scale) const;
 
         private:
             /**
@@ -186,6 +208,12 @@ namespace phtr
             */
             const IImageTransform& image_transform_;
 
+        private:
+            /**
+            * @brief The aspect ratio of the image.
+            */
+            double aspect_ratio_;
+
         private:
             /**
             * @brief The internal queue of geometrical correction models to be applied.
@@ -30,10 +30,16 @@ namespace phtr
     template <typename coord_tuple_T>
     AutoScaler<coord_tuple_T>::
     AutoScaler(const IImageTransform& image_transform)
-            : image_transform_(image_transform)
+            : image_transform_(image_transform),
+            aspect_ratio_(image_transform.aspect_ratio())
     {
         pixel_queue_ = image_transform_.pixel_queue();
         subpixel_queue_ = image_transform_.subpixel_queue();
+
+        /* note: only a few points are evaluated here, so any radial lookup tables
+         copied from the transform (which might be outdated) are not used. */
+        pixel_queue_.enable_radial_collapse(false);
+        subpixel_queue_.enable_radial_collapse(false);
     }
 
     template <typename coord_tuple_T>
@@ -41,18 +47,34 @@ namespace phtr
     AutoScaler<coord_tuple_T>::
     find_scale(size_t precision, double& scale) const
     {
+        coord_vec_t dst_x;
+        coord_vec_t dst_y;
+        sample_border(precision, dst_x, dst_y);
+
         double v1(1.0);
-        double v2(1.0);
-        bool found_pair = find_start_pair(precision, v1, v2);
+        if (iterate(precision, dst_x, dst_y, v1))
+        {
+            scale = v1;
+            return true;
+        }
+
+        // fixed-point iteration failed, fall back to bisection
+        // (starting from the last iterate if it is usable)
+        if (!(v1 > 0.0) || !(v1 < std::numeric_limits<double>::max()))
+        {
+            v1 = 1.0;
+        }
+
+        double v2(v1);
+        bool found_pair = find_start_pair(dst_x, dst_y, v1, v2);
 
         if (!found_pair)
         {
             return false;
         }
 
-        if (bisect(precision, precision, v1, v2))
+        if (bisect(precision, dst_x, dst_y, v1, v2))
         {
-            //std::cerr << "bisect successful: " << v1 << " " << v2 << std::endl;
             scale = (v1 + v2) / 2.0;
             return true;
         }
@@ -64,30 +86,90 @@ namespace phtr
     }
 
     template <typename coord_tuple_T>
-    bool
+    void
     AutoScaler<coord_tuple_T>::
-    bisect(size_t precision, size_t step, double& val1, double& val2) const
+    sample_border(size_t precision, coord_vec_t& dst_x, coord_vec_t& dst_y) const
     {
-        if (!step)
+        const double long_side = std::max(aspect_ratio_, 1.0);
+
+        // number of points along the horizontal and vertical borders
+        size_t num_x = static_cast<size_t>(std::ceil(static_cast<double>(precision) * aspect_ratio_ / long_side));
+        size_t num_y = static_cast<size_t>(std::ceil(static_cast<double>(precision) / long_side));
+        num_x = std::max(num_x, static_cast<size_t>(2));
+        num_y = std::max(num_y, static_cast<size_t>(2));
+
+        dst_x.clear();
+        dst_y.clear();
+        dst_x.reserve(2 * (num_x + num_y));
+        dst_y.reserve(2 * (num_x + num_y));
+
+        // top and bottom borders
+        interp_coord_t scale_x = 2.0 * aspect_ratio_ / static_cast<interp_coord_t>(num_x - 1);
+        for (size_t i = 0; i < num_x; ++i)
         {
-            // search depth exhausted, fail
-            return false;
+            interp_coord_t cur_dst_x = static_cast<interp_coord_t>(i) * scale_x - aspect_ratio_;
+
+            dst_x.push_back(cur_dst_x);
+            dst_y.push_back(-1.0);
+            dst_x.push_back(cur_dst_x);
+            dst_y.push_back(1.0);
         }
 
-        double mid_val = (val1 + val2) / 2.0;
-        double diff = std::fabs(val1 - val2);
-        if (static_cast<double>(precision * 10) * diff < std::fabs(mid_val))
+        // left and right borders
+        interp_coord_t scale_y = 2.0 / static_cast<interp_coord_t>(num_y - 1);
+        for (size_t i = 0; i < num_y; ++i)
         {
-            // desired precision achieved, succeed
-            return true;
+            interp_coord_t cur_dst_y = static_cast<interp_coord_t>(i) * scale_y - 1.0;
+
+            dst_x.push_back(-aspect_ratio_);
+            dst_y.push_back(cur_dst_y);
+            dst_x.push_back(aspect_ratio_);
+            dst_y.push_back(cur_dst_y);
+        }
+    }
+
+    template <typename coord_tuple_T>
+    bool
+    AutoScaler<coord_tuple_T>::
+    iterate(size_t precision, const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+            double& scale) const
+    {
+        const size_t max_step(20);
+        const double tolerance = 1.0 / static_cast<double>(precision * 10);
+
+        // closed-form start value: the scale for which the farthest-out border point
+        // would end up exactly on the border if the transformation were linear
+        scale = find_scale_step(dst_x, dst_y, 1.0);
+
+        for (size_t step = 0; step < max_step; ++step)
+        {
+            if (!(scale > 0.0) || !(scale < std::numeric_limits<double>::max()))
+            {
+                // diverged
+                return false;
+            }
+
+            double new_scale = scale * find_scale_step(dst_x, dst_y, scale);
+            double diff = std::fabs(new_scale - scale);
+            scale = new_scale;
+
+            if (diff < tolerance * std::fabs(scale))
+            {
+                return true;
+            }
         }
 
-        double scale_step1 = find_scale_step(precision, val1) - 1.0;
-        double scale_step2 = find_scale_step(precision, val2) - 1.0;
-        double mid_scale_step = find_scale_step(precision, mid_val) - 1.0;
-        //std::cerr << step << " " << val1 << " " << scale_step1 + 1.0 << "  " <<
-        //    mid_val << " " << mid_scale_step + 1.0 << "  " <<
-        //    val2 << " " << scale_step2 + 1.0 << std::endl;
+        return false;
+    }
+
+    template <typename coord_tuple_T>
+    bool
+    AutoScaler<coord_tuple_T>::
+    bisect(size_t precision, const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+           double& val1, double& val2) const
+    {
+        double scale_step1 = find_scale_step(dst_x, dst_y, val1) - 1.0;
+        double scale_step2 = find_scale_step(dst_x, dst_y, val2) - 1.0;
 
         if (!(scale_step1 * scale_step2 < 0))
         {
@@ -95,27 +177,42 @@ namespace phtr
             return false;
         }
 
-        if (scale_step1 * mid_scale_step < 0)
-        {
-            val2 = mid_val;
-        }
-        else
+        // search depth; each step halves the interval
+        for (size_t step = precision; step > 0; --step)
         {
-            val1 = mid_val;
+            double mid_val = (val1 + val2) / 2.0;
+            double diff = std::fabs(val1 - val2);
+            if (static_cast<double>(precision * 10) * diff < std::fabs(mid_val))
+            {
+                // desired precision achieved, succeed
+                return true;
+            }
+
+            double mid_scale_step = find_scale_step(dst_x, dst_y, mid_val) - 1.0;
+
+            if (scale_step1 * mid_scale_step < 0)
+            {
+                val2 = mid_val;
+            }
+            else
+            {
+                val1 = mid_val;
+                scale_step1 = mid_scale_step;
+            }
         }
 
-        // recursion: step one level down
-        --step;
-        return bisect(precision, step, val1, val2);
+        // search depth exhausted, fail
+        return false;
     }
 
     template <typename coord_tuple_T>
     bool
     AutoScaler<coord_tuple_T>::
-    find_start_pair(size_t precision, double& val1, double& val2) const
+    find_start_pair(const coord_vec_t& dst_x, const coord_vec_t& dst_y,
+                    double& val1, double& val2) const
     {
         double mult(2.0);
-        double scale_step = find_scale_step(precision, val1);
+        double scale_step = find_scale_step(dst_x, dst_y, val1);
 
         val2 = val1;
 
@@ -128,7 +225,7 @@ namespace phtr
             {
                 ++step;
                 val1 /= mult;
-                scale_step = find_scale_step(precision, val1);
+                scale_step = find_scale_step(dst_x, dst_y, val1);
 
                 if (scale_step >= 1.0)
                 {
@@ -142,7 +239,7 @@ namespace phtr
             {
                 ++step;
                 val2 *= mult;
-                scale_step = find_scale_step(precision, val2);
+                scale_step = find_scale_step(dst_x, dst_y, val2);
 
                 if (scale_step < 1.0)
                 {
@@ -157,94 +254,27 @@ namespace phtr
     template <typename coord_tuple_T>
     double
     AutoScaler<coord_tuple_T>::
-    find_scale_step(size_t precision, double pre_scale) const
+    find_scale_step(const coord_vec_t& dst_x, const coord_vec_t& dst_y, double pre_scale) const
     {
+        assert(dst_x.size() == dst_y.size());
+        assert(!dst_x.empty());
 
-        size_t px_width = precision;
-        size_t px_height = precision;
-        double aspect_ratio = 1.5;
-
-        double fact_y = search_horizontal(aspect_ratio, px_width, pre_scale);
-        double fact_x = search_vertical(aspect_ratio, px_height, pre_scale);
-
-        double factor = std::min(fact_x, fact_y);
-
-        return std::sqrt(factor);
-
-    }
+        const omp_coord_t num_points = static_cast<omp_coord_t>(dst_x.size());
+        std::vector<double> factors(dst_x.size());
 
-    template <typename coord_tuple_T>
-    double
-    AutoScaler<coord_tuple_T>::
-    search_horizontal(double aspect_ratio, size_t px_width, double pre_scale) const
-    {
-        interp_coord_t dst_top = -1.0;
-        interp_coord_t dst_bottom = 1.0;
-
-        interp_coord_t scale_x = 2.0 * aspect_ratio / static_cast<interp_coord_t>(px_width - 1);
-
-        double factor_tmp(1.0);
-        double factor(1.0);
-        bool first(true);
-
-        for (size_t i = 0; i < px_width; ++i)
+        omp_coord_t i(0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for if (num_points > 1024)
+#endif
+        for (i = 0; i < num_points; ++i)
         {
-            // current pixel position
-            interp_coord_t cur_pixel_x(static_cast<interp_coord_t>(i));
-            interp_coord_t cur_dst_x = cur_pixel_x * scale_x - aspect_ratio;
-
-            factor_tmp = std::min(get_factor(cur_dst_x, dst_top, pre_scale),
-                                  get_factor(cur_dst_x, dst_bottom, pre_scale));
-            if (first)
-            {
-                first = false;
-                factor = factor_tmp;
-            }
-            else if (factor_tmp < factor)
-            {
-                factor = factor_tmp;
-            }
-
+            factors[i] = get_factor(dst_x[i], dst_y[i], pre_scale);
         }
 
-        return factor;
-    }
-
-    template <typename coord_tuple_T>
-    double
-    AutoScaler<coord_tuple_T>::
-    search_vertical(double aspect_ratio, size_t px_height, double pre_scale) const
-    {
-        interp_coord_t dst_left = -aspect_ratio;
-        interp_coord_t dst_right = aspect_ratio;
-
-        interp_coord_t scale_y = 2.0 / static_cast<interp_coord_t>(px_height - 1);
-
-        double factor_tmp(1.0);
-        double factor(1.0);
-        bool first(true);
-
-        for (size_t i = 0; i < px_height; ++i)
-        {
-            // current pixel position
-            interp_coord_t cur_pixel_y(static_cast<interp_coord_t>(i));
-            interp_coord_t cur_dst_y = cur_pixel_y * scale_y - 1.0;
+        double factor = *std::min_element(factors.begin(), factors.end());
 
-            factor_tmp = std::min(get_factor(dst_left, cur_dst_y, pre_scale),
-                                  get_factor(dst_right, cur_dst_y, pre_scale));
-            if (first)
-            {
-                first = false;
-                factor = factor_tmp;
-            }
-            else if (factor_tmp < factor)
-            {
-                factor = factor_tmp;
-            }
-
-        }
+        return std::sqrt(factor);
 
-        return factor;
     }
 
     template <typename coord_tuple_T>
@@ -86,6 +86,23 @@ namespace phtr
             inline void get_correction_factors(const coord_tuple_T& coords,
                                                typename coord_tuple_T::channel_order_t::colour_tuple_t& factors) const;
 
+        public:
+            /**
+            * @brief Get the correction factors for a row of positions.
+            * @details The positions are @f$ (x + k\,dx, y) @f$ for @f$ k = 0 \ldots num-1 @f$,
+            * with all channels sharing the same coordinates (i.e., without geometric correction).
+            * This uses model::IColourCorrectionModel::mult_correction_factors_row(), so the
+            * models can update their state incrementally along the row.
+            * @param[in] x The horizontal position of the first pixel.
+            * @param[in] dx The horizontal step.
+            * @param[in] y The vertical position.
+            * @param[in] num The number of positions.
+            * @param[out] factors Array of @c num factor tuples.
+            */
+            template <typename colour_tuple_T>
+            inline void get_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                                   size_t num, colour_tuple_T* factors) const;
+
         public:
             /**
             * @brief Add the given model to the queue.
@@ -95,9 +112,47 @@ namespace phtr
             */
             model::IColourCorrectionModel& add_model(const model::IColourCorrectionModel& model);
 
+        public:
+            /**
+            * @brief Set the exposure correction.
+            * @details The linear channel values are multiplied by @f$ 2^{ev} @f$ (the alpha
+            * channel is not affected). The gain is folded into the correction factors, so it
+            * does not cost anything extra per pixel. The default is 0.
+            * @param[in] ev The exposure correction in stops (EV).
+            */
+            void set_exposure(double ev);
+
+        public:
+            /**
+            * @brief Get the exposure correction.
+            * @return The exposure correction in stops (EV).
+            */
+            double exposure() const;
+
+        public:
+            /**
+            * @brief Set the white balance gains.
+            * @details The linear channel values are multiplied by the given gains (in
+            * addition to the exposure correction). The default is 1.0 for all channels.
+            * @param[in] gain_r The gain of the 'red' channel.
+            * @param[in] gain_g The gain of the 'green' channel.
+            * @param[in] gain_b The gain of the 'blue' channel.
+            */
+            void set_white_balance(double gain_r, double gain_g, double gain_b);
+
+        public:
+            /**
+            * @brief Get the white balance gains.
+            * @param[out] gain_r The gain of the 'red' channel.
+            * @param[out] gain_g The gain of the 'green' channel.
+            * @param[out] gain_b The gain of the 'blue' channel.
+            */
+            void get_white_balance(double& gain_r, double& gain_g, double& gain_b) const;
+
         public:
             /**
             * @brief Clear the current queue contents.
+            * @note The exposure and white balance settings are not affected.
             */
             void clear();
 
@@ -117,6 +172,30 @@ namespace phtr
             */
             unsigned short n_models_;
 
+        private:
+            /**
+            * @brief Update the combined channel gains.
+            */
+            void update_gains();
+
+        private:
+            /**
+            * @brief The exposure correction (in EV).
+            */
+            double exposure_;
+
+        private:
+            /**
+            * @brief The white balance gains (indexed by Channel::type).
+            */
+            double wb_gain_[mem::PHTR_MAX_CHANNELS];
+
+        private:
+            /**
+            * @brief The combined channel gains (indexed by Channel::type; 1.0 for alpha).
+            */
+            double gain_[mem::PHTR_MAX_CHANNELS];
+
     };
 
 } // namespace phtr
@@ -31,11 +31,13 @@ namespace phtr
     void ColourCorrectionQueue::get_correction_factors(const coord_tuple_T& coords,
             typename coord_tuple_T::channel_order_t::colour_tuple_t& factors) const
     {
-        typedef typename coord_tuple_T::channel_order_t::colour_tuple_t colour_tuple_t;
+        typedef typename coord_tuple_T::channel_order_t channel_order_t;
+        typedef typename channel_order_t::colour_tuple_t colour_tuple_t;
 
+        // start with the exposure/white balance gains
         for (size_t i = 0; i < colour_tuple_t::num_vals; ++i)
         {
-            factors.value[i] = 1.0;
+            factors.value[i] = gain_[channel_order_t::channel_type[i]];
         }
 
         colour_tuple_t tmp_factors;
@@ -48,4 +50,28 @@ namespace phtr
 
     }
 
+    template <typename colour_tuple_T>
+    void ColourCorrectionQueue::get_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+            size_t num, colour_tuple_T* factors) const
+    {
+        typedef typename colour_tuple_T::channel_order_t channel_order_t;
+
+        // start with the exposure/white balance gains
+        colour_tuple_T gains;
+        for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
+        {
+            gains.value[i] = gain_[channel_order_t::channel_type[i]];
+        }
+
+        for (size_t k = 0; k < num; ++k)
+        {
+            factors[k] = gains;
+        }
+
+        for (size_t i = 0; i < n_models_; ++i)
+        {
+            correction_model_[i]->mult_correction_factors_row(x, dx, y, num, factors);
+        }
+    }
+
 } // namespace phtr
@@ -0,0 +1,200 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_COST_MAP_H__
+#define PHTR_COST_MAP_H__
+
+extern "C"
+{
+#include <stdint.h>
+}
+
+#include <ostream>
+#include <vector>
+
+#include <photoropter/types.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Spatial map of the computational cost of a transformation.
+    * @details The output image is divided into tiles of a given size; for each
+    * tile, the clock ticks spent on its pixels are summed up (over all stages,
+    * cf. TransformStats). The map can be written as a CSV grid or as a greyscale
+    * PGM image to spot hotspots (e.g. image borders, large interpolation kernels)
+    * and load imbalance.
+    * @note The map is only filled if compiled with @c PHTR_INSTRUMENT.
+    */
+    class CostMap
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief Constructor.
+            * @details Creates an empty (i.e., disabled) map.
+            */
+            CostMap();
+
+        public:
+            /**
+            * @brief Set the map geometry; all cells are set to zero.
+            * @param[in] width       The width of the image (in pixels).
+            * @param[in] height      The height of the image (in pixels).
+            * @param[in] tile_width  The width of a tile (in pixels, at least 1).
+            * @param[in] tile_height The height of a tile (in pixels, at least 1).
+            */
+            void init(coord_t width, coord_t height, coord_t tile_width, coord_t tile_height);
+
+        public:
+            /**
+            * @brief Set all cells to zero.
+            */
+            void clear();
+
+        public:
+            /**
+            * @brief Check whether the map is empty (i.e., disabled).
+            * @return 'true' if the map has no cells.
+            */
+            bool empty() const;
+
+        public:
+            /**
+            * @brief Add the ticks spent on a single pixel.
+            * @param[in] x     The horizontal pixel position.
+            * @param[in] y     The vertical pixel position.
+            * @param[in] ticks The number of ticks.
+            */
+            inline void add(coord_t x, coord_t y, uint64_t ticks);
+
+        public:
+            /**
+            * @brief Distribute the ticks spent on a span of pixels in one line.
+            * @details The ticks are attributed to the covered tiles proportionally
+            * to the number of pixels.
+            * @param[in] x0    The first pixel of the span.
+            * @param[in] y     The line.
+            * @param[in] num   The number of pixels.
+            * @param[in] ticks The number of ticks.
+            */
+            void add_span(coord_t x0, coord_t y, coord_t num, uint64_t ticks);
+
+        public:
+            /**
+            * @brief Add the values of another map with the same geometry.
+            * @details If this map is empty, the other map is copied.
+            * @param[in] other The map to be added.
+            * @return Reference to this object.
+            */
+            CostMap& operator+=(const CostMap& other);
+
+        public:
+            /**
+            * @brief Get the number of tiles in horizontal direction.
+            * @return The number of tiles.
+            */
+            coord_t cells_x() const;
+
+        public:
+            /**
+            * @brief Get the number of tiles in vertical direction.
+            * @return The number of tiles.
+            */
+            coord_t cells_y() const;
+
+        public:
+            /**
+            * @brief Get the ticks spent in a given tile.
+            * @param[in] cx The horizontal tile index.
+            * @param[in] cy The vertical tile index.
+            * @return The number of ticks.
+            */
+            uint64_t ticks(coord_t cx, coord_t cy) const;
+
+        public:
+            /**
+            * @brief Write the map as a CSV grid (one line per row of tiles).
+            * @param[in] os The output stream.
+            * @param[in] ticks_per_second The tick rate (cf. TransformStats::ticks_per_second).
+            * If greater than zero, the values are written in milliseconds, otherwise in ticks.
+            */
+            void write_csv(std::ostream& os, double ticks_per_second) const;
+
+        public:
+            /**
+            * @brief Write the map as a binary 8 bit greyscale PGM image (one pixel per tile).
+            * @details The values are scaled linearly, so that the most expensive tile is white.
+            * @param[in] os The output stream (should be opened in binary mode).
+            */
+            void write_pgm(std::ostream& os) const;
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief Tile width.
+            */
+            coord_t tile_width_;
+
+        private:
+            /**
+            * @brief Tile height.
+            */
+            coord_t tile_height_;
+
+        private:
+            /**
+            * @brief Number of tiles in horizontal direction.
+            */
+            coord_t cells_x_;
+
+        private:
+            /**
+            * @brief Number of tiles in vertical direction.
+            */
+            coord_t cells_y_;
+
+        private:
+            /**
+            * @brief The tick sums (row-major).
+            */
+            std::vector<uint64_t> cells_;
+
+    }; // class CostMap
+
+} // namespace phtr
+
+#include <photoropter/cost_map.inl.h>
+
+#endif // PHTR_COST_MAP_H__
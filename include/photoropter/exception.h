@@ -94,6 +94,14 @@ namespace phtr
                 */
                 std::string msg_;
 
+            private:
+                /**
+                * @brief The complete message as returned by @ref what().
+                * @details This has to be a member, since @ref what() returns a pointer
+                * to its contents.
+                */
+                mutable std::string what_;
+
         }; // class base_exception
 
         /**
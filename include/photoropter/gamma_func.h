@@ -213,6 +213,9 @@ namespace phtr
                 * Example: @code set_params()(1.0)(0.0)(0.1)(0.2)(0.1); @endcode
                 * @note The coefficients vector is cleared first, so any remaining parameter not set will
                 * be zero.
+                * @note The lookup tables are rebuilt on the first evaluation after this call, which
+                * is not thread-safe: evaluate the function once before using it from several
+                * threads (or use set_param_list(), which updates the tables immediately).
                 * @return A SetParam instance pointing to the second parameter.
                 */
                 util::SetParam<coeff_iter_t> set_params();
@@ -249,37 +252,62 @@ namespace phtr
             protected:
                 /**
                 * @brief Worker function that is called by gamma() and inv_gamma().
-                * @details gamma() calls get_function_value() with x and y reversed,
-                * since a 'forward' gamma transformation corresponds to a backwards EMOR
-                * transformation.
+                * @details The function values are looked up in a table sampled on a uniform
+                * grid over [0..1], so evaluation costs one index calculation and one linear
+                * interpolation.
+                * @param[in] inp_val The input value.
+                * @param[in] tab The lookup table (@ref grid_num_ + 1 entries).
+                * @return The function value.
                 */
-                double get_function_value(double inp_val, const value_vect_t& xval, const value_vect_t& yval) const;
+                double get_function_value(double inp_val, const value_vect_t& tab) const;
+
+            protected:
+                /**
+                * @brief Make sure the lookup tables are up to date.
+                * @details This is only necessary after set_params(), since the coefficients
+                * are written by the returned SetParam object after the call returns. All
+                * other parameter changes update the tables immediately.
+                * @note The check is not synchronised: thread safety of concurrent gamma() and
+                * inv_gamma() calls relies on the tables having been precalculated eagerly.
+                * After set_params(), evaluate the function once before sharing the object
+                * between threads.
+                */
+                void check_precalc() const;
+
+            protected:
+                /**
+                * @brief Resample a piecewise linear function onto the uniform grid.
+                * @details The function is defined by the (ascending) sample positions in @c xval
+                * and the corresponding values in @c yval. Inputs of 0 and 1 map to 0 and 1.
+                * @param[in] xval The sample positions.
+                * @param[in] yval The function values.
+                * @param[out] tab The lookup table.
+                */
+                static void resample(const value_vect_t& xval, const value_vect_t& yval, value_vect_t& tab);
 
             private:
                 /**
-                * @brief Calculate function values and store them.
+                * @brief Calculate function values and store them in the lookup tables.
                 */
                 virtual void precalc_func() const = 0;
 
             protected:
                 /**
-                * @brief Internal flag to mark if function values have already been calculated (lazy init).
+                * @brief Internal flag to mark if the lookup tables are up to date.
                 */
                 mutable bool precalc_done_;
 
             protected:
                 /**
-                * @brief List of 'source' values for the transformation functions.
-                * @details 'x' corresponds to the irradiance level E in the EMOR model.
+                * @brief Lookup table for gamma().
                 */
-                mutable value_vect_t xval_;
+                mutable value_vect_t gamma_tab_;
 
             protected:
                 /**
-                * @brief List of function values.
-                * @details 'y' corresponds to the brightness level 'B' in the EMOR model.
+                * @brief Lookup table for inv_gamma().
                 */
-                mutable value_vect_t yval_;
+                mutable value_vect_t inv_gamma_tab_;
 
             protected:
                 /**
@@ -298,6 +326,14 @@ namespace phtr
                 * @brief The number of samples in each individual model curve.
                 */
                 static const size_t sample_num_ = 1024;
+
+            protected:
+                /**
+                * @brief The number of intervals in the uniform lookup tables.
+                * @details This is a multiple of (sample_num_ - 1), so the tables reproduce the
+                * original curves exactly in the direction where the samples are equidistant.
+                */
+                static const size_t grid_num_ = 4 * (sample_num_ - 1);
                 ///@endcond
 
                 /// @cond
@@ -379,6 +415,13 @@ namespace phtr
                  * public interface
                  * **************************************** */
 
+            public:
+                /**
+                * @brief Standard constructor.
+                * @details Initialises the function to the generic EMOR curve.
+                */
+                GammaEMOR();
+
             public:
                 /**
                 * @brief Apply %gamma transformation.
@@ -425,6 +468,13 @@ namespace phtr
                  * public interface
                  * **************************************** */
 
+            public:
+                /**
+                * @brief Standard constructor.
+                * @details Initialises the function to the generic inverse EMOR curve.
+                */
+                GammaInvEMOR();
+
             public:
                 /**
                 * @brief Apply %gamma transformation.
@@ -457,4 +507,6 @@ namespace phtr
 
 } // namespace phtr
 
+#include <photoropter/gamma_func.tpl.h>
+
 #endif // PHTR_GAMMA_FUNC_H__
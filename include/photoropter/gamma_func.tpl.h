@@ -0,0 +1,60 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+namespace phtr
+{
+
+    namespace gamma
+    {
+
+        template <class iterable_t>
+        void
+        GammaEMORBase::
+        set_param_list(const iterable_t& params)
+        {
+
+            coeff_.clear();
+            coeff_.resize(coeff_num_, 0);
+
+            coeff_iter_t coeff_iter;
+            typename iterable_t::const_iterator param_iter;
+
+            for (coeff_iter = coeff_.begin(), param_iter = params.begin();
+                    coeff_iter != coeff_.end() && param_iter != params.end();
+                    ++coeff_iter, ++param_iter)
+            {
+                *coeff_iter = *param_iter;
+            }
+
+            // update the lookup tables right away
+            precalc_func();
+            precalc_done_ = true;
+
+        }
+
+    } // namespace phtr::gamma
+
+} // namespace phtr
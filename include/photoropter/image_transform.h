@@ -28,12 +28,15 @@ THE SOFTWARE.
 #define PHTR_IMAGE_TRANSFORM_H__
 
 #include <vector>
+#include <limits>
 #include <cassert>
+#include <cmath>
 
 #include <photoropter/mem/colour_tuple.h>
 #include <photoropter/pixel_correction_queue.h>
 #include <photoropter/subpixel_correction_queue.h>
 #include <photoropter/colour_correction_queue.h>
+#include <photoropter/transform_stats.h>
 #include <photoropter/gamma_func.h>
 #include <photoropter/interpolation_type.h>
 #include <photoropter/interpolator/interpolator_nn.h>
@@ -145,6 +148,40 @@ namespace phtr
             */
             virtual void enable_gamma(bool do_enable) = 0;
 
+        public:
+            /**
+            * @brief Enable/disable the integer decoding table.
+            * @details For 8 and 16 bit storage, the normalisation and %gamma
+            * correction of channel values is looked up in a table indexed by the
+            * raw channel value (interpolating linearly between the entries for
+            * fractional values). Enabled by default.
+            * @param[in] do_enable If 'true', enable the table, disable otherwise.
+            */
+            virtual void enable_int_lut(bool do_enable) = 0;
+
+        public:
+            /**
+            * @brief Set the size of the output encoding table.
+            * @details The output stage maps linear channel values directly to output
+            * codes (inverse %gamma, clipping and quantisation in one step), using
+            * a table with the given number of points and linear interpolation
+            * between them. The default is 65536 points (the number is rounded up so that
+            * the points of the inverse %gamma table are included). The table is rebuilt
+            * immediately.
+            * @param[in] num The number of points (at least 2).
+            */
+            virtual void set_encode_precision(unsigned int num) = 0;
+
+        public:
+            /**
+            * @brief Enable/disable ordered dithering of the output values.
+            * @details If enabled, output values are quantised using a 4x4 Bayer matrix
+            * instead of plain rounding (useful e.g. for 8 bit output from smooth input).
+            * Disabled by default.
+            * @param[in] do_enable If 'true', enable dithering, disable otherwise.
+            */
+            virtual void enable_dither(bool do_enable) = 0;
+
         public:
             /**
              * @brief set (over-)sampling factor.
@@ -154,6 +191,45 @@ namespace phtr
              */
             virtual void set_sampling_fact(unsigned int fact) = 0;
 
+        public:
+            /**
+             * @brief Get the (over-)sampling factor.
+             * @return The sampling factor.
+             */
+            virtual unsigned int sampling_fact() const = 0;
+
+        public:
+            /**
+             * @brief Get the aspect ratio used for the normalised image coordinates.
+             * @return The aspect ratio (width / height) of the input image.
+             */
+            virtual double aspect_ratio() const = 0;
+
+        public:
+            /**
+             * @brief Get the statistics collected by do_transform().
+             * @details The statistics accumulate over all calls to do_transform()
+             * since construction or the last call to reset_stats(). They are only
+             * collected if compiled with @c PHTR_INSTRUMENT (cf. TransformStats).
+             * @return The statistics.
+             */
+            virtual const TransformStats& stats() const = 0;
+
+        public:
+            /**
+             * @brief Reset the collected statistics.
+             */
+            virtual void reset_stats() = 0;
+
+        public:
+            /**
+             * @brief Set the tile size of the cost map (cf. TransformStats::cost_map).
+             * @details The cost map is only collected if compiled with @c PHTR_INSTRUMENT.
+             * @param[in] tile_width  The tile width in pixels (0 disables the cost map).
+             * @param[in] tile_height The tile height in pixels (0 disables the cost map).
+             */
+            virtual void set_cost_map_tile_size(coord_t tile_width, coord_t tile_height) = 0;
+
     };
 
     /**
@@ -279,6 +355,40 @@ namespace phtr
             */
             void enable_gamma(bool do_enable);
 
+        public:
+            /**
+            * @brief Enable/disable the integer decoding table.
+            * @details For 8 and 16 bit storage, the normalisation and %gamma
+            * correction of channel values is looked up in a table indexed by the
+            * raw channel value (interpolating linearly between the entries for
+            * fractional values). Enabled by default.
+            * @param[in] do_enable If 'true', enable the table, disable otherwise.
+            */
+            void enable_int_lut(bool do_enable);
+
+        public:
+            /**
+            * @brief Set the size of the output encoding table.
+            * @details The output stage maps linear channel values directly to output
+            * codes (inverse %gamma, clipping and quantisation in one step), using
+            * a table with the given number of points and linear interpolation
+            * between them. The default is 65536 points (the number is rounded up so that
+            * the points of the inverse %gamma table are included). The table is rebuilt
+            * immediately.
+            * @param[in] num The number of points (at least 2).
+            */
+            void set_encode_precision(unsigned int num);
+
+        public:
+            /**
+            * @brief Enable/disable ordered dithering of the output values.
+            * @details If enabled, output values are quantised using a 4x4 Bayer matrix
+            * instead of plain rounding (useful e.g. for 8 bit output from smooth input).
+            * Disabled by default.
+            * @param[in] do_enable If 'true', enable dithering, disable otherwise.
+            */
+            void enable_dither(bool do_enable);
+
         public:
             /**
              * @brief set (over-)sampling factor.
@@ -288,6 +398,45 @@ namespace phtr
              */
             void set_sampling_fact(unsigned int fact);
 
+        public:
+            /**
+             * @brief Get the (over-)sampling factor.
+             * @return The sampling factor.
+             */
+            unsigned int sampling_fact() const;
+
+        public:
+            /**
+             * @brief Get the aspect ratio used for the normalised image coordinates.
+             * @return The aspect ratio (width / height) of the input image.
+             */
+            double aspect_ratio() const;
+
+        public:
+            /**
+             * @brief Get the statistics collected by do_transform().
+             * @details The statistics accumulate over all calls to do_transform()
+             * since construction or the last call to reset_stats(). They are only
+             * collected if compiled with @c PHTR_INSTRUMENT (cf. TransformStats).
+             * @return The statistics.
+             */
+            const TransformStats& stats() const;
+
+        public:
+            /**
+             * @brief Reset the collected statistics.
+             */
+            void reset_stats();
+
+        public:
+            /**
+             * @brief Set the tile size of the cost map (cf. TransformStats::cost_map).
+             * @details The cost map is only collected if compiled with @c PHTR_INSTRUMENT.
+             * @param[in] tile_width  The tile width in pixels (0 disables the cost map).
+             * @param[in] tile_height The tile height in pixels (0 disables the cost map).
+             */
+            void set_cost_map_tile_size(coord_t tile_width, coord_t tile_height);
+
         public:
             /**
              * @brief Access to the internal interpolation implementation.
@@ -311,6 +460,12 @@ namespace phtr
              */
             typedef typename image_view_r_t::storage_info_t::mem_layout_t::colour_tuple_t colour_tuple_t;
 
+        private:
+            /**
+             * @brief The channel storage type of the output image.
+             */
+            typedef typename image_view_w_T::channel_storage_t outp_channel_storage_t;
+
         private:
             /**
             * @brief Apply channel clipping.
@@ -327,6 +482,67 @@ namespace phtr
             */
             inline interp_channel_t normalise(interp_channel_t value) const;
 
+        private:
+            /**
+            * @brief Fill (or clear) the integer decoding table according to the
+            * current settings.
+            */
+            void update_int_lut();
+
+        private:
+            /**
+            * @brief Fill the output encoding table according to the current settings.
+            */
+            void update_enc_lut();
+
+        private:
+            /**
+            * @brief Convert a span of linear channel values to output codes.
+            * @param[in]  values The channel values (normalised, linear).
+            * @param[in]  num    The number of pixels.
+            * @param[in]  x0     The x coordinate of the first pixel (in the parent window).
+            * @param[in]  y      The y coordinate (in the parent window).
+            * @param[out] codes  The output codes (pixel by pixel, in channel order).
+            */
+            inline void encode_span(const colour_tuple_t* values, coord_t num,
+                                    coord_t x0, coord_t y,
+                                    outp_channel_storage_t* codes) const;
+
+        private:
+            /**
+            * @brief Check whether the colour-only fast path can be used.
+            * @details This is the case if no geometric corrections are configured,
+            * oversampling is disabled and the input image has the size of the output
+            * parent window, i.e. every output pixel maps exactly onto one input pixel.
+            * @param[in] p_width  The width of the output parent window.
+            * @param[in] p_height The height of the output parent window.
+            * @return @c true if the fast path is applicable.
+            */
+            bool colour_only(coord_t p_width, coord_t p_height) const;
+
+        private:
+            /**
+            * @brief Transform the image using colour corrections only.
+            * @details Each pixel is read directly from the input view (no interpolation),
+            * linearised, multiplied by the correction factors and encoded. The work is
+            * organised in rows, so that the inner loops run over contiguous buffers. Since
+            * every line is read completely before it is written, input and output
+            * may share the same memory (in-place operation).
+            * @param[in] i0       The first column of the region of interest.
+            * @param[in] j0       The first line of the region of interest.
+            * @param[in] i_limit  The column limit of the region of interest.
+            * @param[in] j_limit  The line limit of the region of interest.
+            * @param[in] p_offs_x The horizontal offset of the parent window.
+            * @param[in] p_offs_y The vertical offset of the parent window.
+            * @param[in] scale_x  The horizontal scaling to normalised coordinates.
+            * @param[in] scale_y  The vertical scaling to normalised coordinates.
+            * @param[in] stats_recorder The statistics recorder of the current call.
+            */
+            void do_colour_transform(coord_t i0, coord_t j0, coord_t i_limit, coord_t j_limit,
+                                     coord_t p_offs_x, coord_t p_offs_y,
+                                     interp_coord_t scale_x, interp_coord_t scale_y,
+                                     StatsRecorder& stats_recorder);
+
         private:
             /**
             * @brief Normalise a tuple of values to [0:1.0].
@@ -490,6 +706,66 @@ namespace phtr
             */
             std::vector<double> inv_gam_val_b_;
 
+        private:
+            /**
+            * @brief Flag controlling the integer decoding table.
+            */
+            bool use_int_lut_;
+
+        private:
+            /**
+            * @brief Decoding table, indexed by the raw channel value (minus the
+            * channel minimum). Empty if not in use.
+            * @details The table contains one additional entry, so that
+            * interpolation at the upper end of the range does not need a special case.
+            */
+            std::vector<interp_channel_t> int_lut_;
+
+        private:
+            /**
+            * @brief The channel range covered by @ref int_lut_ (i.e., the index of the
+            * last regular entry).
+            */
+            interp_channel_t int_lut_range_;
+
+        private:
+            /**
+            * @brief Requested number of points in the output encoding table.
+            */
+            unsigned int enc_point_num_;
+
+        private:
+            /**
+            * @brief Output encoding table (output code before rounding, as a function
+            * of the linear channel value). Contains one additional entry
+            * (cf. @ref int_lut_).
+            */
+            std::vector<interp_channel_t> enc_lut_;
+
+        private:
+            /**
+            * @brief Flag controlling ordered dithering.
+            */
+            bool do_dither_;
+
+        private:
+            /**
+            * @brief Statistics collected by do_transform().
+            */
+            TransformStats stats_;
+
+        private:
+            /**
+            * @brief Cost map tile width (0 if disabled).
+            */
+            coord_t cost_tile_width_;
+
+        private:
+            /**
+            * @brief Cost map tile height (0 if disabled).
+            */
+            coord_t cost_tile_height_;
+
     }; // class ImageTransform
 
     /**
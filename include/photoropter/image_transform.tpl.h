@@ -67,7 +67,13 @@ namespace phtr
             do_gamma_(true),
             do_inv_gamma_(true),
             gam_point_new_num_(1023),
-            gam_point_cur_num_(0)
+            gam_point_cur_num_(0),
+            use_int_lut_(true),
+            int_lut_range_(0),
+            enc_point_num_(65536),
+            do_dither_(false),
+            cost_tile_width_(0),
+            cost_tile_height_(0)
     {
         // set default gamma to sRGB
         set_gamma(gamma::GammaSRGB());
@@ -78,6 +84,10 @@ namespace phtr
     ImageTransform<interpolator_T, image_view_w_T>::
     do_transform()
     {
+        // statistics (only collected if compiled with PHTR_INSTRUMENT)
+        StatsRecorder stats_recorder(stats_);
+        stats_recorder.set_cost_map(outp_img_width_, outp_img_height_, cost_tile_width_, cost_tile_height_);
+
         // oversampling parameters
         const interp_coord_t sampling_fact = static_cast<interp_coord_t>(oversampling_);
         const interp_coord_t sampling_step_x = 1.0 / sampling_fact;
@@ -99,6 +109,12 @@ namespace phtr
         interp_coord_t scale_x = 2.0 * aspect_ratio / parent_x_max;
         interp_coord_t scale_y = 2.0 / parent_y_max;
 
+        // collapse radial correction chains (if enabled, cf. PixelCorrectionQueue::enable_radial_collapse();
+        // the tables are only rebuilt if the models or the radius have changed)
+        const interp_coord_t r_max = RadialTable::max_radius(aspect_ratio);
+        pixel_queue_.update_radial_collapse(r_max);
+        subpixel_queue_.update_radial_collapse(r_max, coord_tuple_t::channel_order_t::colour_tuple_t::num_vals);
+
         // running index variables are i (x direction) and j (y direction)
         // limits are: i0 <= i < i_limit and j0 <= j < j_limit
         coord_t i0(0);
@@ -109,88 +125,245 @@ namespace phtr
         // determine limits from image's region of interest
         image_view_w_.get_roi(i0, j0, i_limit, j_limit);
 
+        // without geometric corrections, no resampling is necessary
+        if (colour_only(p_width, p_height))
+        {
+            do_colour_transform(i0, j0, i_limit, j_limit, p_offs_x, p_offs_y, scale_x, scale_y, stats_recorder);
+            return;
+        }
+
         // main transformation loop
         // this variable has to be signed for OpenMP 2.0, which is the only
         // version supported by MSVC (no real problem, e.g. 'long' should be big enough anyway).
         omp_coord_t j(0);
-        coord_t i(0);
+        const coord_t row_len = (i_limit > i0) ? (i_limit - i0) : 0;
 #ifdef HAVE_OPENMP
-#pragma omp parallel for private (i)
+#pragma omp parallel
 #endif
-        for (j = static_cast<omp_coord_t>(j0); j < static_cast<omp_coord_t>(j_limit); ++j) // line loop
         {
+            // per-thread row buffers (linear values and output codes)
+            colour_tuple_t zero_vals;
+            zero_vals.clear();
+            std::vector<colour_tuple_t> row_vals(row_len + 1, zero_vals);
+            std::vector<outp_channel_storage_t> row_codes((row_len + 1) * colour_tuple_t::num_vals);
+            coord_t i(0);
+
+            // per-thread statistics
+            TransformStats thread_stats;
+            stats_recorder.prepare(thread_stats);
+            StageTimer timer(thread_stats);
 
-            // write-access iterator for this line
-            typename image_view_w_T::iter_t iter(image_view_w_.get_iter(i0, j));
-
-            for (i = i0; i < i_limit; ++i) // pixel loop
+#ifdef HAVE_OPENMP
+#pragma omp for
+#endif
+            for (j = static_cast<omp_coord_t>(j0); j < static_cast<omp_coord_t>(j_limit); ++j) // line loop
             {
-                // current pixel position
-                interp_coord_t cur_pixel_x(static_cast<interp_coord_t>(i));
-                interp_coord_t cur_pixel_y(static_cast<interp_coord_t>(j));
+                timer.start();
 
-                /* scaled coordinates (in the interpolator coordinates system) */
-                interp_coord_t dst_x(0);
-                interp_coord_t dst_y(0);
+                for (i = i0; i < i_limit; ++i) // pixel loop
+                {
+                    // current pixel position
+                    interp_coord_t cur_pixel_x(static_cast<interp_coord_t>(i));
+                    interp_coord_t cur_pixel_y(static_cast<interp_coord_t>(j));
 
-                // coordinates transformed to source image
-                mem::CoordTupleMono pixel_coords;
-                coord_tuple_t subpixel_coords;
+                    /* scaled coordinates (in the interpolator coordinates system) */
+                    interp_coord_t dst_x(0);
+                    interp_coord_t dst_y(0);
 
-                // channel value tuple (sum over oversampling steps)
-                colour_tuple_t value_sum;
-                value_sum.clear();
+                    // coordinates transformed to source image
+                    mem::CoordTupleMono pixel_coords;
+                    coord_tuple_t subpixel_coords;
 
-                // channel factors
-                colour_tuple_t factors;
+                    // channel value tuple (sum over oversampling steps)
+                    colour_tuple_t& value_sum = row_vals[i - i0];
+                    value_sum.clear();
 
-                // prepare (over-)sampling loop
-                interp_coord_t cur_samp_x(0);
-                interp_coord_t ini_samp_x(cur_pixel_x - 0.5 + (1.0 / (2 * sampling_fact)));
-                interp_coord_t cur_samp_y(cur_pixel_y - 0.5 + (1.0 / (2 * sampling_fact)));
-                unsigned int u(0);
-                unsigned int v(0);
+                    // channel factors
+                    colour_tuple_t factors;
 
-                for (v = 0; v < oversampling_; ++v)
-                {
-                    cur_samp_x = ini_samp_x;
+                    // prepare (over-)sampling loop
+                    interp_coord_t cur_samp_x(0);
+                    interp_coord_t ini_samp_x(cur_pixel_x - 0.5 + (1.0 / (2 * sampling_fact)));
+                    interp_coord_t cur_samp_y(cur_pixel_y - 0.5 + (1.0 / (2 * sampling_fact)));
+                    unsigned int u(0);
+                    unsigned int v(0);
 
-                    for (u = 0; u < oversampling_; ++u)
+                    for (v = 0; v < oversampling_; ++v)
                     {
-                        // get scaled coordinates (in the interpolator coordinates system)
-                        dst_x = ((cur_samp_x + p_offs_x) * scale_x) - aspect_ratio;
-                        dst_y = ((cur_samp_y + p_offs_y) * scale_y) - 1.0;
+                        cur_samp_x = ini_samp_x;
 
-                        // get coordinates transformed to source image
-                        pixel_queue_.get_src_coords(dst_x, dst_y, pixel_coords);
-                        subpixel_queue_.get_src_coords(pixel_coords, subpixel_coords);
+                        for (u = 0; u < oversampling_; ++u)
+                        {
+                            // get scaled coordinates (in the interpolator coordinates system)
+                            dst_x = ((cur_samp_x + p_offs_x) * scale_x) - aspect_ratio;
+                            dst_y = ((cur_samp_y + p_offs_y) * scale_y) - 1.0;
 
-                        // get channel values and correction factors
-                        colour_queue_.get_correction_factors(subpixel_coords, factors);
+                            // get coordinates transformed to source image
+                            pixel_queue_.get_src_coords(dst_x, dst_y, pixel_coords);
+                            timer.lap(TransformStats::Stage::pixel_queue);
+                            subpixel_queue_.get_src_coords(pixel_coords, subpixel_coords);
+                            timer.lap(TransformStats::Stage::subpixel_queue);
+                            timer.count_sample(subpixel_coords, aspect_ratio);
 
-                        value_sum += normalise(interpolator_.get_px_vals(subpixel_coords)) * factors;
+                            // get channel values and correction factors
+                            colour_queue_.get_correction_factors(subpixel_coords, factors);
+                            timer.lap(TransformStats::Stage::colour_queue);
 
-                        cur_samp_x += sampling_step_x;
-                    } // (inner) oversampling loop
+                            const colour_tuple_t px_vals(interpolator_.get_px_vals(subpixel_coords));
+                            timer.lap(TransformStats::Stage::interpolation);
 
-                    cur_samp_y += sampling_step_y;
-                } // (outer) oversampling loop
+                            value_sum += normalise(px_vals) * factors;
+                            timer.lap(TransformStats::Stage::normalise);
 
-                // scale channel values (due to oversampling)
-                value_sum *= channel_scaling;
+                            cur_samp_x += sampling_step_x;
+                        } // (inner) oversampling loop
 
-                // write channel values
-                iter.write_px_vals(unnormalise(value_sum));
+                        cur_samp_y += sampling_step_y;
+                    } // (outer) oversampling loop
 
-                // increment iterator position
-                iter.inc_x();
+                    // scale channel values (due to oversampling)
+                    value_sum *= channel_scaling;
+                    timer.pixel_done(i, static_cast<coord_t>(j));
 
-            } // column loop
+                } // column loop
 
-        } // line loop
+                // convert the line to output codes and write it
+                encode_span(&row_vals[0], row_len, i0 + p_offs_x, static_cast<coord_t>(j) + p_offs_y, &row_codes[0]);
+                timer.lap(TransformStats::Stage::encode);
+
+                typename image_view_w_T::iter_t iter(image_view_w_.get_iter(i0, j));
+                iter.template write_codes<colour_tuple_t>(&row_codes[0], row_len);
+                timer.lap(TransformStats::Stage::write);
+                timer.span_done(i0, static_cast<coord_t>(j), row_len);
+                timer.count_pixels(row_len);
+
+            } // line loop
+
+            stats_recorder.merge(thread_stats);
+
+        } // parallel region
 
     } //  ImageTransform<...>::do_transform()
 
+    template <typename interpolator_T, typename image_view_w_T>
+    bool
+    ImageTransform<interpolator_T, image_view_w_T>::
+    colour_only(coord_t p_width, coord_t p_height) const
+    {
+        return (oversampling_ == 1)
+               && pixel_queue_.empty()
+               && subpixel_queue_.empty()
+               && (interpolator_.image_view().width() == p_width)
+               && (interpolator_.image_view().height() == p_height);
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    do_colour_transform(coord_t i0, coord_t j0, coord_t i_limit, coord_t j_limit,
+                        coord_t p_offs_x, coord_t p_offs_y,
+                        interp_coord_t scale_x, interp_coord_t scale_y,
+                        StatsRecorder& stats_recorder)
+    {
+        typedef typename image_view_r_t::channel_storage_t inp_channel_storage_t;
+
+        const image_view_r_t& image_view_r = interpolator_.image_view();
+        const interp_coord_t aspect_ratio = interpolator_.aspect_ratio();
+        const size_t num_vals = colour_tuple_t::num_vals;
+        const inp_channel_storage_t min_code = static_cast<inp_channel_storage_t>(min_chan_val_);
+
+        // the decoding table covers the output channel range, so it can only be indexed
+        // directly if the input values fall into the same range
+        const bool direct_lut = !int_lut_.empty()
+                                && (static_cast<interp_channel_t>(std::numeric_limits<inp_channel_storage_t>::min()) >= min_chan_val_)
+                                && (static_cast<interp_channel_t>(std::numeric_limits<inp_channel_storage_t>::max()) <= max_chan_val_);
+
+        // normalised coordinates of the first column
+        const interp_coord_t dst_x0 = (static_cast<interp_coord_t>(i0 + p_offs_x) * scale_x) - aspect_ratio;
+
+        omp_coord_t j(0);
+        const coord_t row_len = (i_limit > i0) ? (i_limit - i0) : 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel
+#endif
+        {
+            // per-thread row buffers (linear values, correction factors and output codes)
+            colour_tuple_t zero_vals;
+            zero_vals.clear();
+            std::vector<colour_tuple_t> row_vals(row_len + 1, zero_vals);
+            std::vector<colour_tuple_t> row_factors(row_len + 1, zero_vals);
+            std::vector<inp_channel_storage_t> row_planes((row_len + 1) * num_vals);
+            std::vector<outp_channel_storage_t> row_codes((row_len + 1) * num_vals);
+
+            // per-thread statistics (reading the line counts as interpolation)
+            TransformStats thread_stats;
+            stats_recorder.prepare(thread_stats);
+            StageTimer timer(thread_stats);
+
+#ifdef HAVE_OPENMP
+#pragma omp for
+#endif
+            for (j = static_cast<omp_coord_t>(j0); j < static_cast<omp_coord_t>(j_limit); ++j) // line loop
+            {
+                const coord_t src_y = static_cast<coord_t>(j) + p_offs_y;
+                const interp_coord_t dst_y = (static_cast<interp_coord_t>(src_y) * scale_y) - 1.0;
+                timer.start();
+
+                // read the line (this completes before anything is written)
+                image_view_r.read_span(i0 + p_offs_x, src_y, row_len, &row_planes[0], row_len);
+                timer.lap(TransformStats::Stage::interpolation);
+
+                // linearise
+                for (size_t c = 0; c < num_vals; ++c)
+                {
+                    const inp_channel_storage_t* plane = &row_planes[c * row_len];
+
+                    if (direct_lut)
+                    {
+                        // integer input: no interpolation between the table entries
+                        for (coord_t k = 0; k < row_len; ++k)
+                        {
+                            row_vals[k].value[c] = int_lut_[static_cast<size_t>(plane[k] - min_code)];
+                        }
+                    }
+                    else
+                    {
+                        for (coord_t k = 0; k < row_len; ++k)
+                        {
+                            row_vals[k].value[c] = normalise(static_cast<interp_channel_t>(plane[k]));
+                        }
+                    }
+                }
+                timer.lap(TransformStats::Stage::normalise);
+
+                // apply the correction factors
+                colour_queue_.get_correction_factors_row(dst_x0, scale_x, dst_y, row_len, &row_factors[0]);
+
+                for (coord_t k = 0; k < row_len; ++k)
+                {
+                    row_vals[k] *= row_factors[k];
+                }
+                timer.lap(TransformStats::Stage::colour_queue);
+
+                // convert the line to output codes and write it
+                encode_span(&row_vals[0], row_len, i0 + p_offs_x, src_y, &row_codes[0]);
+                timer.lap(TransformStats::Stage::encode);
+
+                typename image_view_w_T::iter_t iter(image_view_w_.get_iter(i0, j));
+                iter.template write_codes<colour_tuple_t>(&row_codes[0], row_len);
+                timer.lap(TransformStats::Stage::write);
+                timer.span_done(i0, static_cast<coord_t>(j), row_len);
+                timer.count_pixels(row_len);
+                timer.count_samples(row_len);
+
+            } // line loop
+
+            stats_recorder.merge(thread_stats);
+
+        } // parallel region
+
+    }
+
     template <typename interpolator_T, typename image_view_w_T>
     PixelCorrectionQueue&
     ImageTransform<interpolator_T, image_view_w_T>::
@@ -285,6 +458,9 @@ namespace phtr
             inv_gam_val_b_[i] = ig1 - ia * v1;
         }
 
+        update_int_lut();
+        update_enc_lut();
+
     }
 
     template <typename interpolator_T, typename image_view_w_T>
@@ -302,6 +478,135 @@ namespace phtr
     enable_gamma(bool do_enable)
     {
         do_gamma_ = do_inv_gamma_ = do_enable;
+        update_int_lut();
+        update_enc_lut();
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    set_encode_precision(unsigned int num)
+    {
+        assert(num >= 2);
+        enc_point_num_ = num;
+        update_enc_lut();
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    enable_dither(bool do_enable)
+    {
+        do_dither_ = do_enable;
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    update_enc_lut()
+    {
+        size_t num_intervals = enc_point_num_ - 1;
+
+        // align the table with the inverse gamma table, so that all its nodes are
+        // table points as well (the result is then exact apart from rounding)
+        if (do_inv_gamma_ && (gam_point_cur_num_ > 1))
+        {
+            const size_t gam_intervals = gam_point_cur_num_ - 1;
+            num_intervals = ((num_intervals + gam_intervals - 1) / gam_intervals) * gam_intervals;
+        }
+
+        enc_lut_.resize(num_intervals + 2);
+
+        const interp_channel_t scale = static_cast<interp_channel_t>(num_intervals);
+
+        for (size_t i = 0; i <= num_intervals; ++i)
+        {
+            enc_lut_[i] = unnormalise(static_cast<interp_channel_t>(i) / scale);
+        }
+
+        enc_lut_[num_intervals + 1] = enc_lut_[num_intervals];
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    encode_span(const colour_tuple_t* values, coord_t num,
+                coord_t x0, coord_t y,
+                outp_channel_storage_t* codes) const
+    {
+        // 4x4 Bayer matrix
+        static const unsigned int bayer[4][4] =
+        {
+            { 0,  8,  2, 10},
+            {12,  4, 14,  6},
+            { 3, 11,  1,  9},
+            {15,  7, 13,  5}
+        };
+
+        const interp_channel_t scale = static_cast<interp_channel_t>(enc_lut_.size() - 2);
+        const interp_channel_t* lut = &enc_lut_[0];
+        const size_t num_vals = colour_tuple_t::num_vals;
+
+        for (coord_t k = 0; k < num; ++k)
+        {
+            // rounding threshold
+            interp_channel_t thres(0.5);
+            if (do_dither_)
+            {
+                thres = (static_cast<interp_channel_t>(bayer[y & 3][(x0 + k) & 3]) + 0.5) / 16.0;
+            }
+
+            for (size_t i = 0; i < num_vals; ++i)
+            {
+                // clip to [0:1] (this also catches NaN values)
+                interp_channel_t val = values[k].value[i];
+                val = (val > 0.0) ? ((val < 1.0) ? val : 1.0) : 0.0;
+
+                interp_channel_t pos = val * scale;
+                size_t idx = static_cast<size_t>(pos);
+                interp_channel_t code = lut[idx] + (pos - static_cast<interp_channel_t>(idx)) * (lut[idx + 1] - lut[idx]);
+
+                codes[k * num_vals + i] = static_cast<outp_channel_storage_t>(code + thres);
+            }
+        }
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    enable_int_lut(bool do_enable)
+    {
+        use_int_lut_ = do_enable;
+        update_int_lut();
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    update_int_lut()
+    {
+        // only feasible for 8/16 bit storage
+        const interp_channel_t range = max_chan_val_ - min_chan_val_;
+
+        if (!use_int_lut_ || range > 65535.0)
+        {
+            int_lut_.clear();
+            int_lut_range_ = 0;
+            return;
+        }
+
+        const size_t num_entries = static_cast<size_t>(range) + 1;
+        int_lut_.resize(num_entries + 1);
+        int_lut_range_ = range;
+
+        // use the same (piecewise linear) gamma function as the direct computation,
+        // so that integer input values yield identical results
+        for (size_t i = 0; i < num_entries; ++i)
+        {
+            int_lut_[i] = static_cast<interp_channel_t>(gamma(static_cast<interp_channel_t>(i) / range));
+        }
+
+        int_lut_[num_entries] = int_lut_[num_entries - 1];
     }
 
     template <typename interpolator_T, typename image_view_w_T>
@@ -313,6 +618,47 @@ namespace phtr
         oversampling_ = fact;
     }
 
+    template <typename interpolator_T, typename image_view_w_T>
+    unsigned int
+    ImageTransform<interpolator_T, image_view_w_T>::
+    sampling_fact() const
+    {
+        return oversampling_;
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    double
+    ImageTransform<interpolator_T, image_view_w_T>::
+    aspect_ratio() const
+    {
+        return interpolator_.aspect_ratio();
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    const TransformStats&
+    ImageTransform<interpolator_T, image_view_w_T>::
+    stats() const
+    {
+        return stats_;
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    reset_stats()
+    {
+        stats_.clear();
+    }
+
+    template <typename interpolator_T, typename image_view_w_T>
+    void
+    ImageTransform<interpolator_T, image_view_w_T>::
+    set_cost_map_tile_size(coord_t tile_width, coord_t tile_height)
+    {
+        cost_tile_width_ = tile_width;
+        cost_tile_height_ = tile_height;
+    }
+
     template <typename interpolator_T, typename image_view_w_T>
     interpolator_T&
     ImageTransform<interpolator_T, image_view_w_T>::
@@ -346,6 +692,16 @@ namespace phtr
     ImageTransform<interpolator_T, image_view_w_T>::
     normalise(interp_channel_t value) const
     {
+        interp_channel_t pos = value - min_chan_val_;
+
+        if (!int_lut_.empty() && (pos >= 0) && (pos <= int_lut_range_))
+        {
+            size_t idx = static_cast<size_t>(pos);
+            interp_channel_t frac = pos - static_cast<interp_channel_t>(idx);
+
+            return int_lut_[idx] + frac * (int_lut_[idx + 1] - int_lut_[idx]);
+        }
+
         return static_cast<interp_channel_t>(
                    gamma((value - min_chan_val_) / (max_chan_val_ - min_chan_val_)));
     }
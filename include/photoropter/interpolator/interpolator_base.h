@@ -59,6 +59,13 @@ namespace phtr
             */
             interp_coord_t aspect_ratio() const;
 
+        public:
+            /**
+            * @brief Access the image view the interpolator reads from.
+            * @return Reference to the image view.
+            */
+            const view_T& image_view() const;
+
             /* ****************************************
              * internals
              * **************************************** */
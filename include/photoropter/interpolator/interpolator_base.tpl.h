@@ -66,6 +66,12 @@ namespace phtr
         return aspect_ratio_;
     }
 
+    template <typename view_T>
+    const view_T& InterpolatorBase<view_T>::image_view() const
+    {
+        return image_view_;
+    }
+
     ///@endcond
 
 } // namespace phtr
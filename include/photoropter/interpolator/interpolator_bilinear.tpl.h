@@ -136,4 +136,12 @@ namespace phtr
         return ret;
     }
 
+    template <typename view_T>
+    unsigned int
+    InterpolatorBilinear<view_T>::
+    support() const
+    {
+        return 1;
+    }
+
 } // namespace phtr
@@ -159,6 +159,14 @@ namespace phtr
         return ret;
     }
 
+    template <typename view_T>
+    unsigned int
+    InterpolatorLanczos<view_T>::
+    support() const
+    {
+        return support_;
+    }
+
     template <typename view_T>
     void
     InterpolatorLanczos<view_T>::
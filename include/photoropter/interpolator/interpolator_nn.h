@@ -86,6 +86,16 @@ namespace phtr
             template <typename coord_tuple_T>
             inline typename coord_tuple_T::channel_order_t::colour_tuple_t get_px_vals(const coord_tuple_T& coords) const;
 
+        public:
+            /**
+            * @brief Get the support of the interpolation.
+            * @details A value interpolated at the (pixel) position y depends only on the
+            * image lines floor(y) - support + 1 ... floor(y) + support (the same holds
+            * for the columns).
+            * @return The support (in pixels).
+            */
+            unsigned int support() const;
+
     }; // class InterpolatorNN<...>
 
 } // namespace phtr
@@ -82,4 +82,12 @@ namespace phtr
         return ret;
     }
 
+    template <typename view_T>
+    unsigned int
+    InterpolatorNN<view_T>::
+    support() const
+    {
+        return 1;
+    }
+
 }
@@ -0,0 +1,65 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_LINE_SINK_H__
+#define PHTR_LINE_SINK_H__
+
+#include <photoropter/types.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Interface for classes that consume image data line by line.
+    * @details A line sink receives the output lines of an @ref IStreamingTransform
+    * (e.g., to pass them on to an image encoder).
+    */
+    class ILineSink
+    {
+
+        public:
+            /**
+             * @ brief (Dummy) Destructor.
+             */
+            virtual ~ILineSink() {};
+
+        public:
+            /**
+            * @brief Consume an image line.
+            * @details The line data uses the memory layout of an image of height 1
+            * (with the image width and storage type of the transformation). It is
+            * only valid during the call.
+            * @param[in] line_num  The line number.
+            * @param[in] line_data The line data.
+            */
+            virtual void write_line(coord_t line_num, const void* line_data) = 0;
+
+    }; // class ILineSink
+
+} // namespace phtr
+
+#endif // PHTR_LINE_SINK_H__
@@ -0,0 +1,343 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_CHANNEL_OFFSETS_H__
+#define PHTR_CHANNEL_OFFSETS_H__
+
+#include <cassert>
+
+#include <photoropter/types.h>
+#include <photoropter/mem/channel_type.h>
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/mem_layout.h>
+#include <photoropter/mem/mem_storage_info.h>
+
+namespace phtr
+{
+
+    namespace mem
+    {
+
+        ///@cond PROTECTED
+
+        /**
+        * @brief Pixel step and channel offsets of a memory layout (runtime version).
+        * @details This is used as base class by image views and iterators. For layouts
+        * where the offsets are known at compile time, a specialisation without any
+        * data members is used instead.
+        * @param storage_T The storage type.
+        * @param fixed_T   Whether the offsets are compile-time constants.
+        */
+        template <Storage::type storage_T, bool fixed_T = MemLayout<storage_T>::fixed_offsets>
+        class ChannelOffsets
+        {
+
+                /* ****************************************
+                 * public interface
+                 * **************************************** */
+
+            public:
+                /**
+                * @brief The memory layout type.
+                */
+                typedef MemLayout<storage_T> mem_layout_t;
+
+            public:
+                /**
+                * @brief Constructor.
+                * @param[in] step   The step between pixels.
+                * @param[in] r_offs The red channel offset.
+                * @param[in] g_offs The green channel offset.
+                * @param[in] b_offs The blue channel offset.
+                * @param[in] a_offs The alpha channel offset.
+                */
+                ChannelOffsets(size_t step, size_t r_offs, size_t g_offs, size_t b_offs, size_t a_offs)
+                        : step_(step),
+                        r_offs_(r_offs),
+                        g_offs_(g_offs),
+                        b_offs_(b_offs),
+                        a_offs_(a_offs)
+                {
+                    //NIL
+                }
+
+            public:
+                /**
+                * @brief Constructor.
+                * @param[in] info The storage info object.
+                */
+                explicit ChannelOffsets(const MemStorageInfo<storage_T>& info)
+                        : step_(info.step),
+                        r_offs_(info.r_offs),
+                        g_offs_(info.g_offs),
+                        b_offs_(info.b_offs),
+                        a_offs_(info.a_offs)
+                {
+                    //NIL
+                }
+
+            public:
+                /**
+                * @brief Get the step between pixels.
+                * @return The step.
+                */
+                size_t step() const
+                {
+                    return step_;
+                }
+
+            public:
+                /**
+                * @brief Get the offset of the given channel.
+                * @param[in] chan The channel type.
+                * @return The offset.
+                */
+                size_t offs(Channel::type chan) const
+                {
+                    switch (chan)
+                    {
+                        case Channel::red:
+                        default:
+                            return r_offs_;
+                            break;
+
+                        case Channel::green:
+                            return g_offs_;
+                            break;
+
+                        case Channel::blue:
+                            return b_offs_;
+                            break;
+
+                        case Channel::alpha:
+                            return a_offs_;
+                            break;
+                    }
+                }
+
+            public:
+                /**
+                * @brief Get the offset of the channel at the given position of
+                * the channel order (i.e., of a colour tuple).
+                * @param[in] idx The index.
+                * @return The offset.
+                */
+                size_t tuple_offs(size_t idx) const
+                {
+                    return offs(mem_layout_t::channel_type[idx]);
+                }
+
+                /* ****************************************
+                 * internals
+                 * **************************************** */
+
+            private:
+                /**
+                * @brief The step between pixels.
+                */
+                const size_t step_;
+
+            private:
+                /**
+                * @brief The red channel offset.
+                */
+                const size_t r_offs_;
+
+            private:
+                /**
+                * @brief The green channel offset.
+                */
+                const size_t g_offs_;
+
+            private:
+                /**
+                * @brief The blue channel offset.
+                */
+                const size_t b_offs_;
+
+            private:
+                /**
+                * @brief The alpha channel offset.
+                */
+                const size_t a_offs_;
+
+        }; // template class ChannelOffsets<>
+
+        /**
+        * @brief Pixel step and channel offsets of a memory layout (compile-time version).
+        * @details All values are constants, so the compiler can resolve the offsets
+        * (e.g., when accessing a whole pixel via a colour tuple).
+        * @param storage_T The storage type.
+        */
+        template <Storage::type storage_T>
+        class ChannelOffsets<storage_T, true>
+        {
+
+                /* ****************************************
+                 * public interface
+                 * **************************************** */
+
+            public:
+                /**
+                * @brief The memory layout type.
+                */
+                typedef MemLayout<storage_T> mem_layout_t;
+
+            public:
+                /**
+                * @brief Constructor.
+                * @details The arguments are only present for compatibility with the
+                * runtime version; they have to match the layout constants (checked
+                * in debug builds).
+                * @param[in] step   The step between pixels.
+                * @param[in] r_offs The red channel offset.
+                * @param[in] g_offs The green channel offset.
+                * @param[in] b_offs The blue channel offset.
+                * @param[in] a_offs The alpha channel offset.
+                */
+                ChannelOffsets(size_t step, size_t r_offs, size_t g_offs, size_t b_offs, size_t a_offs)
+                {
+                    assert(matches(step, r_offs, g_offs, b_offs, a_offs));
+                    (void)step;
+                    (void)r_offs;
+                    (void)g_offs;
+                    (void)b_offs;
+                    (void)a_offs;
+                }
+
+            public:
+                /**
+                * @brief Constructor.
+                * @details The storage info has to match the layout constants (checked
+                * in debug builds).
+                * @param[in] info The storage info object.
+                */
+                explicit ChannelOffsets(const MemStorageInfo<storage_T>& info)
+                {
+                    assert(matches(info.step, info.r_offs, info.g_offs, info.b_offs, info.a_offs));
+                    (void)info;
+                }
+
+            public:
+                /**
+                * @brief Get the step between pixels.
+                * @return The step.
+                */
+                static size_t step()
+                {
+                    return mem_layout_t::fixed_step;
+                }
+
+            public:
+                /**
+                * @brief Get the offset of the given channel.
+                * @param[in] chan The channel type.
+                * @return The offset.
+                */
+                static size_t offs(Channel::type chan)
+                {
+                    switch (chan)
+                    {
+                        case Channel::red:
+                        default:
+                            return mem_layout_t::fixed_r_offs;
+                            break;
+
+                        case Channel::green:
+                            return mem_layout_t::fixed_g_offs;
+                            break;
+
+                        case Channel::blue:
+                            return mem_layout_t::fixed_b_offs;
+                            break;
+
+                        case Channel::alpha:
+                            return mem_layout_t::fixed_a_offs;
+                            break;
+                    }
+                }
+
+            public:
+                /**
+                * @brief Get the offset of the channel at the given position of
+                * the channel order (i.e., of a colour tuple).
+                * @note For interleaved layouts, the channels are stored in channel order.
+                * @param[in] idx The index.
+                * @return The offset (i.e., the index itself).
+                */
+                static size_t tuple_offs(size_t idx)
+                {
+                    return idx;
+                }
+
+                /* ****************************************
+                 * internals
+                 * **************************************** */
+
+            private:
+                /**
+                * @brief Check the layout constants against the given (runtime) layout.
+                * @details Also checks that the channels are stored in channel order,
+                * which tuple_offs() relies on.
+                * @param[in] step   The step between pixels.
+                * @param[in] r_offs The red channel offset.
+                * @param[in] g_offs The green channel offset.
+                * @param[in] b_offs The blue channel offset.
+                * @param[in] a_offs The alpha channel offset.
+                * @return @c true if everything matches.
+                */
+                static bool matches(size_t step, size_t r_offs, size_t g_offs, size_t b_offs, size_t a_offs)
+                {
+                    if (step != mem_layout_t::fixed_step
+                            || r_offs != mem_layout_t::fixed_r_offs
+                            || g_offs != mem_layout_t::fixed_g_offs
+                            || b_offs != mem_layout_t::fixed_b_offs
+                            || a_offs != mem_layout_t::fixed_a_offs)
+                    {
+                        return false;
+                    }
+
+                    for (size_t i = 0; i < mem_layout_t::num_channels(); ++i)
+                    {
+                        if (offs(mem_layout_t::channel_type[i]) != i)
+                        {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+        }; // template class ChannelOffsets<storage_T, true>
+
+        ///@endcond
+
+    } // namespace phtr::mem
+
+} // namespace phtr
+
+#endif // PHTR_CHANNEL_OFFSETS_H__
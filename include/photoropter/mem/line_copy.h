@@ -0,0 +1,69 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_LINE_COPY_H__
+#define PHTR_LINE_COPY_H__
+
+#include <photoropter/types.h>
+#include <photoropter/mem/storage_type.h>
+
+namespace phtr
+{
+
+    namespace mem
+    {
+
+        ///@cond PROTECTED
+
+        /**
+        * @brief Copy a single image line between two buffers of the same width
+        * and storage type.
+        * @details The buffers may have different heights (which matters for planar
+        * storage types, where the channel planes are stored one after another).
+        * @param[in] src        The source buffer.
+        * @param[in] src_height The height of the source buffer.
+        * @param[in] src_line   The line to copy from.
+        * @param[out] dst       The destination buffer.
+        * @param[in] dst_height The height of the destination buffer.
+        * @param[in] dst_line   The line to copy to.
+        * @param[in] width      The width of both buffers.
+        * @param storage_T The storage type (e.g. @ref Storage::rgb_8_inter).
+        */
+        template <Storage::type storage_T>
+        void copy_line(const void* src, coord_t src_height, coord_t src_line,
+                       void* dst, coord_t dst_height, coord_t dst_line,
+                       coord_t width);
+
+        ///@endcond
+
+    } // namespace phtr::mem
+
+} // namespace phtr
+
+#include <photoropter/mem/line_copy.tpl.h>
+
+#endif // PHTR_LINE_COPY_H__
@@ -0,0 +1,79 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <cstring>
+
+#include <photoropter/mem/mem_storage_info.h>
+
+namespace phtr
+{
+
+    namespace mem
+    {
+
+        ///@cond PROTECTED
+
+        template <Storage::type storage_T>
+        void copy_line(const void* src, coord_t src_height, coord_t src_line,
+                       void* dst, coord_t dst_height, coord_t dst_line,
+                       coord_t width)
+        {
+            typedef typename MemStorageInfo<storage_T>::channel_storage_t channel_storage_t;
+
+            const MemStorageInfo<storage_T> src_info(width, src_height);
+            const MemStorageInfo<storage_T> dst_info(width, dst_height);
+
+            const channel_storage_t* src_line_addr =
+                static_cast<const channel_storage_t*>(src) + src_line * src_info.line_step;
+            channel_storage_t* dst_line_addr =
+                static_cast<channel_storage_t*>(dst) + dst_line * dst_info.line_step;
+
+            if (src_info.step == src_info.num_channels)
+            {
+                // interleaved: the line is a contiguous block
+                std::memcpy(dst_line_addr, src_line_addr,
+                            src_info.line_step * sizeof(channel_storage_t));
+            }
+            else
+            {
+                // planar: copy channel by channel
+                const size_t src_offs[] = {src_info.r_offs, src_info.g_offs, src_info.b_offs, src_info.a_offs};
+                const size_t dst_offs[] = {dst_info.r_offs, dst_info.g_offs, dst_info.b_offs, dst_info.a_offs};
+
+                for (size_t c = 0; c < src_info.num_channels; ++c)
+                {
+                    std::memcpy(dst_line_addr + dst_offs[c], src_line_addr + src_offs[c],
+                                width * sizeof(channel_storage_t));
+                }
+            }
+        }
+
+        ///@endcond
+
+    } // namespace phtr::mem
+
+} // namespace phtr
@@ -209,6 +209,40 @@ namespace phtr
         struct GenericInterleavedLayoutRGB
         {
 
+            /**
+            * @brief Whether step and channel offsets are compile-time constants.
+            * @details For interleaved layouts they do not depend on the image size. The
+            * runtime functions below return these constants, so both always agree.
+            * The channel offsets are then given by the position of the channel in the
+            * channel order (cf. @ref ChannelOffsets).
+            */
+            static const bool fixed_offsets = true;
+
+            /**
+            * @brief The 'step' between pixels (compile-time constant).
+            */
+            static const size_t fixed_step = 3;
+
+            /**
+            * @brief The red channel offset (compile-time constant).
+            */
+            static const size_t fixed_r_offs = 0;
+
+            /**
+            * @brief The green channel offset (compile-time constant).
+            */
+            static const size_t fixed_g_offs = 1;
+
+            /**
+            * @brief The blue channel offset (compile-time constant).
+            */
+            static const size_t fixed_b_offs = 2;
+
+            /**
+            * @brief The alpha channel offset (compile-time constant).
+            */
+            static const size_t fixed_a_offs = 0;
+
             /**
             * @brief Return the number of channels (e.g., 3).
             * @details The number has to be at least 3 in order for RGB data to fit,
@@ -227,7 +261,7 @@ namespace phtr
             */
             static size_t step(coord_t, coord_t)
             {
-                return 3;
+                return fixed_step;
             }
 
             /**
@@ -236,7 +270,7 @@ namespace phtr
             */
             static size_t line_step(coord_t width, coord_t)
             {
-                return 3 * width;
+                return fixed_step * width;
             }
 
             /**
@@ -245,7 +279,7 @@ namespace phtr
             */
             static size_t r_offs(coord_t, coord_t)
             {
-                return 0;
+                return fixed_r_offs;
             }
 
             /**
@@ -254,7 +288,7 @@ namespace phtr
             */
             static size_t g_offs(coord_t, coord_t)
             {
-                return 1;
+                return fixed_g_offs;
             }
 
             /**
@@ -263,7 +297,7 @@ namespace phtr
             */
             static size_t b_offs(coord_t, coord_t)
             {
-                return 2;
+                return fixed_b_offs;
             }
 
             /**
@@ -272,7 +306,7 @@ namespace phtr
             */
             static size_t a_offs(coord_t, coord_t)
             {
-                return 0;
+                return fixed_a_offs;
             }
 
         }; // struct GenericInterleavedLayoutRGB
@@ -284,6 +318,40 @@ namespace phtr
         struct GenericInterleavedLayoutRGBA
         {
 
+            /**
+            * @brief Whether step and channel offsets are compile-time constants.
+            * @details For interleaved layouts they do not depend on the image size. The
+            * runtime functions below return these constants, so both always agree.
+            * The channel offsets are then given by the position of the channel in the
+            * channel order (cf. @ref ChannelOffsets).
+            */
+            static const bool fixed_offsets = true;
+
+            /**
+            * @brief The 'step' between pixels (compile-time constant).
+            */
+            static const size_t fixed_step = 4;
+
+            /**
+            * @brief The red channel offset (compile-time constant).
+            */
+            static const size_t fixed_r_offs = 0;
+
+            /**
+            * @brief The green channel offset (compile-time constant).
+            */
+            static const size_t fixed_g_offs = 1;
+
+            /**
+            * @brief The blue channel offset (compile-time constant).
+            */
+            static const size_t fixed_b_offs = 2;
+
+            /**
+            * @brief The alpha channel offset (compile-time constant).
+            */
+            static const size_t fixed_a_offs = 3;
+
             /**
             * @brief Return the number of channels (e.g., 3).
             * @details The number has to be at least 3 in order for RGB data to fit,
@@ -302,7 +370,7 @@ namespace phtr
             */
             static size_t step(coord_t, coord_t)
             {
-                return 4;
+                return fixed_step;
             }
 
             /**
@@ -311,7 +379,7 @@ namespace phtr
             */
             static size_t line_step(coord_t width, coord_t)
             {
-                return 4 * width;
+                return fixed_step * width;
             }
 
             /**
@@ -320,7 +388,7 @@ namespace phtr
             */
             static size_t r_offs(coord_t, coord_t)
             {
-                return 0;
+                return fixed_r_offs;
             }
 
             /**
@@ -329,7 +397,7 @@ namespace phtr
             */
             static size_t g_offs(coord_t, coord_t)
             {
-                return 1;
+                return fixed_g_offs;
             }
 
             /**
@@ -338,7 +406,7 @@ namespace phtr
             */
             static size_t b_offs(coord_t, coord_t)
             {
-                return 2;
+                return fixed_b_offs;
             }
 
             /**
@@ -347,7 +415,7 @@ namespace phtr
             */
             static size_t a_offs(coord_t, coord_t)
             {
-                return 3;
+                return fixed_a_offs;
             }
 
         }; // struct GenericInterleavedLayoutRGBA
@@ -359,6 +427,12 @@ namespace phtr
         struct GenericPlanarLayoutRGB
         {
 
+            /**
+            * @brief Whether step and channel offsets are compile-time constants.
+            * @details For planar layouts the channel offsets depend on the image size.
+            */
+            static const bool fixed_offsets = false;
+
             /**
             * @brief Return the number of channels (e.g., 3).
             * @details The number has to be at least 3 in order for RGB data to fit,
@@ -434,6 +508,12 @@ namespace phtr
         struct GenericPlanarLayoutRGBA
         {
 
+            /**
+            * @brief Whether step and channel offsets are compile-time constants.
+            * @details For planar layouts the channel offsets depend on the image size.
+            */
+            static const bool fixed_offsets = false;
+
             /**
             * @brief Return the number of channels (e.g., 3).
             * @details The number has to be at least 3 in order for RGB data to fit,
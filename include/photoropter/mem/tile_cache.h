@@ -0,0 +1,438 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_TILE_CACHE_H__
+#define PHTR_TILE_CACHE_H__
+
+#include <vector>
+#include <list>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <photoropter/types.h>
+#include <photoropter/tile_provider.h>
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/mem_storage_info.h>
+
+namespace phtr
+{
+
+    namespace mem
+    {
+
+        ///@cond PROTECTED
+
+        /**
+        * @brief Least-recently-used cache of image tiles.
+        * @details The image is divided into a regular grid of tiles which are
+        * requested from an @ref ITileProvider when they are first accessed. If the
+        * memory budget is exhausted, the least recently used tile which is not
+        * currently 'pinned' is evicted. Pinned tiles are never evicted, so the budget
+        * may be exceeded temporarily if all cached tiles are in use.
+        * @note The cache may be used from the parallelised transformation loop.
+        * Each thread keeps the last few tiles it used pinned in a slot of its own,
+        * so pinning one of these again does not need any synchronisation. All
+        * other bookkeeping is protected by an OpenMP critical section; tiles are
+        * loaded outside of it (other threads requesting the same tile wait until
+        * it is ready), one at a time.
+        * @param storage_T The storage type (e.g. @ref Storage::rgb_8_inter).
+        */
+        template <Storage::type storage_T>
+        class TileCache
+        {
+
+                /* ****************************************
+                 * public interface
+                 * **************************************** */
+
+            public:
+                /**
+                * @brief The type of the internal storage info object (describing a single tile).
+                */
+                typedef MemStorageInfo<storage_T> storage_info_t;
+
+            public:
+                /**
+                * @brief The channel storage type (e.g., uint8_t).
+                */
+                typedef typename storage_info_t::channel_storage_t channel_storage_t;
+
+            public:
+                /**
+                * @brief Tile index denoting 'no tile'.
+                */
+                static const size_t no_tile = static_cast<size_t>(-1);
+
+            public:
+                /**
+                * @brief Slot index denoting a pin that is not held by a thread slot.
+                */
+                static const size_t no_slot = static_cast<size_t>(-1);
+
+            public:
+                /**
+                * @brief Constructor.
+                * @param[in] provider    The tile provider.
+                * @param[in] width       The image width.
+                * @param[in] height      The image height.
+                * @param[in] tile_width  The tile width.
+                * @param[in] tile_height The tile height.
+                * @param[in] max_bytes   The memory budget (in bytes). At least one
+                *                        tile is always cached.
+                */
+                TileCache(ITileProvider& provider, coord_t width, coord_t height,
+                          coord_t tile_width, coord_t tile_height, size_t max_bytes);
+
+            public:
+                /**
+                * @brief Destructor.
+                */
+                ~TileCache();
+
+            public:
+                /**
+                * @brief Get the image width.
+                * @return The width.
+                */
+                coord_t width() const;
+
+            public:
+                /**
+                * @brief Get the image height.
+                * @return The height.
+                */
+                coord_t height() const;
+
+            public:
+                /**
+                * @brief Get the tile width.
+                * @return The width.
+                */
+                coord_t tile_width() const;
+
+            public:
+                /**
+                * @brief Get the tile height.
+                * @return The height.
+                */
+                coord_t tile_height() const;
+
+            public:
+                /**
+                * @brief Access the storage info object describing the layout of a tile.
+                * @return The storage info.
+                */
+                const storage_info_t& tile_storage_info() const;
+
+            public:
+                /**
+                * @brief Determine the index of the tile containing the given pixel.
+                * @param[in] x The x coordinate (must be inside the image).
+                * @param[in] y The y coordinate (must be inside the image).
+                * @return The tile index.
+                */
+                size_t tile_index(coord_t x, coord_t y) const;
+
+            public:
+                /**
+                * @brief Pin a tile, loading it if necessary.
+                * @details A pinned tile stays in memory until it is released by
+                * @ref unpin_tile(), which must be called from the same thread.
+                * @param[in]  tile_idx The index of the tile to pin.
+                * @param[out] slot     The thread slot holding the pin (or @ref no_slot),
+                *                      to be passed to @ref unpin_tile().
+                * @return Pointer to the tile data.
+                */
+                const channel_storage_t* pin_tile(size_t tile_idx, size_t& slot);
+
+            public:
+                /**
+                * @brief Release a pinned tile.
+                * @param[in] tile_idx The tile index.
+                * @param[in] slot     The thread slot returned by @ref pin_tile().
+                */
+                void unpin_tile(size_t tile_idx, size_t slot);
+
+            public:
+                /**
+                * @brief Read a single value from a tile, loading it if necessary.
+                * @param[in] tile_idx The tile index.
+                * @param[in] offs     The offset inside the tile (in multiples of
+                *                     the channel storage unit).
+                * @return The value.
+                */
+                channel_storage_t get_val(size_t tile_idx, size_t offs);
+
+            public:
+                /**
+                * @brief Get the number of tiles that were requested from the provider so far.
+                * @return The number of tile loads.
+                */
+                size_t tile_loads() const;
+
+                /* ****************************************
+                 * internals
+                 * **************************************** */
+
+            private:
+                /**
+                * @brief Bookkeeping information for a single tile.
+                */
+                struct TileEntry
+                {
+                    /**
+                    * @brief The tile data (0 if the tile is not loaded).
+                    */
+                    channel_storage_t* data;
+
+                    /**
+                    * @brief Whether the tile is currently being loaded (by the thread
+                    * that requested it first).
+                    */
+                    bool loading;
+
+                    /**
+                    * @brief The number of active pins (thread slots holding the tile
+                    * count as a single pin).
+                    */
+                    size_t pin_count;
+
+                    /**
+                    * @brief The position in the LRU list.
+                    */
+                    std::list<size_t>::iterator lru_pos;
+                };
+
+            private:
+                /**
+                * @brief The number of tiles each thread keeps pinned.
+                * @details This is enough for the neighbourhood of an interpolated
+                * position to span a tile corner.
+                */
+                static const size_t slot_tiles_ = 4;
+
+            private:
+                /**
+                * @brief The tiles pinned by a single thread.
+                * @details Only the owning thread accesses its slot, so it needs no
+                * locking. Each tile held here counts as one pin in the cache.
+                */
+                struct ThreadSlot
+                {
+                    /**
+                    * @brief The indices of the held tiles (or @ref no_tile).
+                    */
+                    size_t tile_idx[slot_tiles_];
+
+                    /**
+                    * @brief The data of the held tiles.
+                    */
+                    const channel_storage_t* data[slot_tiles_];
+
+                    /**
+                    * @brief The number of pins the thread holds on each tile.
+                    */
+                    size_t pin_count[slot_tiles_];
+
+                    /**
+                    * @brief The position to re-use next.
+                    */
+                    size_t next;
+
+                    /**
+                    * @brief Padding (keeps the slots of different threads out of the
+                    * same cache line).
+                    */
+                    char padding[64];
+                };
+
+            private:
+                /**
+                * @brief Copy constructor (disabled).
+                */
+                TileCache(const TileCache<storage_T>& orig);
+
+            private:
+                /**
+                * @brief Assignment operator (disabled).
+                */
+                TileCache<storage_T>& operator=(const TileCache<storage_T>& orig);
+
+            private:
+                /**
+                * @brief Get the slot of the calling thread.
+                * @return The slot index, or @ref no_slot if the thread has none
+                * (e.g., inside nested parallel regions).
+                */
+                size_t thread_slot() const;
+
+            private:
+                /**
+                * @brief Pin a tile in the cache, loading it if necessary, and mark it
+                * as most recently used.
+                * @details The tile is loaded outside of the critical section. If the
+                * provider throws, the tile is left unloaded and the exception is passed on.
+                * @param[in] tile_idx  The index of the tile to pin.
+                * @param[in] unpin_idx The index of a tile to release at the same
+                *                      time (or @ref no_tile).
+                * @return Pointer to the tile data.
+                */
+                channel_storage_t* fetch_tile(size_t tile_idx, size_t unpin_idx);
+
+            private:
+                /**
+                * @brief Request a tile from the provider.
+                * @details Calls to the provider are serialised (the provider need
+                * not be thread-safe), but do not block other cache operations.
+                * @param[in]  tile_idx The tile index.
+                * @param[out] buffer   The tile buffer.
+                */
+                void load_tile(size_t tile_idx, channel_storage_t* buffer);
+
+            private:
+                /**
+                * @brief Evict the least recently used tile that is not pinned.
+                * @note Must be called from inside the critical section.
+                * @note If every cached tile is pinned, nothing can be evicted and
+                * fetch_tile() allocates an additional buffer, i.e. the memory budget
+                * is exceeded. The overshoot is bounded by the tiles held in the thread
+                * slots (@ref slot_tiles_ per thread) plus the number of live iterators.
+                * @return The buffer of the evicted tile (0 if all tiles are pinned).
+                */
+                channel_storage_t* evict_tile();
+
+            private:
+                /**
+                * @brief The tile provider.
+                */
+                ITileProvider& provider_;
+
+            private:
+                /**
+                * @brief The image width.
+                */
+                const coord_t width_;
+
+            private:
+                /**
+                * @brief The image height.
+                */
+                const coord_t height_;
+
+            private:
+                /**
+                * @brief The tile width.
+                */
+                const coord_t tile_width_;
+
+            private:
+                /**
+                * @brief The tile height.
+                */
+                const coord_t tile_height_;
+
+            private:
+                /**
+                * @brief The number of tiles in horizontal direction.
+                */
+                const size_t num_tiles_x_;
+
+            private:
+                /**
+                * @brief The number of tiles in vertical direction.
+                */
+                const size_t num_tiles_y_;
+
+            private:
+                /**
+                * @brief Storage info describing the layout of a single tile.
+                */
+                const storage_info_t tile_storage_info_;
+
+            private:
+                /**
+                * @brief The size of a tile buffer (in multiples of the channel storage unit).
+                */
+                const size_t tile_size_;
+
+            private:
+                /**
+                * @brief The maximal number of tiles to hold in memory.
+                */
+                const size_t max_tiles_;
+
+            private:
+                /**
+                * @brief The number of allocated tile buffers.
+                */
+                size_t num_buffers_;
+
+            private:
+                /**
+                * @brief The number of tiles requested from the provider.
+                */
+                size_t tile_loads_;
+
+            private:
+                /**
+                * @brief The tile entries (row by row).
+                */
+                std::vector<TileEntry> tiles_;
+
+            private:
+                /**
+                * @brief Indices of all loaded tiles, most recently used first.
+                */
+                std::list<size_t> lru_;
+
+            private:
+                /**
+                * @brief The thread slots (indexed by OpenMP thread number).
+                */
+                std::vector<ThreadSlot> slots_;
+
+#ifdef HAVE_OPENMP
+            private:
+                /**
+                * @brief Lock serialising the calls to the provider.
+                */
+                omp_lock_t provider_lock_;
+#endif
+
+        }; // template class TileCache<>
+
+        ///@endcond
+
+    } // namespace phtr::mem
+
+} // namespace phtr
+
+#include <photoropter/mem/tile_cache.tpl.h>
+
+#endif // PHTR_TILE_CACHE_H__
@@ -0,0 +1,430 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <cassert>
+
+namespace phtr
+{
+
+    namespace mem
+    {
+
+        ///@cond PROTECTED
+
+        template <Storage::type storage_T>
+        const size_t TileCache<storage_T>::no_tile;
+
+        template <Storage::type storage_T>
+        const size_t TileCache<storage_T>::no_slot;
+
+        template <Storage::type storage_T>
+        const size_t TileCache<storage_T>::slot_tiles_;
+
+        template <Storage::type storage_T>
+        TileCache<storage_T>::TileCache
+        (ITileProvider& provider, coord_t width, coord_t height,
+         coord_t tile_width, coord_t tile_height, size_t max_bytes)
+                : provider_(provider),
+                width_(width),
+                height_(height),
+                tile_width_(tile_width),
+                tile_height_(tile_height),
+                num_tiles_x_((width + tile_width - 1) / tile_width),
+                num_tiles_y_((height + tile_height - 1) / tile_height),
+                tile_storage_info_(tile_width, tile_height),
+                tile_size_(tile_storage_info_.num_channels * tile_width * tile_height),
+                max_tiles_(max_bytes / (tile_size_ * sizeof(channel_storage_t)) > 0 ?
+                           max_bytes / (tile_size_ * sizeof(channel_storage_t)) : 1),
+                num_buffers_(0),
+                tile_loads_(0)
+        {
+            assert(tile_width > 0 && tile_height > 0);
+
+            TileEntry empty_entry;
+            empty_entry.data = 0;
+            empty_entry.loading = false;
+            empty_entry.pin_count = 0;
+
+            tiles_.resize(num_tiles_x_ * num_tiles_y_, empty_entry);
+
+            ThreadSlot empty_slot;
+            for (size_t i = 0; i < slot_tiles_; ++i)
+            {
+                empty_slot.tile_idx[i] = no_tile;
+                empty_slot.data[i] = 0;
+                empty_slot.pin_count[i] = 0;
+            }
+            empty_slot.next = 0;
+
+#ifdef HAVE_OPENMP
+            slots_.resize(static_cast<size_t>(omp_get_max_threads()), empty_slot);
+            omp_init_lock(&provider_lock_);
+#else
+            slots_.resize(1, empty_slot);
+#endif
+        }
+
+        template <Storage::type storage_T>
+        TileCache<storage_T>::~TileCache
+        ()
+        {
+            for (size_t i = 0; i < tiles_.size(); ++i)
+            {
+                delete[] tiles_[i].data;
+            }
+
+#ifdef HAVE_OPENMP
+            omp_destroy_lock(&provider_lock_);
+#endif
+        }
+
+        template <Storage::type storage_T>
+        coord_t
+        TileCache<storage_T>::width
+        () const
+        {
+            return width_;
+        }
+
+        template <Storage::type storage_T>
+        coord_t
+        TileCache<storage_T>::height
+        () const
+        {
+            return height_;
+        }
+
+        template <Storage::type storage_T>
+        coord_t
+        TileCache<storage_T>::tile_width
+        () const
+        {
+            return tile_width_;
+        }
+
+        template <Storage::type storage_T>
+        coord_t
+        TileCache<storage_T>::tile_height
+        () const
+        {
+            return tile_height_;
+        }
+
+        template <Storage::type storage_T>
+        const typename TileCache<storage_T>::storage_info_t&
+        TileCache<storage_T>::tile_storage_info
+        () const
+        {
+            return tile_storage_info_;
+        }
+
+        template <Storage::type storage_T>
+        size_t
+        TileCache<storage_T>::tile_index
+        (coord_t x, coord_t y) const
+        {
+            return (y / tile_height_) * num_tiles_x_ + (x / tile_width_);
+        }
+
+        template <Storage::type storage_T>
+        const typename TileCache<storage_T>::channel_storage_t*
+        TileCache<storage_T>::pin_tile
+        (size_t tile_idx, size_t& slot)
+        {
+            slot = thread_slot();
+            if (slot == no_slot)
+            {
+                return fetch_tile(tile_idx, no_tile);
+            }
+
+            ThreadSlot& thread_tiles = slots_[slot];
+
+            // tiles held by the thread can be pinned without locking
+            for (size_t i = 0; i < slot_tiles_; ++i)
+            {
+                if (thread_tiles.tile_idx[i] == tile_idx)
+                {
+                    ++thread_tiles.pin_count[i];
+                    return thread_tiles.data[i];
+                }
+            }
+
+            // replace a held tile that is not in use
+            for (size_t k = 0; k < slot_tiles_; ++k)
+            {
+                size_t i = (thread_tiles.next + k) % slot_tiles_;
+                if (thread_tiles.pin_count[i] == 0)
+                {
+                    size_t unpin_idx = thread_tiles.tile_idx[i];
+                    thread_tiles.tile_idx[i] = no_tile;
+                    thread_tiles.data[i] = fetch_tile(tile_idx, unpin_idx);
+                    thread_tiles.tile_idx[i] = tile_idx;
+                    thread_tiles.pin_count[i] = 1;
+                    thread_tiles.next = (i + 1) % slot_tiles_;
+                    return thread_tiles.data[i];
+                }
+            }
+
+            // all held tiles are in use
+            slot = no_slot;
+            return fetch_tile(tile_idx, no_tile);
+        }
+
+        template <Storage::type storage_T>
+        void
+        TileCache<storage_T>::unpin_tile
+        (size_t tile_idx, size_t slot)
+        {
+            if (slot != no_slot)
+            {
+                assert(slot == thread_slot());
+
+                ThreadSlot& thread_tiles = slots_[slot];
+                size_t i(0);
+                while (thread_tiles.tile_idx[i] != tile_idx)
+                {
+                    ++i;
+                    assert(i < slot_tiles_);
+                }
+
+                // (the tile stays pinned by the slot)
+                --thread_tiles.pin_count[i];
+                return;
+            }
+
+#ifdef HAVE_OPENMP
+#pragma omp critical (phtr_tile_cache)
+#endif
+            {
+                --tiles_[tile_idx].pin_count;
+            }
+        }
+
+        template <Storage::type storage_T>
+        typename TileCache<storage_T>::channel_storage_t
+        TileCache<storage_T>::get_val
+        (size_t tile_idx, size_t offs)
+        {
+            size_t slot(no_slot);
+            channel_storage_t val = pin_tile(tile_idx, slot)[offs];
+            unpin_tile(tile_idx, slot);
+
+            return val;
+        }
+
+        template <Storage::type storage_T>
+        size_t
+        TileCache<storage_T>::tile_loads
+        () const
+        {
+            return tile_loads_;
+        }
+
+        template <Storage::type storage_T>
+        size_t
+        TileCache<storage_T>::thread_slot
+        () const
+        {
+#ifdef HAVE_OPENMP
+#ifdef OPENMP3
+            // thread numbers are only unique inside the outermost team
+            if (omp_get_level() > 1)
+            {
+                return no_slot;
+            }
+#endif
+            size_t thread_num = static_cast<size_t>(omp_get_thread_num());
+            return (thread_num < slots_.size()) ? thread_num : no_slot;
+#else
+            return 0;
+#endif
+        }
+
+        template <Storage::type storage_T>
+        typename TileCache<storage_T>::channel_storage_t*
+        TileCache<storage_T>::fetch_tile
+        (size_t tile_idx, size_t unpin_idx)
+        {
+            TileEntry& entry = tiles_[tile_idx];
+            channel_storage_t* buffer(0);
+
+            for (;;)
+            {
+                channel_storage_t* data(0);
+                bool load(false);
+
+#ifdef HAVE_OPENMP
+#pragma omp critical (phtr_tile_cache)
+#endif
+                {
+                    if (unpin_idx != no_tile)
+                    {
+                        --tiles_[unpin_idx].pin_count;
+                        unpin_idx = no_tile;
+                    }
+
+                    if (entry.data != 0)
+                    {
+                        // move to front of the LRU list
+                        lru_.splice(lru_.begin(), lru_, entry.lru_pos);
+                        ++entry.pin_count;
+                        data = entry.data;
+                    }
+                    else if (!entry.loading)
+                    {
+                        // re-use the buffer of an evicted tile if the budget is exhausted
+                        if (num_buffers_ >= max_tiles_)
+                        {
+                            buffer = evict_tile();
+                        }
+
+                        // (if all tiles are pinned, the budget is exceeded, cf. evict_tile())
+                        if (buffer == 0)
+                        {
+                            ++num_buffers_;
+                        }
+
+                        entry.loading = true;
+                        ++entry.pin_count;
+                        load = true;
+                    }
+                }
+
+                if (data != 0)
+                {
+                    return data;
+                }
+
+                if (load)
+                {
+                    break;
+                }
+
+                // another thread is loading the tile; wait for the provider
+#ifdef HAVE_OPENMP
+                omp_set_lock(&provider_lock_);
+                omp_unset_lock(&provider_lock_);
+#endif
+            }
+
+            // load the tile outside of the critical section
+            try
+            {
+                if (buffer == 0)
+                {
+                    buffer = new channel_storage_t[tile_size_];
+                }
+
+                load_tile(tile_idx, buffer);
+            }
+            catch (...)
+            {
+                delete[] buffer;
+
+#ifdef HAVE_OPENMP
+#pragma omp critical (phtr_tile_cache)
+#endif
+                {
+                    entry.loading = false;
+                    --entry.pin_count;
+                    --num_buffers_;
+                }
+
+                throw;
+            }
+
+#ifdef HAVE_OPENMP
+#pragma omp critical (phtr_tile_cache)
+#endif
+            {
+                entry.data = buffer;
+                entry.loading = false;
+                lru_.push_front(tile_idx);
+                entry.lru_pos = lru_.begin();
+                ++tile_loads_;
+            }
+
+            return buffer;
+        }
+
+        template <Storage::type storage_T>
+        void
+        TileCache<storage_T>::load_tile
+        (size_t tile_idx, channel_storage_t* buffer)
+        {
+            coord_t x = (tile_idx % num_tiles_x_) * tile_width_;
+            coord_t y = (tile_idx / num_tiles_x_) * tile_height_;
+            coord_t w = (x + tile_width_ > width_) ? width_ - x : tile_width_;
+            coord_t h = (y + tile_height_ > height_) ? height_ - y : tile_height_;
+
+#ifdef HAVE_OPENMP
+            // (a lock instead of a critical section, since the provider may throw)
+            omp_set_lock(&provider_lock_);
+            try
+            {
+                provider_.load_tile(x, y, w, h, buffer, tile_width_, tile_height_);
+            }
+            catch (...)
+            {
+                omp_unset_lock(&provider_lock_);
+                throw;
+            }
+            omp_unset_lock(&provider_lock_);
+#else
+            provider_.load_tile(x, y, w, h, buffer, tile_width_, tile_height_);
+#endif
+        }
+
+        template <Storage::type storage_T>
+        typename TileCache<storage_T>::channel_storage_t*
+        TileCache<storage_T>::evict_tile
+        ()
+        {
+            std::list<size_t>::iterator it(lru_.end());
+
+            while (it != lru_.begin())
+            {
+                --it;
+                TileEntry& entry = tiles_[*it];
+
+                if (entry.pin_count == 0)
+                {
+                    channel_storage_t* buffer = entry.data;
+                    entry.data = 0;
+                    lru_.erase(it);
+                    return buffer;
+                }
+            }
+
+            return 0;
+        }
+
+        ///@endcond
+
+    } // namespace phtr::mem
+
+} // namespace phtr
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <photoropter/mem/storage_type.h>
 #include <photoropter/mem/channel_range.h>
 #include <photoropter/mem/mem_layout.h>
+#include <photoropter/mem/channel_offsets.h>
 
 namespace phtr
 {
@@ -39,10 +40,12 @@ namespace phtr
     /**
     * @brief Base class template for iterator classes. Not supposed to be used directly.
     * See @ref MemImageIterR and @ref MemImageIterW for details.
+    * @details The pixel step and channel offsets are provided by @ref mem::ChannelOffsets,
+    * i.e. they are compile-time constants for interleaved layouts.
     * @param T The storage type (e.g. @ref mem::Storage::rgb_8_inter).
     */
     template <mem::Storage::type T>
-    class MemImageIterBase
+    class MemImageIterBase : protected mem::ChannelOffsets<T>
     {
 
             /* ****************************************
@@ -134,41 +137,13 @@ namespace phtr
             */
             const mem::Storage::type storage_type_;
 
-        protected:
-            /**
-            * @brief The step between adjacent pixels.
-            */
-            const size_t step_;
-
         protected:
             /**
             * @brief The step between lines.
             */
             const size_t line_step_;
 
-        protected:
-            /**
-            * @brief The offset of the 'red' channel.
-            */
-            const size_t r_offs_;
-
-        protected:
-            /**
-            * @brief The offset of the 'green' channel.
-            */
-            const size_t g_offs_;
-
-        protected:
-            /**
-            * @brief The offset of the 'blue' channel.
-            */
-            const size_t b_offs_;
 
-        protected:
-            /**
-            * @brief The offset of the 'alpha' channel.
-            */
-            const size_t a_offs_;
 
     }; // template class MemImageIterBase<>
 
@@ -34,15 +34,11 @@ namespace phtr
     (channel_storage_t* base_addr, size_t px_offs,
      size_t step, size_t line_step,
      size_t r_offs, size_t g_offs, size_t b_offs, size_t a_offs)
-            : base_addr_(base_addr),
+            : mem::ChannelOffsets<T>(step, r_offs, g_offs, b_offs, a_offs),
+            base_addr_(base_addr),
             px_offs_(px_offs),
             storage_type_(T),
-            step_(step),
-            line_step_(line_step),
-            r_offs_(r_offs),
-            g_offs_(g_offs),
-            b_offs_(b_offs),
-            a_offs_(a_offs)
+            line_step_(line_step)
     {
         //NIL
     }
@@ -52,7 +48,7 @@ namespace phtr
     MemImageIterBase<T>::inc_x
     ()
     {
-        px_offs_ += step_;
+        px_offs_ += this->step();
     }
 
     template <mem::Storage::type T>
@@ -60,7 +56,7 @@ namespace phtr
     MemImageIterBase<T>::dec_x
     ()
     {
-        px_offs_ -= step_;
+        px_offs_ -= this->step();
     }
 
     template <mem::Storage::type T>
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #ifndef PHTR_MEM_IMAGE_ITER_R_H__
 #define PHTR_MEM_IMAGE_ITER_R_H__
 
+#include <photoropter/mem/colour_tuple.h>
 #include <photoropter/mem_image_iter_base.h>
 #include <photoropter/mem/channel_type.h>
 
@@ -84,6 +85,31 @@ namespace phtr
             */
             inline channel_storage_t get_px_val(Channel::type channel);
 
+        public:
+            /**
+            * @brief Read all channel values of the current pixel.
+            * @details For interleaved layouts, the channel offsets are compile-time
+            * constants, so this reads the pixel as a whole.
+            * @param[out] values The values.
+            */
+            template <typename colour_tuple_T>
+            inline void get_px_vals(colour_tuple_T& values);
+
+        public:
+            /**
+            * @brief Read a span of pixels (starting at the current position) into
+            * a structure-of-arrays buffer.
+            * @details The values of the channel at position i of the channel order
+            * are stored at <tt>planes[i * plane_size]</tt> to
+            * <tt>planes[i * plane_size + num - 1]</tt>. The iterator position
+            * is not changed.
+            * @param[in]  num        The number of pixels.
+            * @param[out] planes     The destination buffer (e.g., of type float or double).
+            * @param[in]  plane_size The distance between the channel planes (at least num).
+            */
+            template <typename value_T>
+            inline void read_span(coord_t num, value_T* planes, size_t plane_size);
+
     }; // template class MemImageIterR<>
 
     ///@endcond
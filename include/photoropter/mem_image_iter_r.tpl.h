@@ -43,24 +43,41 @@ namespace phtr
     typename MemImageIterR<storage_T>::channel_storage_t
     MemImageIterR<storage_T>::get_px_val(Channel::type channel)
     {
-        switch (channel)
+        return this->base_addr_[this->px_offs_ + this->offs(channel)];
+    }
+
+    template <mem::Storage::type storage_T> template <typename colour_tuple_T>
+    void
+    MemImageIterR<storage_T>::get_px_vals
+    (colour_tuple_T& values)
+    {
+        const channel_storage_t* px_addr = this->base_addr_ + this->px_offs_;
+
+        for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
+        {
+            values.value[i] = static_cast<interp_channel_t>(px_addr[this->tuple_offs(i)]);
+        }
+    }
+
+    template <mem::Storage::type storage_T> template <typename value_T>
+    void
+    MemImageIterR<storage_T>::read_span
+    (coord_t num, value_T* planes, size_t plane_size)
+    {
+        typedef typename MemImageIterR::mem_layout_t::colour_tuple_t colour_tuple_t;
+
+        const channel_storage_t* px_addr = this->base_addr_ + this->px_offs_;
+        const size_t step = this->step();
+
+        for (size_t i = 0; i < colour_tuple_t::num_vals; ++i)
         {
-            case Channel::red:
-            default:
-                return this->base_addr_[this->px_offs_ + this->r_offs_];
-                break;
-
-            case Channel::green:
-                return this->base_addr_[this->px_offs_ + this->g_offs_];
-                break;
-
-            case Channel::blue:
-                return this->base_addr_[this->px_offs_ + this->b_offs_];
-                break;
-
-            case Channel::alpha:
-                return this->base_addr_[this->px_offs_ + this->a_offs_];
-                break;
+            const channel_storage_t* src = px_addr + this->tuple_offs(i);
+            value_T* dst = planes + i * plane_size;
+
+            for (coord_t k = 0; k < num; ++k)
+            {
+                dst[k] = static_cast<value_T>(src[k * step]);
+            }
         }
     }
 
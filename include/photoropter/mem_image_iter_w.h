@@ -87,12 +87,37 @@ namespace phtr
 
         public:
             /**
-            * @brief Write the given channel value to the current pixel.
+            * @brief Write all channel values of the current pixel.
+            * @details For interleaved layouts, the channel offsets are compile-time
+            * constants, so this writes the pixel as a whole.
             * @param[in] values The values.
             */
             template <typename colour_tuple_T>
             inline void write_px_vals(const colour_tuple_T& values);
 
+        public:
+            /**
+            * @brief Write a span of pixels (starting at the current position).
+            * @details The values are rounded and clamped to the channel range. The
+            * iterator position is not changed.
+            * @param[in] values The colour tuples.
+            * @param[in] num    The number of pixels.
+            */
+            template <typename colour_tuple_T>
+            inline void write_span(const colour_tuple_T* values, coord_t num);
+
+        public:
+            /**
+            * @brief Write a span of pixels (starting at the current position) given
+            * as final channel codes.
+            * @details The codes are stored pixel by pixel, in the channel order of the
+            * given colour tuple type. The iterator position is not changed.
+            * @param[in] codes The channel codes.
+            * @param[in] num   The number of pixels.
+            */
+            template <typename colour_tuple_T>
+            inline void write_codes(const channel_storage_t* codes, coord_t num);
+
     }; // template class MemImageIterW<>
 
     ///@endcond
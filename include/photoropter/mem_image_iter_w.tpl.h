@@ -43,25 +43,7 @@ namespace phtr
     MemImageIterW<storage_T>::write_px_val
     (Channel::type chan, channel_storage_t val)
     {
-        switch (chan)
-        {
-            case Channel::red:
-            default:
-                this->base_addr_[this->px_offs_ + this->r_offs_] = val;
-                break;
-
-            case Channel::green:
-                this->base_addr_[this->px_offs_ + this->g_offs_] = val;
-                break;
-
-            case Channel::blue:
-                this->base_addr_[this->px_offs_ + this->b_offs_] = val;
-                break;
-
-            case Channel::alpha:
-                this->base_addr_[this->px_offs_ + this->a_offs_] = val;
-                break;
-        }
+        this->base_addr_[this->px_offs_ + this->offs(chan)] = val;
     }
 
     template <mem::Storage::type storage_T> template <typename colour_tuple_T>
@@ -69,10 +51,54 @@ namespace phtr
     MemImageIterW<storage_T>::write_px_vals
     (const colour_tuple_T& values)
     {
+        channel_storage_t* px_addr = this->base_addr_ + this->px_offs_;
+
+        for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
+        {
+            px_addr[this->tuple_offs(i)] = static_cast<channel_storage_t>(values.value[i] + 0.5);
+        }
+    }
+
+    template <mem::Storage::type storage_T> template <typename colour_tuple_T>
+    void
+    MemImageIterW<storage_T>::write_span
+    (const colour_tuple_T* values, coord_t num)
+    {
+        const interp_channel_t min_val = static_cast<interp_channel_t>(mem::ChannelRange<storage_T>::min());
+        const interp_channel_t max_val = static_cast<interp_channel_t>(mem::ChannelRange<storage_T>::max());
+
+        channel_storage_t* px_addr = this->base_addr_ + this->px_offs_;
+        const size_t step = this->step();
+
         for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
         {
-            write_px_val(colour_tuple_T::channel_order_t::channel_type[i],
-                         static_cast<channel_storage_t>(values.value[i] + 0.5));
+            channel_storage_t* dst = px_addr + this->tuple_offs(i);
+
+            for (coord_t k = 0; k < num; ++k)
+            {
+                interp_channel_t val = values[k].value[i];
+                val = (val < min_val) ? min_val : ((val > max_val) ? max_val : val);
+                dst[k * step] = static_cast<channel_storage_t>(val + 0.5);
+            }
+        }
+    }
+
+    template <mem::Storage::type storage_T> template <typename colour_tuple_T>
+    void
+    MemImageIterW<storage_T>::write_codes
+    (const channel_storage_t* codes, coord_t num)
+    {
+        const size_t num_vals = colour_tuple_T::num_vals;
+
+        channel_storage_t* px_addr = this->base_addr_ + this->px_offs_;
+        const size_t step = this->step();
+
+        for (coord_t k = 0; k < num; ++k)
+        {
+            for (size_t i = 0; i < num_vals; ++i)
+            {
+                px_addr[k * step + this->tuple_offs(i)] = codes[k * num_vals + i];
+            }
         }
     }
 
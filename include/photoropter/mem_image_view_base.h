@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include <photoropter/mem/storage_type.h>
 #include <photoropter/mem/mem_storage_info.h>
+#include <photoropter/mem/channel_offsets.h>
 
 /**
 * @brief Main namespace of the Photoropter library.
@@ -39,10 +40,12 @@ namespace phtr
     /**
     * @brief Base class template for image views. See @ref MemImageViewR and
     * @ref MemImageViewW for details.
+    * @details The pixel step and channel offsets are provided by @ref mem::ChannelOffsets,
+    * i.e. they are compile-time constants for interleaved layouts.
     * @param T The storage type (e.g. @ref mem::Storage::rgb_8_inter).
     */
     template <mem::Storage::type T>
-    class MemImageViewBase
+    class MemImageViewBase : protected mem::ChannelOffsets<T>
     {
 
             /* ****************************************
@@ -100,6 +103,20 @@ namespace phtr
                              coord_t width,
                              coord_t height);
 
+        protected:
+            /**
+            * @brief Constructor for images with padded lines.
+            * @param[in] base_addr The base address of the image data in memory.
+            * @param[in] width The image width.
+            * @param[in] height The image height.
+            * @param[in] line_step The distance between two adjacent lines, in multiples
+            * of the channel storage unit (at least the unpadded line size).
+            */
+            MemImageViewBase(void* base_addr,
+                             coord_t width,
+                             coord_t height,
+                             size_t line_step);
+
         protected:
             /**
             * @brief The storage type of the image.
@@ -143,13 +160,6 @@ namespace phtr
             */
             const channel_storage_t max_chan_val_;
 
-        protected:
-            /**
-            * @brief The distance between two adjacent pixels, in multiples
-            * of the channel storage unit.
-            */
-            const size_t step_;
-
         protected:
             /**
             * @brief The distance between two adjacent lines, in multiples
@@ -157,29 +167,8 @@ namespace phtr
             */
             const size_t line_step_;
 
-        protected:
-            /**
-            * @brief The offset of the red channel to the current memory position.
-            */
-            const size_t r_offs_;
 
-        protected:
-            /**
-            * @brief The offset of the green channel to the current memory position.
-            */
-            const size_t g_offs_;
 
-        protected:
-            /**
-            * @brief The offset of the blue channel to the current memory position.
-            */
-            const size_t b_offs_;
-
-        protected:
-            /**
-            * @brief The offset of the alpha channel to the current memory position.
-            */
-            const size_t a_offs_;
             ///@endcond
 
     }; // template class MemImageViewBase<>
@@ -24,6 +24,8 @@ THE SOFTWARE.
 
 */
 
+#include <cassert>
+
 namespace phtr
 {
 
@@ -32,23 +34,36 @@ namespace phtr
     template <mem::Storage::type T>
     MemImageViewBase<T>::MemImageViewBase
     (void* base_addr, coord_t width, coord_t height)
-            : storage_type_(T),
+            : mem::ChannelOffsets<T>(storage_info_t(width, height)),
+            storage_type_(T),
             storage_info_(width, height),
             base_addr_(static_cast<MemImageViewBase::channel_storage_t*>(base_addr)),
             width_(width),
             height_(height),
             min_chan_val_(storage_info_.min_val),
             max_chan_val_(storage_info_.max_val),
-            step_(storage_info_.step),
-            line_step_(storage_info_.line_step),
-            r_offs_(storage_info_.r_offs),
-            g_offs_(storage_info_.g_offs),
-            b_offs_(storage_info_.b_offs),
-            a_offs_(storage_info_.a_offs)
+            line_step_(storage_info_.line_step)
     {
         //NIL
     }
 
+    template <mem::Storage::type T>
+    MemImageViewBase<T>::MemImageViewBase
+    (void* base_addr, coord_t width, coord_t height, size_t line_step)
+            : mem::ChannelOffsets<T>(storage_info_t(width, height)),
+            storage_type_(T),
+            storage_info_(width, height),
+            base_addr_(static_cast<MemImageViewBase::channel_storage_t*>(base_addr)),
+            width_(width),
+            height_(height),
+            min_chan_val_(storage_info_.min_val),
+            max_chan_val_(storage_info_.max_val),
+            line_step_(line_step)
+    {
+        // (the plane offsets of planar layouts do not take padding into account)
+        assert(line_step_ >= storage_info_.line_step);
+    }
+
     template <mem::Storage::type T>
     coord_t
     MemImageViewBase<T>::width
@@ -70,7 +85,7 @@ namespace phtr
     MemImageViewBase<T>::get_px_offs
     (coord_t x, coord_t y) const
     {
-        return ((y * width_) + x) * step_;
+        return (y * line_step_) + (x * this->step());
     }
 
     ///@endcond
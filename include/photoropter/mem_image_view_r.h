@@ -78,6 +78,22 @@ namespace phtr
                           coord_t width,
                           coord_t height);
 
+        public:
+            /**
+            * @brief Constructor for images with padded lines (e.g., buffers owned by an
+            * image decoder).
+            * @param[in] base_addr The base address of the image data in memory.
+            * @param[in] width The image width.
+            * @param[in] height The image height.
+            * @param[in] line_step The distance between two adjacent lines, in multiples
+            * of the channel storage unit.
+            * @note Only interleaved layouts support padded lines.
+            */
+            MemImageViewR(const void* base_addr,
+                          coord_t width,
+                          coord_t height,
+                          size_t line_step);
+
         public:
             /**
             * @brief Read the given channel value.
@@ -89,6 +105,29 @@ namespace phtr
             inline channel_storage_t
             get_px_val(Channel::type chan, coord_t x, coord_t y) const;
 
+        public:
+            /**
+            * @brief Read all channel values of the given pixel.
+            * @param[in]  x      The x coordinate.
+            * @param[in]  y      The y coordinate.
+            * @param[out] values The channel values.
+            */
+            template <typename colour_tuple_T>
+            inline void get_px_vals(coord_t x, coord_t y, colour_tuple_T& values) const;
+
+        public:
+            /**
+            * @brief Read a span of pixels of one line into a structure-of-arrays buffer.
+            * @details See @ref MemImageIterR::read_span() for the buffer layout.
+            * @param[in]  x          The x coordinate of the first pixel.
+            * @param[in]  y          The y coordinate.
+            * @param[in]  num        The number of pixels.
+            * @param[out] planes     The destination buffer (e.g., of type float or double).
+            * @param[in]  plane_size The distance between the channel planes (at least num).
+            */
+            template <typename value_T>
+            void read_span(coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const;
+
         public:
             /**
             * @brief Get a pixel iterator.
@@ -114,6 +153,17 @@ namespace phtr
             */
             interp_coord_t aspect_ratio() const;
 
+        public:
+            /**
+            * @brief Attach the view to another image buffer.
+            * @details The buffer has to have the same size and storage type as the
+            * original one. Since interpolators and transformations only hold a reference
+            * to the view, an already configured transformation can be reused
+            * for a sequence of images this way.
+            * @param[in] base_addr The base address of the image data in memory.
+            */
+            void set_base_addr(const void* base_addr);
+
             /* ****************************************
              * internals
              * **************************************** */
@@ -37,41 +37,57 @@ namespace phtr
                         static_cast<interp_coord_t>(this->height());
     }
 
+    template <mem::Storage::type storage_T>
+    MemImageViewR<storage_T>::
+    MemImageViewR
+    (const void* base_addr, coord_t width, coord_t height, size_t line_step)
+            : MemImageViewBase<storage_T>(const_cast<void*>(base_addr), width, height, line_step)
+    {
+        aspect_ratio_ = static_cast<interp_coord_t>(this->width()) /
+                        static_cast<interp_coord_t>(this->height());
+    }
+
     template <mem::Storage::type storage_T>
     typename MemImageViewR<storage_T>::channel_storage_t
     MemImageViewR<storage_T>::
     get_px_val
     (Channel::type chan, coord_t x, coord_t y) const
     {
-        switch (chan)
+        return this->base_addr_[this->get_px_offs(x, y) + this->offs(chan)];
+    }
+
+    template <mem::Storage::type storage_T> template <typename colour_tuple_T>
+    void
+    MemImageViewR<storage_T>::
+    get_px_vals
+    (coord_t x, coord_t y, colour_tuple_T& values) const
+    {
+        const channel_storage_t* px_addr = this->base_addr_ + this->get_px_offs(x, y);
+
+        for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
         {
-            case Channel::red:
-            default:
-                return this->base_addr_[this->get_px_offs(x, y) + this->r_offs_];
-                break;
-
-            case Channel::green:
-                return this->base_addr_[this->get_px_offs(x, y) + this->g_offs_];
-                break;
-
-            case Channel::blue:
-                return this->base_addr_[this->get_px_offs(x, y) + this->b_offs_];
-                break;
-
-            case Channel::alpha:
-                return this->base_addr_[this->get_px_offs(x, y) + this->a_offs_];
-                break;
+            values.value[i] = static_cast<interp_channel_t>(px_addr[this->tuple_offs(i)]);
         }
     }
 
+    template <mem::Storage::type storage_T> template <typename value_T>
+    void
+    MemImageViewR<storage_T>::
+    read_span
+    (coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const
+    {
+        get_iter(x, y).read_span(num, planes, plane_size);
+    }
+
     template <mem::Storage::type storage_T>
     typename MemImageViewR<storage_T>::iter_t
     MemImageViewR<storage_T>::
     get_iter
     (coord_t x, coord_t y) const
     {
-        return MemImageIterR<storage_T>(this->base_addr_, this->get_px_offs(x, y), this->step_, this->line_step_,
-                                        this->r_offs_, this->g_offs_, this->b_offs_, this->a_offs_);
+        return MemImageIterR<storage_T>(this->base_addr_, this->get_px_offs(x, y), this->step(), this->line_step_,
+                                        this->offs(Channel::red), this->offs(Channel::green),
+                                        this->offs(Channel::blue), this->offs(Channel::alpha));
     }
 
     template <mem::Storage::type storage_T>
@@ -88,4 +104,11 @@ namespace phtr
         return aspect_ratio_;
     }
 
+    template <mem::Storage::type storage_T>
+    void
+    MemImageViewR<storage_T>::set_base_addr(const void* base_addr)
+    {
+        this->base_addr_ = static_cast<channel_storage_t*>(const_cast<void*>(base_addr));
+    }
+
 } // namespace phtr
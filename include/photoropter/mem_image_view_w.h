@@ -81,6 +81,22 @@ namespace phtr
                           coord_t width,
                           coord_t height);
 
+        public:
+            /**
+            * @brief Constructor for images with padded lines (e.g., buffers owned by an
+            * image encoder).
+            * @param[in] base_addr The base address of the image data in memory.
+            * @param[in] width The image width.
+            * @param[in] height The image height.
+            * @param[in] line_step The distance between two adjacent lines, in multiples
+            * of the channel storage unit.
+            * @note Only interleaved layouts support padded lines.
+            */
+            MemImageViewW(void* base_addr,
+                          coord_t width,
+                          coord_t height,
+                          size_t line_step);
+
         public:
             /**
             * @brief Write the given channel value.
@@ -101,6 +117,18 @@ namespace phtr
             inline void write_px_vals(const coord_tuple_T& coords,
                                       const typename coord_tuple_T::channel_order_t::colour_tuple_t& values);
 
+        public:
+            /**
+            * @brief Write a span of pixels of one line.
+            * @details The values are rounded and clamped to the channel range.
+            * @param[in] x      The x coordinate of the first pixel.
+            * @param[in] y      The y coordinate.
+            * @param[in] values The colour tuples.
+            * @param[in] num    The number of pixels.
+            */
+            template <typename colour_tuple_T>
+            void write_span(coord_t x, coord_t y, const colour_tuple_T* values, coord_t num);
+
         public:
             /**
             * @brief Get a pixel iterator.
@@ -170,6 +198,16 @@ namespace phtr
             void get_parent_window(coord_t& offs_x, coord_t& offs_y,
                                    coord_t& width, coord_t& height);
 
+        public:
+            /**
+            * @brief Attach the view to another image buffer.
+            * @details The buffer has to have the same size and storage type as the
+            * original one (cf. @ref MemImageViewR::set_base_addr()). ROI and parent
+            * window settings are kept.
+            * @param[in] base_addr The base address of the image data in memory.
+            */
+            void set_base_addr(void* base_addr);
+
             /* ****************************************
              * internals
              * **************************************** */
@@ -44,31 +44,30 @@ namespace phtr
         //NIL
     }
 
+    template <mem::Storage::type storage_T>
+    MemImageViewW<storage_T>::
+    MemImageViewW
+    (void* base_addr, coord_t width, coord_t height, size_t line_step)
+            : MemImageViewBase<storage_T>(base_addr, width, height, line_step),
+            roi_x_min_(0),
+            roi_x_limit_(width),
+            roi_y_min_(0),
+            roi_y_limit_(height),
+            parent_offs_x_(0),
+            parent_offs_y_(0),
+            parent_width_(width),
+            parent_height_(height)
+    {
+        //NIL
+    }
+
     template <mem::Storage::type storage_T>
     void
     MemImageViewW<storage_T>::
     write_px_val
     (Channel::type chan, coord_t x, coord_t y, channel_storage_t val)
     {
-        switch (chan)
-        {
-            case Channel::red:
-            default:
-                this->base_addr_[this->get_px_offs(x, y) + this->r_offs_] = val;
-                break;
-
-            case Channel::green:
-                this->base_addr_[this->get_px_offs(x, y) + this->g_offs_] = val;
-                break;
-
-            case Channel::blue:
-                this->base_addr_[this->get_px_offs(x, y) + this->b_offs_] = val;
-                break;
-
-            case Channel::alpha:
-                this->base_addr_[this->get_px_offs(x, y) + this->a_offs_] = val;
-                break;
-        }
+        this->base_addr_[this->get_px_offs(x, y) + this->offs(chan)] = val;
     }
 
     template <mem::Storage::type storage_T> template <typename coord_tuple_T>
@@ -88,14 +87,24 @@ namespace phtr
 
     }
 
+    template <mem::Storage::type storage_T> template <typename colour_tuple_T>
+    void
+    MemImageViewW<storage_T>::
+    write_span
+    (coord_t x, coord_t y, const colour_tuple_T* values, coord_t num)
+    {
+        get_iter(x, y).write_span(values, num);
+    }
+
     template <mem::Storage::type storage_T>
     typename MemImageViewW<storage_T>::iter_t
     MemImageViewW<storage_T>::
     get_iter
     (coord_t x, coord_t y)
     {
-        return MemImageIterW<storage_T>(this->base_addr_, this->get_px_offs(x, y), this->step_, this->line_step_,
-                                        this->r_offs_, this->g_offs_, this->b_offs_, this->a_offs_);
+        return MemImageIterW<storage_T>(this->base_addr_, this->get_px_offs(x, y), this->step(), this->line_step_,
+                                        this->offs(Channel::red), this->offs(Channel::green),
+                                        this->offs(Channel::blue), this->offs(Channel::alpha));
     }
 
     template <mem::Storage::type storage_T>
@@ -146,4 +155,12 @@ namespace phtr
         height = parent_height_;
     }
 
+    template <mem::Storage::type storage_T>
+    void
+    MemImageViewW<storage_T>::
+    set_base_addr(void* base_addr)
+    {
+        this->base_addr_ = static_cast<channel_storage_t*>(base_addr);
+    }
+
 } // namespace phtr
@@ -27,6 +27,9 @@ THE SOFTWARE.
 #ifndef PHTR_COLOUR_CORRECTION_MODEL_H__
 #define PHTR_COLOUR_CORRECTION_MODEL_H__
 
+#include <cstddef>
+
+#include <photoropter/types.h>
 #include <photoropter/mem/coord_tuple.h>
 #include <photoropter/mem/colour_tuple.h>
 #include <photoropter/model/correction_model_base.h>
@@ -68,6 +71,36 @@ namespace phtr
                 virtual void get_correction_factors(const mem::CoordTupleRGBA& coords,
                                                     mem::ColourTupleRGBA& factors) const = 0;
 
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details The positions are @f$ (x + k\,dx, y) @f$ for @f$ k = 0 \ldots num-1 @f$,
+                * with all channels sharing the same coordinates (i.e., without geometric
+                * correction). This allows the %model to update its state incrementally
+                * along the row. The default implementation calls get_correction_factors()
+                * for every position.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                virtual void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                        size_t num, mem::ColourTupleRGB* factors) const;
+
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details See above; the alpha channel is left unchanged.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                virtual void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                        size_t num, mem::ColourTupleRGBA* factors) const;
+
             public:
                 /**
                 * @brief Create a clone of the correction model functionoid.
@@ -75,6 +108,23 @@ namespace phtr
                 */
                 virtual IColourCorrectionModel* clone() const = 0;
 
+                /* ****************************************
+                 * internals
+                 * **************************************** */
+
+            private:
+                /**
+                * @brief Default implementation of mult_correction_factors_row().
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                template <typename colour_tuple_T>
+                void mult_correction_factors_row_generic(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                        size_t num, colour_tuple_T* factors) const;
+
         }; // class IColourCorrectionModel
 
     } // namespace phtr::model
@@ -0,0 +1,304 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_FLAT_FIELD_COLOUR_MODEL_H__
+#define PHTR_FLAT_FIELD_COLOUR_MODEL_H__
+
+#include <cstddef>
+#include <vector>
+
+#include <photoropter/types.h>
+#include <photoropter/mem/channel_type.h>
+#include <photoropter/model/correction_model_base.h>
+#include <photoropter/model/colour_correction_model.h>
+
+namespace phtr
+{
+
+    namespace model
+    {
+
+        /**
+        * @brief Colour correction model applying a measured gain map.
+        * @details The per-channel gains are stored on a regular grid of nodes covering the
+        * whole image (the outermost nodes lie on the image borders), and interpolated
+        * bilinearly in between. Such a map is usually obtained from a flat-field calibration
+        * shot: the gain at a node is the ratio of the reference brightness to the
+        * (linear) brightness measured around the node. Unlike @ref VignettingColourModel,
+        * this can represent falloff that is not radially symmetric.
+        * The grid covers the image the gains were measured on. If the input image uses
+        * a different aspect ratio or crop factor, its coordinates are converted like for
+        * the other models (see CorrectionModelBase); parts of the input image outside the
+        * measured area use the gains of the nearest border node. The image orientation
+        * is not changed, i.e. the grid is not rotated for portrait images.
+        * @note A coarse grid (e.g. 32x24 nodes) is usually sufficient and small enough to
+        * stay in the CPU cache; a full-resolution gain image is not necessary.
+        */
+        class FlatFieldColourModel : protected CorrectionModelBase, public IColourCorrectionModel
+        {
+
+                /* ****************************************
+                * public interface
+                * **************************************** */
+
+            public:
+                /**
+                * @brief Constructor.
+                * @details In this variant, the complete information describing both the coordinate system
+                * of the gain measurement and the coordinate system of the input image are used.
+                * The grid is initialised with 2x2 nodes, all gains being 1.0.
+                * @param[in] param_aspect The aspect ratio of the image the gains were measured on.
+                * @param[in] input_aspect The aspect ratio of the input image.
+                * @param[in] param_crop The crop factor of the image the gains were measured on.
+                * @param[in] input_crop The crop factor of the input image.
+                */
+                FlatFieldColourModel(double param_aspect, double input_aspect,
+                                     double param_crop, double input_crop);
+
+                /**
+                * @brief Constructor.
+                * @details The gains are assumed to have been measured on an image of the same
+                * aspect ratio (and orientation) and crop factor as the input image.
+                * The grid is initialised with 2x2 nodes, all gains being 1.0.
+                * @param[in] input_aspect The aspect ratio of the input image.
+                */
+                explicit FlatFieldColourModel(double input_aspect);
+
+            public:
+                /**
+                * @brief Set the size of the gain grid.
+                * @details All gains are reset to 1.0.
+                * @param[in] grid_width The number of nodes in horizontal direction (at least 2).
+                * @param[in] grid_height The number of nodes in vertical direction (at least 2).
+                */
+                void set_grid_size(size_t grid_width, size_t grid_height);
+
+            public:
+                /**
+                * @brief Get the size of the gain grid.
+                * @param[out] grid_width The number of nodes in horizontal direction.
+                * @param[out] grid_height The number of nodes in vertical direction.
+                */
+                void get_grid_size(size_t& grid_width, size_t& grid_height) const;
+
+            public:
+                /**
+                * @brief Set the gain of one channel at a grid node.
+                * @param[in] chan The channel (red, green or blue).
+                * @param[in] gx The horizontal node index.
+                * @param[in] gy The vertical node index.
+                * @param[in] gain The gain.
+                */
+                void set_gain(Channel::type chan, size_t gx, size_t gy, double gain);
+
+            public:
+                /**
+                * @brief Get the gain of one channel at a grid node.
+                * @param[in] chan The channel (red, green or blue).
+                * @param[in] gx The horizontal node index.
+                * @param[in] gy The vertical node index.
+                * @return The gain.
+                */
+                double get_gain(Channel::type chan, size_t gx, size_t gy) const;
+
+            public:
+                /**
+                * @brief Set the gains of one channel for the whole grid.
+                * @param[in] chan The channel (red, green or blue).
+                * @param[in] gains Array of grid_width * grid_height gains, stored line by line
+                * (starting at the top left node).
+                */
+                void set_gains(Channel::type chan, const double* gains);
+
+            public:
+                /**
+                * @brief Get the correction factors for a given position.
+                * @param[in] coords The coordinates in the source image.
+                * @param[out] factors The correction factors.
+                */
+                void get_correction_factors(const mem::CoordTupleRGB& coords,
+                                            mem::ColourTupleRGB& factors) const;
+
+            public:
+                /**
+                * @brief Get the correction factors for a given position.
+                * @param[in] coords The coordinates in the source image.
+                * @param[out] factors The correction factors.
+                */
+                void get_correction_factors(const mem::CoordTupleRGBA& coords,
+                                            mem::ColourTupleRGBA& factors) const;
+
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details The two grid lines enclosing the row are interpolated once per grid
+                * cell, so only the horizontal interpolation is performed per pixel.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                                 size_t num, mem::ColourTupleRGB* factors) const;
+
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details See above; the alpha channel is left unchanged.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                                 size_t num, mem::ColourTupleRGBA* factors) const;
+
+            public:
+                /**
+                * @brief Create a clone of the correction model functionoid.
+                * @return The clone.
+                */
+                IColourCorrectionModel* clone() const;
+
+                /* ****************************************
+                * internals
+                * **************************************** */
+
+                ///@cond PROTECTED
+            protected:
+                /**
+                * @brief Calculate the coordinate system compensation factor and the grid scaling.
+                */
+                virtual void calc_coord_fact();
+
+            protected:
+                /**
+                * @brief Calculate the factors and offsets converting coordinates to grid units.
+                */
+                void calc_grid_scale();
+
+            protected:
+                /**
+                * @brief Get the correction factors for a given position (implementation).
+                * @param[in] coords The coordinates in the source image.
+                * @param[out] factors The correction factors.
+                */
+                template <typename coord_tuple_T>
+                inline void get_correction_factors_impl(const coord_tuple_T& coords,
+                                                        typename coord_tuple_T::channel_order_t::colour_tuple_t& factors) const;
+
+            protected:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array (implementation).
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                template <typename colour_tuple_T>
+                inline void mult_correction_factors_row_impl(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                        size_t num, colour_tuple_T* factors) const;
+
+            protected:
+                /**
+                * @brief Get the interpolated gain of one channel at a given position.
+                * @param[in] chan_idx The channel index within the grid (0: red, 1: green, 2: blue).
+                * @param[in] x The horizontal position.
+                * @param[in] y The vertical position.
+                * @return The gain.
+                */
+                inline double get_gain_at(size_t chan_idx, interp_coord_t x, interp_coord_t y) const;
+
+            protected:
+                /**
+                * @brief Convert a coordinate to a grid cell index and the position within the cell.
+                * @param[in] pos The position in grid units.
+                * @param[in] num The number of nodes.
+                * @param[out] frac The position within the cell (0..1).
+                * @return The index of the left/upper node of the cell.
+                */
+                static inline size_t get_cell(double pos, size_t num, double& frac);
+
+            protected:
+                /**
+                * @brief The number of gain channels (red, green and blue).
+                */
+                static const size_t num_gain_chans_ = 3;
+
+            protected:
+                /**
+                * @brief The number of nodes in horizontal direction.
+                */
+                size_t grid_width_;
+
+            protected:
+                /**
+                * @brief The number of nodes in vertical direction.
+                */
+                size_t grid_height_;
+
+            protected:
+                /**
+                * @brief Factor to convert horizontal coordinates to grid units.
+                */
+                double scale_x_;
+
+            protected:
+                /**
+                * @brief Factor to convert vertical coordinates to grid units.
+                */
+                double scale_y_;
+
+            protected:
+                /**
+                * @brief Horizontal grid position of the image centre.
+                */
+                double offs_x_;
+
+            protected:
+                /**
+                * @brief Vertical grid position of the image centre.
+                */
+                double offs_y_;
+
+            protected:
+                /**
+                * @brief The gains (all channels of a node stored together, nodes line by line).
+                */
+                std::vector<double> gains_;
+                ///@endcond
+
+        }; // class FlatFieldColourModel
+
+    } // namespace phtr::model
+
+} // namespace phtr
+
+#endif // PHTR_FLAT_FIELD_COLOUR_MODEL_H__
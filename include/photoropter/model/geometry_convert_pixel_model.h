@@ -28,10 +28,13 @@ THE SOFTWARE.
 #define PHTR_GEOMETRY_CONVERT_PIXEL_MODEL_H__
 
 #include <cmath>
+#include <cstddef>
 
 #include <photoropter/model/pixel_correction_model.h>
 #include <photoropter/model/subpixel_correction_model.h>
 #include <photoropter/model/correction_model_base.h>
+#include <photoropter/model/radial_model.h>
+#include <photoropter/radial_table.h>
 #include <photoropter/geometry_type.h>
 #include <photoropter/geom/rectilinear.h>
 #include <photoropter/geom/fisheye_equidist.h>
@@ -48,7 +51,7 @@ namespace phtr
         /**
          * @brief Interface class for the geometry conversion %model class template.
          */
-        class IGeometryConvertPixelModel : public IPixelCorrectionModel
+        class IGeometryConvertPixelModel : public IPixelCorrectionModel, public IRadialModel
         {
             public:
                 /**
@@ -64,6 +67,20 @@ namespace phtr
                 * @param[in] dst_focal_length The destination focal length.
                 */
                 virtual void set_focal_lengths(double src_focal_length, double dst_focal_length) = 0;
+
+            public:
+                /**
+                * @brief Enable or disable the radial lookup table.
+                * @param[in] enable Use the lookup table if @c true.
+                */
+                virtual void enable_radial_lut(bool enable) = 0;
+
+            public:
+                /**
+                * @brief Set the number of intervals in the radial lookup table.
+                * @param[in] num The number of intervals.
+                */
+                virtual void set_radial_lut_precision(size_t num) = 0;
         };
 
         /**
@@ -100,6 +117,29 @@ namespace phtr
                 */
                 void set_focal_lengths(double src_focal_length, double dst_focal_length);
 
+            public:
+                /**
+                * @brief Enable or disable the radial lookup table.
+                * @details All supported geometries are radially symmetric, so the conversion
+                * only scales the distance from the centre. With the lookup table enabled,
+                * the scaling factor is precalculated over the squared radius and applied
+                * to the (x, y) vector directly, which avoids all trigonometric functions.
+                * Outside the valid part of the table the exact calculation is used.
+                * The table is disabled by default.
+                * @param[in] enable Use the lookup table if @c true.
+                */
+                void enable_radial_lut(bool enable);
+
+            public:
+                /**
+                * @brief Set the number of intervals in the radial lookup table.
+                * @details The table covers squared radii up to @f$ 4(1 + a^2) @f$
+                * (where @f$ a @f$ is the input aspect ratio), i.e. up to the full image
+                * diagonal (twice the centre-to-corner distance). The default is 4096.
+                * @param[in] num The number of intervals (minimum: 2).
+                */
+                void set_radial_lut_precision(size_t num);
+
             public:
                 /**
                 * @brief Set the centre shift (all channels).
@@ -122,6 +162,25 @@ namespace phtr
                 */
                 void get_centre_shift(interp_coord_t& x0, interp_coord_t& y0) const;
 
+            public:
+                /**
+                * @brief Get the centre of the %model.
+                * @param[in] chan_idx The channel index (ignored).
+                * @param[out] x0 The horizontal centre position.
+                * @param[out] y0 The vertical centre position.
+                */
+                void get_radial_centre(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const;
+
+            public:
+                /**
+                * @brief Calculate the source radius for a given destination radius.
+                * @param[in] chan_idx The channel index (ignored).
+                * @param[in] r The destination radius.
+                * @param[out] r_src The source radius.
+                * @return @c false if the point cannot be converted.
+                */
+                bool get_src_radius(size_t chan_idx, double r, double& r_src) const;
+
             public:
                 /**
                 * @brief Get the corrected source image coordinates for the current position.
@@ -147,6 +206,51 @@ namespace phtr
                 */
                 virtual void calc_coord_fact();
 
+            private:
+                /**
+                * @brief Convert the (centred) coordinates using the exact geometry functions.
+                * @param[in,out] x The x coordinate (scaled by @ref coord_fact_).
+                * @param[in,out] y The y coordinate (scaled by @ref coord_fact_).
+                * @return @c false if the point cannot be converted.
+                */
+                bool convert_exact(double& x, double& y) const;
+
+            private:
+                /**
+                * @brief Recalculate the radial lookup table (if enabled).
+                */
+                void update_radial_lut();
+
+            private:
+                /**
+                * @brief The ratio @f$ r_{src} / r_{dst} @f$ as a function of the squared
+                * (normalised) destination radius (tabulated by the radial lookup table).
+                */
+                class RadiusRatio : public RadialTable::IFunction
+                {
+                    public:
+                        /**
+                        * @brief Constructor.
+                        * @param[in] model  The conversion model.
+                        * @param[in] r2_max The squared radius covered by the table; the
+                        *                   evaluation fails for source radii beyond.
+                        */
+                        RadiusRatio(const GeometryConvertPixelModel& model, double r2_max);
+
+                    public:
+                        /**
+                        * @brief Evaluate the ratio.
+                        * @param[in]  r2    The squared destination radius.
+                        * @param[out] ratio The ratio.
+                        * @return @c false if the conversion fails or leaves the covered area.
+                        */
+                        bool eval(double r2, double& ratio) const;
+
+                    private:
+                        const GeometryConvertPixelModel& model_;
+                        const double r2_max_;
+                };
+
             private:
                 /**
                 * @brief The parameter 'x0'.
@@ -169,6 +273,29 @@ namespace phtr
                  */
                 dst_model_T dst_geom_;
 
+            private:
+                /**
+                * @brief Flag to enable the radial lookup table.
+                */
+                bool use_radial_lut_;
+
+            private:
+                /**
+                * @brief The number of intervals in the radial lookup table.
+                */
+                size_t radial_lut_num_;
+
+            private:
+                /**
+                * @brief The radial lookup table.
+                * @details Holds the ratio @f$ r_{src} / r_{dst} @f$ over the squared
+                * (normalised) destination radius. It is only valid up to the first
+                * radius where the conversion fails or the source radius leaves the area
+                * covered by the table (which happens e.g. close to the singularity of a
+                * rectilinear projection).
+                */
+                RadialTable radial_lut_;
+
         }; // class GeometryConvertPixelModel
 
         /**
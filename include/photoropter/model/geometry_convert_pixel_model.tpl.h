@@ -39,7 +39,9 @@ namespace phtr
         template <typename src_model_T, typename dst_model_T>
         GeometryConvertPixelModel<src_model_T, dst_model_T>::
         GeometryConvertPixelModel(double input_aspect, double input_crop)
-                : CorrectionModelBase(1.5, input_aspect, 1.0, input_crop)
+                : CorrectionModelBase(1.5, input_aspect, 1.0, input_crop),
+                use_radial_lut_(false),
+                radial_lut_num_(4096)
         {
             x0_ = 0.0;
             y0_ = 0.0;
@@ -53,6 +55,25 @@ namespace phtr
         {
             src_geom_.set_focal_length(src_focal_length);
             dst_geom_.set_focal_length(dst_focal_length);
+            update_radial_lut();
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        void
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        enable_radial_lut(bool enable)
+        {
+            use_radial_lut_ = enable;
+            update_radial_lut();
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        void
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        set_radial_lut_precision(size_t num)
+        {
+            radial_lut_num_ = (num < 2) ? 2 : num;
+            update_radial_lut();
         }
 
         template <typename src_model_T, typename dst_model_T>
@@ -73,23 +94,52 @@ namespace phtr
             y0 = y0_;
         }
 
+        template <typename src_model_T, typename dst_model_T>
+        void
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        get_radial_centre(size_t, interp_coord_t& x0, interp_coord_t& y0) const
+        {
+            x0 = x0_;
+            y0 = y0_;
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        bool
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        get_src_radius(size_t, double r, double& r_src) const
+        {
+            double x = r * coord_fact_;
+            double y = 0.0;
+
+            if (!convert_exact(x, y))
+            {
+                return false;
+            }
+
+            r_src = x / coord_fact_;
+            return true;
+        }
+
         template <typename src_model_T, typename dst_model_T>
         void
         GeometryConvertPixelModel<src_model_T, dst_model_T>::
         get_src_coords(mem::CoordTupleMono& coords) const
         {
-            typedef mem::CoordTupleMono::channel_order_t channel_order_t;
-            typedef channel_order_t::colour_tuple_t colour_tuple_t;
+            double dx = coords.x[0] - x0_;
+            double dy = coords.y[0] - y0_;
 
-            double x = (coords.x[0] - x0_) * coord_fact_;
-            double y = (coords.y[0] - y0_) * coord_fact_;
-            double phi(0.0);
-            double theta(0.0);
+            double ratio(0.0);
+            if (use_radial_lut_ && radial_lut_.lookup(dx * dx + dy * dy, ratio))
+            {
+                coords.x[0] = dx * ratio + x0_;
+                coords.y[0] = dy * ratio + y0_;
+                return;
+            }
 
-            bool success = dst_geom_.to_spherical_coords(x, y, phi, theta)
-                           && src_geom_.to_cartesian_coords(phi, theta, x, y);
+            double x = dx * coord_fact_;
+            double y = dy * coord_fact_;
 
-            if (success)
+            if (convert_exact(x, y))
             {
                 coords.x[0] = (x / coord_fact_) + x0_;
                 coords.y[0] = (y / coord_fact_) + y0_;
@@ -121,6 +171,64 @@ namespace phtr
             // 24mm/2 == 12mm
             // (== half the height of a 35mm full-frame image)
             coord_fact_ *= 12;
+
+            update_radial_lut();
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        bool
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        convert_exact(double& x, double& y) const
+        {
+            double phi(0.0);
+            double theta(0.0);
+
+            return dst_geom_.to_spherical_coords(x, y, phi, theta)
+                   && src_geom_.to_cartesian_coords(phi, theta, x, y);
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        void
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::
+        update_radial_lut()
+        {
+            if (!use_radial_lut_)
+            {
+                radial_lut_.clear();
+                return;
+            }
+
+            // squared radius covered by the table: the square of the full image diagonal
+            const double r_max = RadialTable::max_radius(input_aspect_);
+            const double r2_max = r_max * r_max;
+
+            radial_lut_.build(RadiusRatio(*this, r2_max), radial_lut_num_, r2_max, true);
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::RadiusRatio::
+        RadiusRatio(const GeometryConvertPixelModel& model, double r2_max)
+                : model_(model),
+                r2_max_(r2_max)
+        {
+            //NIL
+        }
+
+        template <typename src_model_T, typename dst_model_T>
+        bool
+        GeometryConvertPixelModel<src_model_T, dst_model_T>::RadiusRatio::
+        eval(double r2, double& ratio) const
+        {
+            double r = std::sqrt(r2);
+            double r_src(0.0);
+
+            if (!model_.get_src_radius(0, r, r_src) || (r_src * r_src > r2_max_))
+            {
+                return false;
+            }
+
+            ratio = r_src / r;
+            return true;
         }
 
         template <typename src_geom_T>
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <photoropter/model/subpixel_correction_model.h>
 #include <photoropter/model/pixel_correction_model.h>
 #include <photoropter/model/correction_model_base.h>
+#include <photoropter/model/radial_model.h>
 
 namespace phtr
 {
@@ -58,7 +59,8 @@ namespace phtr
         class PTLensPixelModel
                     : private CorrectionModelBase,
                     public ISubpixelCorrectionModel,
-                    public IPixelCorrectionModel
+                    public IPixelCorrectionModel,
+                    public IRadialModel
         {
 
                 /* ****************************************
@@ -200,6 +202,25 @@ namespace phtr
                 */
                 void get_centre_shift(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const;
 
+            public:
+                /**
+                * @brief Get the centre of the %model.
+                * @param[in] chan_idx The channel index.
+                * @param[out] x0 The horizontal centre position.
+                * @param[out] y0 The vertical centre position.
+                */
+                void get_radial_centre(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const;
+
+            public:
+                /**
+                * @brief Calculate the source radius for a given destination radius.
+                * @param[in] chan_idx The channel index.
+                * @param[in] r The destination radius.
+                * @param[out] r_src The source radius.
+                * @return Always @c true.
+                */
+                bool get_src_radius(size_t chan_idx, double r, double& r_src) const;
+
             public:
                 /**
                 * @brief Get the corrected source image coordinates for the current position.
@@ -0,0 +1,84 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_RADIAL_MODEL_H__
+#define PHTR_RADIAL_MODEL_H__
+
+#include <cstddef>
+
+#include <photoropter/types.h>
+
+namespace phtr
+{
+
+    namespace model
+    {
+
+        /**
+        * @brief Interface class for radially symmetric geometrical models.
+        * @details A radial %model moves every point along the line through its centre,
+        * i.e. it can be described completely by a 1D function mapping the destination
+        * radius to the source radius. The correction queues use this information to
+        * replace a chain of radial models by a single lookup table
+        * (see PixelCorrectionQueue::enable_radial_collapse()).
+        */
+        class IRadialModel
+        {
+
+            public:
+                /**
+                 * @ brief (Dummy) Destructor.
+                 */
+                virtual ~IRadialModel() {};
+
+            public:
+                /**
+                * @brief Get the centre of the %model.
+                * @param[in] chan_idx The channel index.
+                * @param[out] x0 The horizontal centre position.
+                * @param[out] y0 The vertical centre position.
+                */
+                virtual void get_radial_centre(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const = 0;
+
+            public:
+                /**
+                * @brief Calculate the source radius for a given destination radius.
+                * @details A negative result means that the point is mirrored at the centre.
+                * @param[in] chan_idx The channel index.
+                * @param[in] r The destination radius (&gt; 0).
+                * @param[out] r_src The source radius.
+                * @return @c false if the point cannot be transformed.
+                */
+                virtual bool get_src_radius(size_t chan_idx, double r, double& r_src) const = 0;
+
+        }; // class IRadialModel
+
+    } // namespace phtr::model
+
+} // namespace phtr
+
+#endif // PHTR_RADIAL_MODEL_H__
@@ -27,7 +27,10 @@ THE SOFTWARE.
 #ifndef PHTR_VIGNETTING_COLOUR_MODEL_H__
 #define PHTR_VIGNETTING_COLOUR_MODEL_H__
 
+#include <cstddef>
+
 #include <photoropter/types.h>
+#include <photoropter/radial_table.h>
 #include <photoropter/mem/channel_type.h>
 #include <photoropter/model/colour_correction_model.h>
 #include <photoropter/model/correction_model_base.h>
@@ -142,6 +145,56 @@ namespace phtr
                 void get_correction_factors(const mem::CoordTupleRGBA& coords,
                                             mem::ColourTupleRGBA& factors) const;
 
+            public:
+                /**
+                * @brief Enable or disable the radial lookup table.
+                * @details The correction factor only depends on the squared radius, so it can be
+                * precalculated (as reciprocal) over @f$ r^2 @f$. All channels share the same table,
+                * and channels with identical coordinates (i.e., without TCA correction) are only
+                * looked up once. Outside the table the exact formula is used.
+                * The table is disabled by default.
+                * @note On CPUs with fast floating point division, the direct evaluation is
+                * usually just as fast; the table mainly pays off where division is expensive.
+                * @param[in] enable Use the lookup table if @c true.
+                */
+                void enable_radial_lut(bool enable);
+
+            public:
+                /**
+                * @brief Set the number of intervals in the radial lookup table.
+                * @details The table covers squared radii up to @f$ 4(1 + a^2) @f$
+                * (where @f$ a @f$ is the input aspect ratio), i.e. up to the full image
+                * diagonal (twice the centre-to-corner distance). The default is 4096.
+                * @param[in] num The number of intervals (minimum: 2).
+                */
+                void set_radial_lut_precision(size_t num);
+
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details r^2 is updated incrementally along the row.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                                 size_t num, mem::ColourTupleRGB* factors) const;
+
+            public:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array.
+                * @details r^2 is updated incrementally along the row; the alpha channel is left unchanged.
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                void mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                                 size_t num, mem::ColourTupleRGBA* factors) const;
+
             public:
                 /**
                 * @brief Create a clone of the correction model functionoid.
@@ -164,6 +217,64 @@ namespace phtr
                 inline void get_correction_factors_impl(const coord_tuple_T& coords,
                                                         typename coord_tuple_T::channel_order_t::colour_tuple_t& factors) const;
 
+            protected:
+                /**
+                * @brief Multiply the correction factors for a row of positions into an array (implementation).
+                * @param[in] x The horizontal position of the first pixel.
+                * @param[in] dx The horizontal step.
+                * @param[in] y The vertical position.
+                * @param[in] num The number of positions.
+                * @param[in,out] factors Array of @c num factor tuples.
+                */
+                template <typename colour_tuple_T>
+                inline void mult_correction_factors_row_impl(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                        size_t num, colour_tuple_T* factors) const;
+
+            protected:
+                /**
+                * @brief Get the correction factor for a given squared radius.
+                * @param[in] r2 The squared radius.
+                * @return The correction factor.
+                */
+                inline double get_factor(double r2) const;
+
+            protected:
+                /**
+                * @brief Recalculate the radial lookup table (if enabled).
+                */
+                void update_radial_lut();
+
+            protected:
+                /**
+                * @brief The correction factor as a function of the squared radius
+                * (tabulated by the radial lookup table).
+                */
+                class Factor : public RadialTable::IFunction
+                {
+                    public:
+                        /**
+                        * @brief Constructor.
+                        * @param[in] a The parameter 'a' (scaled).
+                        * @param[in] b The parameter 'b' (scaled).
+                        * @param[in] c The parameter 'c' (scaled).
+                        */
+                        Factor(double a, double b, double c);
+
+                    public:
+                        /**
+                        * @brief Evaluate the correction factor.
+                        * @param[in]  r2   The squared radius.
+                        * @param[out] fact The factor.
+                        * @return @c false at or beyond the first pole of the model.
+                        */
+                        bool eval(double r2, double& fact) const;
+
+                    private:
+                        const double a_;
+                        const double b_;
+                        const double c_;
+                };
+
             protected:
                 /**
                 * @brief The parameter 'a'.
@@ -193,6 +304,24 @@ namespace phtr
                 * @brief The parameter 'y0' (vertical centre shift).
                 */
                 double y0_;
+
+            protected:
+                /**
+                * @brief Flag to enable the radial lookup table.
+                */
+                bool use_radial_lut_;
+
+            protected:
+                /**
+                * @brief The number of intervals in the radial lookup table.
+                */
+                size_t radial_lut_num_;
+
+            protected:
+                /**
+                * @brief The radial lookup table (correction factors over r^2).
+                */
+                RadialTable radial_lut_;
                 ///@endcond
 
         }; // class VignettingColourModel
@@ -31,11 +31,14 @@ namespace phtr
     PixelCorrectionQueue::
     get_src_coords(interp_coord_t dst_x, interp_coord_t dst_y, mem::CoordTupleMono& coords) const
     {
-        typedef mem::CoordTupleMono::channel_order_t::colour_tuple_t colour_tuple_t;
-
         coords.x[0] = dst_x;
         coords.y[0] = dst_y;
 
+        if (radial_collapsed_ && radial_collapse_.get_src_coords(coords.x[0], coords.y[0]))
+        {
+            return;
+        }
+
         for (size_t i = 0; i < n_models_; ++i)
         {
             correction_model_[i]->get_src_coords(coords);
@@ -0,0 +1,253 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_RADIAL_COLLAPSE_H__
+#define PHTR_RADIAL_COLLAPSE_H__
+
+#include <cstddef>
+#include <vector>
+
+#include <photoropter/types.h>
+#include <photoropter/radial_table.h>
+#include <photoropter/model/radial_model.h>
+
+namespace phtr
+{
+
+    ///@cond PROTECTED
+
+    /**
+    * @brief Tabulated replacement for a chain of radial models.
+    * @details If all models in a correction queue are radially symmetric about the same
+    * centre, the whole chain is a 1D function of the radius. This class samples the
+    * ratio of source and destination radius over the destination radius and applies
+    * it by scaling the vector from the centre. The table resolution is doubled
+    * until the interpolation error stays within the configured bound; if this is not
+    * possible, the table is only used up to the first interval exceeding the bound.
+    * Beyond the valid part of the table, lookups fail and the caller has to evaluate
+    * the models directly.
+    */
+    class RadialCollapse
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief The container type for %model chains.
+            */
+            typedef std::vector<const model::IRadialModel*> chain_t;
+
+        public:
+            /**
+            * @brief Standard constructor.
+            */
+            RadialCollapse();
+
+        public:
+            /**
+            * @brief Set the table parameters.
+            * @param[in] num The initial number of table intervals.
+            * @param[in] max_err The maximum interpolation error (in normalised coordinates).
+            */
+            void set_params(size_t num, double max_err);
+
+        public:
+            /**
+            * @brief Analyse a %model chain and build the table.
+            * @details The table is only rebuilt if the chain differs from the one of the
+            * last update. This is detected by a fingerprint of the chain: the %model
+            * centres and the source radius sampled at fixed positions. So changes of %model
+            * parameters are found without any notification (assuming smooth models, which
+            * cannot change between the sample positions only).
+            * @param[in] chain The %model chain (in the order of application).
+            * @param[in] chan_idx The channel index.
+            * @param[in] r_max The maximum destination radius covered by the table.
+            * @return @c true if the chain could be collapsed.
+            */
+            bool update(const chain_t& chain, size_t chan_idx, double r_max);
+
+        public:
+            /**
+            * @brief Discard the table (the next update() rebuilds it).
+            */
+            void reset();
+
+        public:
+            /**
+            * @brief Check if the table can be used.
+            * @return @c true if the last call to update() succeeded.
+            */
+            inline bool valid() const;
+
+        public:
+            /**
+            * @brief Get the source coordinates for the given position.
+            * @param[in,out] x The horizontal position.
+            * @param[in,out] y The vertical position.
+            * @return @c false if the position lies outside the valid part of the table
+            * (the coordinates are unchanged in that case).
+            */
+            inline bool get_src_coords(interp_coord_t& x, interp_coord_t& y) const;
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief The ratio of source and destination radius for a %model chain, as a
+            * function of the destination radius.
+            */
+            class ChainRatio : public RadialTable::IFunction
+            {
+                public:
+                    /**
+                    * @brief Constructor.
+                    * @param[in] chain    The %model chain.
+                    * @param[in] chan_idx The channel index.
+                    * @param[in] r_max    The evaluation fails for source radii beyond this value.
+                    */
+                    ChainRatio(const chain_t& chain, size_t chan_idx, double r_max);
+
+                public:
+                    /**
+                    * @brief Evaluate the ratio.
+                    * @param[in]  r     The destination radius.
+                    * @param[out] ratio The ratio.
+                    * @return @c false if the chain cannot transform the point.
+                    */
+                    bool eval(double r, double& ratio) const;
+
+                public:
+                    /**
+                    * @brief The position error is the ratio error times the radius.
+                    * @param[in] r The destination radius.
+                    * @return The radius.
+                    */
+                    double error_scale(double r) const;
+
+                private:
+                    const chain_t& chain_;
+                    const size_t chan_idx_;
+                    const double r_max_;
+            };
+
+        private:
+            /**
+            * @brief Calculate the fingerprint of a %model chain.
+            * @param[in]  chain    The %model chain.
+            * @param[in]  chan_idx The channel index.
+            * @param[in]  r_max    The maximum destination radius covered by the table.
+            * @param[out] fp       The fingerprint.
+            */
+            static void get_fingerprint(const chain_t& chain, size_t chan_idx, double r_max,
+                                        std::vector<double>& fp);
+
+        private:
+            /**
+            * @brief Build the table.
+            * @param[in] chain The %model chain.
+            * @param[in] chan_idx The channel index.
+            * @param[in] r_max The maximum destination radius covered by the table.
+            * @return @c true if the chain could be collapsed.
+            */
+            bool build(const chain_t& chain, size_t chan_idx, double r_max);
+
+        private:
+            /**
+            * @brief The initial number of table intervals.
+            */
+            size_t num_;
+
+        private:
+            /**
+            * @brief The resolution used for the last table.
+            * @details Later updates start at this resolution, so repeated updates
+            * (e.g. per band in streaming mode) do not repeat the refinement.
+            */
+            size_t cur_num_;
+
+        private:
+            /**
+            * @brief The maximum interpolation error.
+            */
+            double max_err_;
+
+        private:
+            /**
+            * @brief The table of radius ratios (over the destination radius).
+            */
+            RadialTable table_;
+
+        private:
+            /**
+            * @brief The horizontal centre position.
+            */
+            interp_coord_t x0_;
+
+        private:
+            /**
+            * @brief The vertical centre position.
+            */
+            interp_coord_t y0_;
+
+        private:
+            /**
+            * @brief Flag indicating a usable table.
+            */
+            bool valid_;
+
+        private:
+            /**
+            * @brief Fingerprint of the chain used for the last update (empty after reset()).
+            */
+            std::vector<double> fingerprint_;
+
+        private:
+            /**
+            * @brief The number of radii sampled for the fingerprint.
+            */
+            static const size_t fingerprint_num_ = 64;
+
+        private:
+            /**
+            * @brief The maximum number of table intervals.
+            */
+            static const size_t max_num_ = 1048576;
+
+    }; // class RadialCollapse
+
+    ///@endcond
+
+} // namespace phtr
+
+#include <photoropter/radial_collapse.inl.h>
+
+#endif // PHTR_RADIAL_COLLAPSE_H__
@@ -0,0 +1,187 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+
+#ifndef PHTR_RADIAL_TABLE_H__
+#define PHTR_RADIAL_TABLE_H__
+
+#include <cstddef>
+#include <vector>
+
+namespace phtr
+{
+
+    ///@cond PROTECTED
+
+    /**
+    * @brief Lookup table for a function of the radius (or squared radius).
+    * @details This is the common machinery behind the radial lookup tables of
+    * model::GeometryConvertPixelModel, model::VignettingColourModel and
+    * RadialCollapse. The table samples a function at equidistant positions from 0 up
+    * to a maximum value and interpolates linearly in between. Sampling stops at the
+    * first position where the function cannot be evaluated; beyond that, lookups fail
+    * and the caller has to evaluate the function directly.
+    */
+    class RadialTable
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief Interface for the tabulated function.
+            */
+            class IFunction
+            {
+                public:
+                    /**
+                    * @brief (Dummy) Destructor.
+                    */
+                    virtual ~IFunction() {};
+
+                public:
+                    /**
+                    * @brief Evaluate the function.
+                    * @param[in]  pos The position (radius or squared radius).
+                    * @param[out] val The function value.
+                    * @return @c false if the function cannot be evaluated (sampling stops there).
+                    */
+                    virtual bool eval(double pos, double& val) const = 0;
+
+                public:
+                    /**
+                    * @brief Get the factor converting a value error into the error measure
+                    * used by check_error() (e.g., the radius for a ratio of radii).
+                    * @param[in] pos The position.
+                    * @return The factor (default: 1).
+                    */
+                    virtual double error_scale(double pos) const;
+            };
+
+        public:
+            /**
+            * @brief Standard constructor (empty table).
+            */
+            RadialTable();
+
+        public:
+            /**
+            * @brief Get the radius covered by radial tables for a given image aspect ratio.
+            * @details This is the full image diagonal in normalised coordinates, i.e.
+            * twice the distance from the centre to a corner (which leaves room for
+            * centre shifts and for source positions outside the image).
+            * @param[in] aspect The image aspect ratio.
+            * @return The radius.
+            */
+            static double max_radius(double aspect);
+
+        public:
+            /**
+            * @brief Sample the function.
+            * @param[in] func       The function.
+            * @param[in] num        The number of table intervals.
+            * @param[in] pos_max    The maximum position covered by the table.
+            * @param[in] off_centre Evaluate the first entry slightly off the centre
+            *                       (for functions of the direction, which is undefined there).
+            */
+            void build(const IFunction& func, size_t num, double pos_max, bool off_centre);
+
+        public:
+            /**
+            * @brief Check the interpolation error at the interval centres.
+            * @param[in]  func     The function used to build the table.
+            * @param[in]  max_err  The maximum error (see IFunction::error_scale()).
+            * @param[out] exceeded Set to @c true if the error bound is exceeded (and
+            *                      to @c false if the function cannot be evaluated).
+            * @return The index of the first interval failing the check (the number of
+            * valid intervals if all pass).
+            */
+            size_t check_error(const IFunction& func, double max_err, bool& exceeded) const;
+
+        public:
+            /**
+            * @brief Restrict the valid part of the table.
+            * @param[in] num The number of intervals to keep.
+            */
+            void limit(size_t num);
+
+        public:
+            /**
+            * @brief Discard the table.
+            */
+            void clear();
+
+        public:
+            /**
+            * @brief Check if the table contains any valid intervals.
+            * @return @c true if lookups can succeed.
+            */
+            bool valid() const;
+
+        public:
+            /**
+            * @brief Look up the (interpolated) function value.
+            * @param[in]  pos The position.
+            * @param[out] val The function value.
+            * @return @c false if the position lies outside the valid part of the table
+            * (@c val is unchanged in that case).
+            */
+            inline bool lookup(double pos, double& val) const;
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief The tabulated function values.
+            */
+            std::vector<double> table_;
+
+        private:
+            /**
+            * @brief Factor to convert a position to a table index.
+            */
+            double scale_;
+
+        private:
+            /**
+            * @brief The table index up to which lookups are valid.
+            */
+            double lim_;
+
+    }; // class RadialTable
+
+    ///@endcond
+
+} // namespace phtr
+
+#include <photoropter/radial_table.inl.h>
+
+#endif // PHTR_RADIAL_TABLE_H__
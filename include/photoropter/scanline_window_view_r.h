@@ -0,0 +1,300 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_SCANLINE_WINDOW_VIEW_R_H__
+#define PHTR_SCANLINE_WINDOW_VIEW_R_H__
+
+#include <vector>
+
+#include <photoropter/types.h>
+#include <photoropter/mem_image_iter_r.h>
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/channel_type.h>
+#include <photoropter/mem/mem_storage_info.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Class template implementing a (reading) 'image view' that holds only
+    * a sliding window of image lines.
+    * @details Lines are added in order using @ref push_line(); only the most recent
+    * lines (up to the window height) are kept. The view reports the size of the
+    * complete image, so it can be used as input of an @ref ImageTransform, as long as
+    * only lines inside the window are accessed. Accesses outside the window are clamped
+    * to the nearest available line.
+    * @note Internally, every line is stored twice (in a ring buffer of twice the window
+    * height), so that the lines of the window always form a contiguous block of memory
+    * and the normal memory iterators can be used.
+    * @param storage_T The storage type (e.g. @ref mem::Storage::rgb_8_inter).
+    */
+    template <mem::Storage::type storage_T>
+    class ScanlineWindowViewR
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief The type of the internal storage info object.
+            */
+            typedef typename mem::MemStorageInfo<storage_T> storage_info_t;
+
+        public:
+            /**
+            * @brief The channel storage type for this image (e.g., uint8_t).
+            */
+            typedef typename storage_info_t::channel_storage_t channel_storage_t;
+
+        public:
+            /**
+            * @brief The type of the internal iterator.
+            */
+            typedef typename phtr::MemImageIterR<storage_T> iter_t;
+
+        public:
+            /**
+            * @brief Constructor.
+            * @note The window has to be allocated using @ref set_window_height()
+            * before lines can be added.
+            * @param[in] width  The image width.
+            * @param[in] height The image height.
+            */
+            ScanlineWindowViewR(coord_t width, coord_t height);
+
+        public:
+            /**
+            * @brief Set the number of lines to keep.
+            * @details This (re-)allocates the window buffer and discards all lines.
+            * @param[in] num_lines The window height.
+            */
+            void set_window_height(coord_t num_lines);
+
+        public:
+            /**
+            * @brief Get the number of lines that are kept.
+            * @return The window height.
+            */
+            coord_t window_height() const;
+
+        public:
+            /**
+            * @brief Add the next image line.
+            * @param[in] line_data The line data, using the memory layout of an
+            * image of height 1.
+            */
+            void push_line(const void* line_data);
+
+        public:
+            /**
+            * @brief Get the number of lines added so far.
+            * @return The number of lines.
+            */
+            coord_t lines_pushed() const;
+
+        public:
+            /**
+            * @brief Get the first line which is still inside the window.
+            * @return The line number.
+            */
+            coord_t first_line() const;
+
+        public:
+            /**
+            * @brief Discard all lines (e.g., to start over with the next image).
+            */
+            void reset();
+
+        public:
+            /**
+            * @brief Get the image width.
+            * @return The width.
+            */
+            coord_t width() const;
+
+        public:
+            /**
+            * @brief Get the image height.
+            * @return The height.
+            */
+            coord_t height() const;
+
+        public:
+            /**
+            * @brief Determine the 'pixel offset' to a given set of coordinates.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The offset
+            */
+            size_t get_px_offs(coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Read the given channel value.
+            * @param[in] chan The channel.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The channel value.
+            */
+            inline channel_storage_t
+            get_px_val(Channel::type chan, coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Read a span of pixels of one line into a structure-of-arrays buffer.
+            * @details See @ref MemImageIterR::read_span() for the buffer layout.
+            * @param[in]  x          The x coordinate of the first pixel.
+            * @param[in]  y          The y coordinate.
+            * @param[in]  num        The number of pixels.
+            * @param[out] planes     The destination buffer (e.g., of type float or double).
+            * @param[in]  plane_size The distance between the channel planes (at least num).
+            */
+            template <typename value_T>
+            void read_span(coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const;
+
+        public:
+            /**
+            * @brief Get a pixel iterator.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The iterator.
+            */
+            iter_t get_iter(coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Set the aspect ratio of the image.
+            * @param aspect_ratio The new aspect ratio.
+            */
+            void set_aspect_ratio(interp_coord_t aspect_ratio);
+
+        public:
+            /**
+            * @brief Get the aspect ratio of the image.
+            * @note The ratio is automatically calculated when the view is created,
+            * but can be overridden using @ref set_aspect_ratio().
+            * @return The aspect ratio.
+            */
+            interp_coord_t aspect_ratio() const;
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief The image width.
+            */
+            const coord_t width_;
+
+        private:
+            /**
+            * @brief The image height.
+            */
+            const coord_t height_;
+
+        private:
+            /**
+            * @brief The image's aspect ratio.
+            */
+            interp_coord_t aspect_ratio_;
+
+        private:
+            /**
+            * @brief The window height.
+            */
+            coord_t window_height_;
+
+        private:
+            /**
+            * @brief The number of lines added so far.
+            */
+            coord_t lines_pushed_;
+
+        private:
+            /**
+            * @brief The first line inside the window.
+            */
+            coord_t first_line_;
+
+        private:
+            /**
+            * @brief The buffer line holding the first line of the window.
+            */
+            coord_t first_slot_;
+
+        private:
+            /**
+            * @brief The window buffer (twice the window height).
+            */
+            std::vector<channel_storage_t> buffer_;
+
+        private:
+            /**
+            * @brief The distance between two adjacent pixels in the buffer.
+            */
+            size_t step_;
+
+        private:
+            /**
+            * @brief The distance between two adjacent lines in the buffer.
+            */
+            size_t line_step_;
+
+        private:
+            /**
+            * @brief The offset of the red channel in the buffer.
+            */
+            size_t r_offs_;
+
+        private:
+            /**
+            * @brief The offset of the green channel in the buffer.
+            */
+            size_t g_offs_;
+
+        private:
+            /**
+            * @brief The offset of the blue channel in the buffer.
+            */
+            size_t b_offs_;
+
+        private:
+            /**
+            * @brief The offset of the alpha channel in the buffer.
+            */
+            size_t a_offs_;
+
+    }; // template class ScanlineWindowViewR<>
+
+} // namespace phtr
+
+#include <photoropter/scanline_window_view_r.tpl.h>
+
+#endif // PHTR_SCANLINE_WINDOW_VIEW_R_H__
@@ -0,0 +1,235 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <cassert>
+
+#include <photoropter/mem/line_copy.h>
+
+namespace phtr
+{
+
+    template <mem::Storage::type storage_T>
+    ScanlineWindowViewR<storage_T>::
+    ScanlineWindowViewR
+    (coord_t width, coord_t height)
+            : width_(width),
+            height_(height),
+            aspect_ratio_(static_cast<interp_coord_t>(width) / static_cast<interp_coord_t>(height)),
+            window_height_(0),
+            lines_pushed_(0),
+            first_line_(0),
+            first_slot_(0),
+            step_(0),
+            line_step_(0),
+            r_offs_(0),
+            g_offs_(0),
+            b_offs_(0),
+            a_offs_(0)
+    {
+        //NIL
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    ScanlineWindowViewR<storage_T>::
+    set_window_height
+    (coord_t num_lines)
+    {
+        assert(num_lines > 0);
+
+        window_height_ = num_lines;
+
+        // the buffer holds every line twice
+        const storage_info_t info(width_, 2 * window_height_);
+
+        buffer_.assign(info.num_channels * width_ * 2 * window_height_, 0);
+
+        step_ = info.step;
+        line_step_ = info.line_step;
+        r_offs_ = info.r_offs;
+        g_offs_ = info.g_offs;
+        b_offs_ = info.b_offs;
+        a_offs_ = info.a_offs;
+
+        reset();
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    ScanlineWindowViewR<storage_T>::
+    window_height
+    () const
+    {
+        return window_height_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    ScanlineWindowViewR<storage_T>::
+    push_line
+    (const void* line_data)
+    {
+        assert(window_height_ > 0);
+
+        coord_t slot = lines_pushed_ % window_height_;
+
+        mem::copy_line<storage_T>(line_data, 1, 0, &buffer_[0], 2 * window_height_, slot, width_);
+        mem::copy_line<storage_T>(line_data, 1, 0, &buffer_[0], 2 * window_height_, slot + window_height_, width_);
+
+        ++lines_pushed_;
+
+        first_line_ = (lines_pushed_ > window_height_) ? lines_pushed_ - window_height_ : 0;
+        first_slot_ = first_line_ % window_height_;
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    ScanlineWindowViewR<storage_T>::
+    lines_pushed
+    () const
+    {
+        return lines_pushed_;
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    ScanlineWindowViewR<storage_T>::
+    first_line
+    () const
+    {
+        return first_line_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    ScanlineWindowViewR<storage_T>::
+    reset
+    ()
+    {
+        lines_pushed_ = 0;
+        first_line_ = 0;
+        first_slot_ = 0;
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    ScanlineWindowViewR<storage_T>::
+    width
+    () const
+    {
+        return width_;
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    ScanlineWindowViewR<storage_T>::
+    height
+    () const
+    {
+        return height_;
+    }
+
+    template <mem::Storage::type storage_T>
+    size_t
+    ScanlineWindowViewR<storage_T>::
+    get_px_offs
+    (coord_t x, coord_t y) const
+    {
+        // clamp to the lines inside the window
+        if (y < first_line_)
+        {
+            y = first_line_;
+        }
+        else if (y >= lines_pushed_)
+        {
+            y = (lines_pushed_ > 0) ? lines_pushed_ - 1 : 0;
+        }
+
+        return (first_slot_ + (y - first_line_)) * line_step_ + x * step_;
+    }
+
+    template <mem::Storage::type storage_T>
+    typename ScanlineWindowViewR<storage_T>::channel_storage_t
+    ScanlineWindowViewR<storage_T>::
+    get_px_val
+    (Channel::type chan, coord_t x, coord_t y) const
+    {
+        switch (chan)
+        {
+            case Channel::red:
+            default:
+                return buffer_[get_px_offs(x, y) + r_offs_];
+                break;
+
+            case Channel::green:
+                return buffer_[get_px_offs(x, y) + g_offs_];
+                break;
+
+            case Channel::blue:
+                return buffer_[get_px_offs(x, y) + b_offs_];
+                break;
+
+            case Channel::alpha:
+                return buffer_[get_px_offs(x, y) + a_offs_];
+                break;
+        }
+    }
+
+    template <mem::Storage::type storage_T> template <typename value_T>
+    void
+    ScanlineWindowViewR<storage_T>::
+    read_span
+    (coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const
+    {
+        get_iter(x, y).read_span(num, planes, plane_size);
+    }
+
+    template <mem::Storage::type storage_T>
+    typename ScanlineWindowViewR<storage_T>::iter_t
+    ScanlineWindowViewR<storage_T>::
+    get_iter
+    (coord_t x, coord_t y) const
+    {
+        return iter_t(const_cast<channel_storage_t*>(&buffer_[0]), get_px_offs(x, y), step_, line_step_,
+                      r_offs_, g_offs_, b_offs_, a_offs_);
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    ScanlineWindowViewR<storage_T>::set_aspect_ratio(interp_coord_t aspect_ratio)
+    {
+        aspect_ratio_ = aspect_ratio;
+    }
+
+    template <mem::Storage::type storage_T>
+    interp_coord_t
+    ScanlineWindowViewR<storage_T>::aspect_ratio() const
+    {
+        return aspect_ratio_;
+    }
+
+} // namespace phtr
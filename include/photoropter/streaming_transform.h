@@ -0,0 +1,400 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_STREAMING_TRANSFORM_H__
+#define PHTR_STREAMING_TRANSFORM_H__
+
+#include <vector>
+
+#include <photoropter/types.h>
+#include <photoropter/line_sink.h>
+#include <photoropter/image_buffer.h>
+#include <photoropter/image_transform.h>
+#include <photoropter/interpolation_type.h>
+#include <photoropter/mem_image_view_w.h>
+#include <photoropter/scanline_window_view_r.h>
+#include <photoropter/mem/storage_type.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Streaming image transformation interface.
+    * @details A streaming transformation consumes the input image line by line and
+    * emits output lines as soon as all input lines they depend on are available.
+    * Only a sliding window of input lines is kept in memory; its height is determined
+    * by the configured corrections (i.e., the amount of distortion), not by the image
+    * height. This way, a decoder, Photoropter and an encoder can be chained with
+    * a small memory footprint.
+    */
+    class IStreamingTransform
+    {
+
+        public:
+            /**
+             * @ brief (Dummy) Destructor.
+             */
+            virtual ~IStreamingTransform() {};
+
+        public:
+            /**
+            * @brief Access the underlying image transformation.
+            * @details This is used to configure the correction queues, %gamma
+            * and oversampling. All configuration has to be done before @ref prepare()
+            * is called (or the first line is pushed).
+            * @return Reference to the transformation object.
+            */
+            virtual IImageTransform& transform() = 0;
+
+        public:
+            /**
+            * @brief Determine the input lines needed for each output line and
+            * allocate the input window.
+            * @details This is called automatically when the first line is pushed.
+            */
+            virtual void prepare() = 0;
+
+        public:
+            /**
+            * @brief Get the number of input lines held in memory.
+            * @return The window height (0 if @ref prepare() has not been called yet).
+            */
+            virtual coord_t window_height() const = 0;
+
+        public:
+            /**
+            * @brief Add the next input line.
+            * @details All output lines that can be completed are passed to the sink.
+            * @param[in] line_data The line data, using the memory layout of an image
+            *                      of height 1.
+            * @param[in] sink      The receiver of the output lines.
+            */
+            virtual void push_line(const void* line_data, ILineSink& sink) = 0;
+
+        public:
+            /**
+            * @brief Emit all remaining output lines.
+            * @details This should be called after the last input line has been pushed.
+            * @param[in] sink The receiver of the output lines.
+            */
+            virtual void finish(ILineSink& sink) = 0;
+
+        public:
+            /**
+            * @brief Transform a complete image in place.
+            * @details The output overwrites the input line by line. Input lines that are
+            * still needed later on are kept in the input window (which may have to be
+            * somewhat larger than for streaming operation), so no second full-size
+            * buffer is required.
+            * @note Input and output dimensions have to be identical.
+            * @param[in,out] image_data The image data (using the storage type of the
+            *                           transformation).
+            */
+            virtual void transform_in_place(void* image_data) = 0;
+
+        public:
+            /**
+            * @brief Get the number of output lines emitted so far.
+            * @return The number of lines.
+            */
+            virtual coord_t lines_emitted() const = 0;
+
+        public:
+            /**
+            * @brief Start over with a new input image (using the same configuration).
+            */
+            virtual void reset() = 0;
+
+    }; // class IStreamingTransform
+
+    /**
+    * @brief Streaming image transformation class template.
+    * @details See @ref IStreamingTransform for details. The output is computed in
+    * bands of a few lines by an @ref ImageTransform instance which reads from a
+    * @ref ScanlineWindowViewR and writes to a small band buffer.
+    * @param interpolator_T The interpolator class template to be used (e.g. @ref InterpolatorBilinear).
+    * @param storage_T      The storage type (e.g. @ref mem::Storage::rgb_8_inter).
+    */
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    class StreamingTransform : public IStreamingTransform
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief The type of the input view.
+            */
+            typedef ScanlineWindowViewR<storage_T> window_view_t;
+
+        public:
+            /**
+            * @brief The type of the output (band) view.
+            */
+            typedef MemImageViewW<storage_T> band_view_t;
+
+        public:
+            /**
+            * @brief The type of the underlying image transformation.
+            */
+            typedef ImageTransform<interpolator_T<window_view_t>, band_view_t> image_transform_t;
+
+        public:
+            /**
+            * @brief Constructor.
+            * @param[in] inp_width   The input image width.
+            * @param[in] inp_height  The input image height.
+            * @param[in] outp_width  The output image width.
+            * @param[in] outp_height The output image height.
+            * @param[in] band_height The number of output lines computed in one go.
+            */
+            StreamingTransform(coord_t inp_width, coord_t inp_height,
+                               coord_t outp_width, coord_t outp_height,
+                               coord_t band_height = 16);
+
+        public:
+            /**
+            * @brief Access the underlying image transformation.
+            * @return Reference to the transformation object.
+            */
+            IImageTransform& transform();
+
+        public:
+            /**
+            * @brief Access the underlying image transformation (e.g., to access the
+            * interpolator).
+            * @return Reference to the transformation object.
+            */
+            image_transform_t& image_transform();
+
+        public:
+            /**
+            * @brief Determine the input lines needed for each output line and
+            * allocate the input window.
+            */
+            void prepare();
+
+        public:
+            /**
+            * @brief Get the number of input lines held in memory.
+            * @return The window height.
+            */
+            coord_t window_height() const;
+
+        public:
+            /**
+            * @brief Add the next input line.
+            * @param[in] line_data The line data.
+            * @param[in] sink      The receiver of the output lines.
+            */
+            void push_line(const void* line_data, ILineSink& sink);
+
+        public:
+            /**
+            * @brief Emit all remaining output lines.
+            * @param[in] sink The receiver of the output lines.
+            */
+            void finish(ILineSink& sink);
+
+        public:
+            /**
+            * @brief Transform a complete image in place.
+            * @param[in,out] image_data The image data.
+            */
+            void transform_in_place(void* image_data);
+
+        public:
+            /**
+            * @brief Get the number of output lines emitted so far.
+            * @return The number of lines.
+            */
+            coord_t lines_emitted() const;
+
+        public:
+            /**
+            * @brief Start over with a new input image.
+            */
+            void reset();
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief Copy constructor (disabled).
+            */
+            StreamingTransform(const StreamingTransform& orig);
+
+        private:
+            /**
+            * @brief Assignment operator (disabled).
+            */
+            StreamingTransform& operator=(const StreamingTransform& orig);
+
+        private:
+            /**
+            * @brief Emit all bands whose input lines are available.
+            * @param[in] sink The receiver of the output lines.
+            */
+            void emit_ready_bands(ILineSink& sink);
+
+        private:
+            /**
+            * @brief Compute a band of output lines and pass it to the sink.
+            * @param[in] band The band index.
+            * @param[in] sink The receiver of the output lines.
+            */
+            void emit_band(coord_t band, ILineSink& sink);
+
+        private:
+            /**
+            * @brief Compute a band of output lines into the band buffer.
+            * @param[in] band The band index.
+            * @return The number of lines in the band.
+            */
+            coord_t compute_band(coord_t band);
+
+        private:
+            /**
+            * @brief The input image width.
+            */
+            const coord_t inp_width_;
+
+        private:
+            /**
+            * @brief The input image height.
+            */
+            const coord_t inp_height_;
+
+        private:
+            /**
+            * @brief The output image width.
+            */
+            const coord_t outp_width_;
+
+        private:
+            /**
+            * @brief The output image height.
+            */
+            const coord_t outp_height_;
+
+        private:
+            /**
+            * @brief The number of output lines computed in one go.
+            */
+            const coord_t band_height_;
+
+        private:
+            /**
+            * @brief The number of output bands.
+            */
+            const coord_t num_bands_;
+
+        private:
+            /**
+            * @brief The sliding input window.
+            */
+            window_view_t window_view_;
+
+        private:
+            /**
+            * @brief The buffer for a band of output lines.
+            */
+            ImageBuffer<storage_T> band_buffer_;
+
+        private:
+            /**
+            * @brief The view of the band buffer.
+            */
+            band_view_t band_view_;
+
+        private:
+            /**
+            * @brief The buffer for a single output line.
+            */
+            ImageBuffer<storage_T> line_buffer_;
+
+        private:
+            /**
+            * @brief The underlying image transformation.
+            */
+            image_transform_t image_transform_;
+
+        private:
+            /**
+            * @brief Whether the input window has been set up.
+            */
+            bool prepared_;
+
+        private:
+            /**
+            * @brief The next band to emit.
+            */
+            coord_t next_band_;
+
+        private:
+            /**
+            * @brief For each band, the last input line that has to be available
+            * before the band (and all bands before it) can be emitted.
+            */
+            std::vector<long> band_need_line_;
+
+        private:
+            /**
+            * @brief For each band, the first input line that is still needed by
+            * the band or any band after it.
+            */
+            std::vector<long> band_keep_line_;
+
+    }; // template class StreamingTransform<>
+
+    /**
+     * @brief Get a streaming image transformation instance.
+     * @details This function template is a shortcut when the interpolation type is given
+     * at runtime (cf. @ref get_image_transform()).
+     * @param interp_type The interpolation type, e.g. @ref Interpolation::bilinear
+     * @param inp_width   The input image width.
+     * @param inp_height  The input image height.
+     * @param outp_width  The output image width.
+     * @param outp_height The output image height.
+     * @param band_height The number of output lines computed in one go.
+     * @param storage_T   The storage type (e.g. @ref mem::Storage::rgb_8_inter).
+     */
+    template <mem::Storage::type storage_T>
+    IStreamingTransform* get_streaming_transform(Interpolation::type interp_type,
+            coord_t inp_width, coord_t inp_height,
+            coord_t outp_width, coord_t outp_height,
+            coord_t band_height = 16);
+
+} // namespace phtr
+
+#include <photoropter/streaming_transform.tpl.h>
+
+#endif // PHTR_STREAMING_TRANSFORM_H__
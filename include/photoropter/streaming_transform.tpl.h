@@ -0,0 +1,410 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <photoropter/exception.h>
+#include <photoropter/mem/line_copy.h>
+#include <photoropter/interpolator/interpolator_nn.h>
+#include <photoropter/interpolator/interpolator_bilinear.h>
+#include <photoropter/interpolator/interpolator_lanczos.h>
+
+namespace phtr
+{
+
+    template <mem::Storage::type storage_T>
+    IStreamingTransform*
+    get_streaming_transform(Interpolation::type interp_type,
+                            coord_t inp_width, coord_t inp_height,
+                            coord_t outp_width, coord_t outp_height,
+                            coord_t band_height)
+    {
+
+        switch (interp_type)
+        {
+            case Interpolation::nearest_neighbour:
+                return new StreamingTransform<InterpolatorNN, storage_T>
+                       (inp_width, inp_height, outp_width, outp_height, band_height);
+                break;
+
+            case Interpolation::bilinear:
+            default:
+                return new StreamingTransform<InterpolatorBilinear, storage_T>
+                       (inp_width, inp_height, outp_width, outp_height, band_height);
+                break;
+
+            case Interpolation::lanczos:
+                return new StreamingTransform<InterpolatorLanczos, storage_T>
+                       (inp_width, inp_height, outp_width, outp_height, band_height);
+                break;
+        }
+
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    StreamingTransform<interpolator_T, storage_T>::
+    StreamingTransform(coord_t inp_width, coord_t inp_height,
+                       coord_t outp_width, coord_t outp_height,
+                       coord_t band_height)
+            : inp_width_(inp_width),
+            inp_height_(inp_height),
+            outp_width_(outp_width),
+            outp_height_(outp_height),
+            band_height_(band_height),
+            num_bands_((outp_height + band_height - 1) / band_height),
+            window_view_(inp_width, inp_height),
+            band_buffer_(outp_width, band_height),
+            band_view_(band_buffer_.data(), outp_width, band_height),
+            line_buffer_(outp_width, 1),
+            image_transform_(window_view_, band_view_),
+            prepared_(false),
+            next_band_(0),
+            band_need_line_(num_bands_),
+            band_keep_line_(num_bands_)
+    {
+        assert(band_height > 0);
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    IImageTransform&
+    StreamingTransform<interpolator_T, storage_T>::
+    transform()
+    {
+        return image_transform_;
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    typename StreamingTransform<interpolator_T, storage_T>::image_transform_t&
+    StreamingTransform<interpolator_T, storage_T>::
+    image_transform()
+    {
+        return image_transform_;
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    prepare()
+    {
+        typedef typename window_view_t::storage_info_t::mem_layout_t::coord_tuple_t coord_tuple_t;
+        typedef typename coord_tuple_t::channel_order_t::colour_tuple_t colour_tuple_t;
+
+        // oversampling parameters (cf. ImageTransform::do_transform())
+        const unsigned int oversampling = image_transform_.sampling_fact();
+        const interp_coord_t sampling_fact = static_cast<interp_coord_t>(oversampling);
+        const interp_coord_t sampling_step = 1.0 / sampling_fact;
+
+        // output coordinate transformation parameters
+        const interp_coord_t aspect_ratio = image_transform_.interpolator().aspect_ratio();
+        const interp_coord_t scale_x = 2.0 * aspect_ratio / static_cast<interp_coord_t>(outp_width_ - 1);
+        const interp_coord_t scale_y = 2.0 / static_cast<interp_coord_t>(outp_height_ - 1);
+
+        // input coordinate transformation parameters (cf. InterpolatorBase)
+        const interp_coord_t inp_scale_x =
+            (static_cast<interp_coord_t>(inp_width_) - 1.0) / (2.0 * aspect_ratio);
+        const interp_coord_t inp_scale_y = (static_cast<interp_coord_t>(inp_height_) - 1.0) / 2.0;
+        const interp_coord_t inp_x_max = static_cast<interp_coord_t>(inp_width_);
+        const interp_coord_t inp_y_max = static_cast<interp_coord_t>(inp_height_);
+        const long support = static_cast<long>(image_transform_.interpolator().support());
+        const long inp_last_line = static_cast<long>(inp_height_) - 1;
+
+        // collapse radial correction chains (cf. ImageTransform::do_transform())
+        const interp_coord_t r_max = RadialTable::max_radius(aspect_ratio);
+        image_transform_.pixel_queue().update_radial_collapse(r_max);
+        image_transform_.subpixel_queue().update_radial_collapse(r_max, colour_tuple_t::num_vals);
+
+        const PixelCorrectionQueue& pixel_queue = image_transform_.pixel_queue();
+        const SubpixelCorrectionQueue& subpixel_queue = image_transform_.subpixel_queue();
+
+        // first/last input line accessed by each band
+        // (an empty band has first > last)
+        std::vector<long> band_first(num_bands_, inp_last_line + 1);
+        std::vector<long> band_last(num_bands_, -1);
+
+        omp_coord_t b(0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (b = 0; b < static_cast<omp_coord_t>(num_bands_); ++b) // band loop
+        {
+            long first(inp_last_line + 1);
+            long last(-1);
+
+            coord_t j0 = static_cast<coord_t>(b) * band_height_;
+            coord_t j_limit = std::min(j0 + band_height_, outp_height_);
+
+            mem::CoordTupleMono pixel_coords;
+            coord_tuple_t subpixel_coords;
+
+            for (coord_t j = j0; j < j_limit; ++j) // line loop
+            {
+                for (coord_t i = 0; i < outp_width_; ++i) // pixel loop
+                {
+                    interp_coord_t ini_samp_x(static_cast<interp_coord_t>(i) - 0.5 + (1.0 / (2 * sampling_fact)));
+                    interp_coord_t cur_samp_y(static_cast<interp_coord_t>(j) - 0.5 + (1.0 / (2 * sampling_fact)));
+
+                    for (unsigned int v = 0; v < oversampling; ++v)
+                    {
+                        interp_coord_t cur_samp_x = ini_samp_x;
+
+                        for (unsigned int u = 0; u < oversampling; ++u)
+                        {
+                            interp_coord_t dst_x = (cur_samp_x * scale_x) - aspect_ratio;
+                            interp_coord_t dst_y = (cur_samp_y * scale_y) - 1.0;
+
+                            pixel_queue.get_src_coords(dst_x, dst_y, pixel_coords);
+                            subpixel_queue.get_src_coords(pixel_coords, subpixel_coords);
+
+                            for (size_t c = 0; c < colour_tuple_t::num_vals; ++c)
+                            {
+                                interp_coord_t x_scaled = (subpixel_coords.x[c] + aspect_ratio) * inp_scale_x;
+                                interp_coord_t y_scaled = (subpixel_coords.y[c] + 1.0) * inp_scale_y;
+
+                                // same check as in the interpolators (negated to skip NaN, too)
+                                if (!((x_scaled >= 0) && (x_scaled <= inp_x_max)
+                                        && (y_scaled >= 0) && (y_scaled <= inp_y_max)))
+                                {
+                                    continue;
+                                }
+
+                                long y0 = static_cast<long>(std::floor(y_scaled));
+                                first = std::min(first, y0 - support + 1);
+                                last = std::max(last, y0 + support);
+                            }
+
+                            cur_samp_x += sampling_step;
+                        } // (inner) oversampling loop
+
+                        cur_samp_y += sampling_step;
+                    } // (outer) oversampling loop
+
+                } // pixel loop
+
+            } // line loop
+
+            if (first <= last)
+            {
+                band_first[b] = std::max(first, 0L);
+                band_last[b] = std::min(last, inp_last_line);
+            }
+
+        } // band loop
+
+        // band b may only be emitted after all bands before it
+        long need_line(-1);
+        for (coord_t band = 0; band < num_bands_; ++band)
+        {
+            need_line = std::max(need_line, band_last[band]);
+            band_need_line_[band] = need_line;
+        }
+
+        // lines still needed by band b or any band after it
+        // (at the time band b is emitted)
+        long keep_line(inp_last_line + 1);
+        long window(1);
+        for (coord_t band = num_bands_; band > 0; --band)
+        {
+            keep_line = std::min(keep_line, band_first[band - 1]);
+            band_keep_line_[band - 1] = keep_line;
+            window = std::max(window, band_need_line_[band - 1] - keep_line + 1);
+        }
+
+        window_view_.set_window_height(std::min(static_cast<coord_t>(window), inp_height_));
+
+        prepared_ = true;
+
+    } // StreamingTransform<...>::prepare()
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    coord_t
+    StreamingTransform<interpolator_T, storage_T>::
+    window_height() const
+    {
+        return window_view_.window_height();
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    push_line(const void* line_data, ILineSink& sink)
+    {
+        if (!prepared_)
+        {
+            prepare();
+        }
+
+        assert(window_view_.lines_pushed() < inp_height_);
+
+        window_view_.push_line(line_data);
+        emit_ready_bands(sink);
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    finish(ILineSink& sink)
+    {
+        if (!prepared_)
+        {
+            prepare();
+        }
+
+        while (next_band_ < num_bands_)
+        {
+            emit_band(next_band_, sink);
+            ++next_band_;
+        }
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    transform_in_place(void* image_data)
+    {
+        if ((inp_width_ != outp_width_) || (inp_height_ != outp_height_))
+        {
+            throw exception::illegal_argument(
+                "In-place transformation requires identical input and output dimensions.");
+        }
+
+        if (!prepared_)
+        {
+            prepare();
+        }
+
+        // Before a band is written, its own input lines have to be saved
+        // as well (in addition to the lines the band reads from).
+        long window(static_cast<long>(window_view_.window_height()));
+        for (coord_t band = 0; band < num_bands_; ++band)
+        {
+            long band_last = static_cast<long>(std::min((band + 1) * band_height_, outp_height_)) - 1;
+            long last_line = std::max(band_need_line_[band], band_last);
+            window = std::max(window, last_line - band_keep_line_[band] + 1);
+        }
+        window = std::min(window, static_cast<long>(inp_height_));
+
+        if (window != static_cast<long>(window_view_.window_height()))
+        {
+            window_view_.set_window_height(static_cast<coord_t>(window));
+        }
+
+        reset();
+
+        ImageBuffer<storage_T> inp_line(inp_width_, 1);
+
+        for (; next_band_ < num_bands_; ++next_band_)
+        {
+            coord_t j0 = next_band_ * band_height_;
+            coord_t rows = std::min(band_height_, outp_height_ - j0);
+            coord_t push_limit = std::max(static_cast<coord_t>(band_need_line_[next_band_] + 1), j0 + rows);
+
+            // save input lines (before they are overwritten)
+            while (window_view_.lines_pushed() < push_limit)
+            {
+                mem::copy_line<storage_T>(image_data, inp_height_, window_view_.lines_pushed(),
+                                          inp_line.data(), 1, 0, inp_width_);
+                window_view_.push_line(inp_line.data());
+            }
+
+            compute_band(next_band_);
+
+            for (coord_t j = 0; j < rows; ++j)
+            {
+                mem::copy_line<storage_T>(band_buffer_.data(), band_height_, j,
+                                          image_data, outp_height_, j0 + j, outp_width_);
+            }
+        }
+
+    } // StreamingTransform<...>::transform_in_place()
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    coord_t
+    StreamingTransform<interpolator_T, storage_T>::
+    lines_emitted() const
+    {
+        return std::min(next_band_ * band_height_, outp_height_);
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    reset()
+    {
+        window_view_.reset();
+        next_band_ = 0;
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    emit_ready_bands(ILineSink& sink)
+    {
+        const long lines_pushed = static_cast<long>(window_view_.lines_pushed());
+
+        while ((next_band_ < num_bands_) && (band_need_line_[next_band_] < lines_pushed))
+        {
+            emit_band(next_band_, sink);
+            ++next_band_;
+        }
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    void
+    StreamingTransform<interpolator_T, storage_T>::
+    emit_band(coord_t band, ILineSink& sink)
+    {
+        coord_t j0 = band * band_height_;
+        coord_t rows = compute_band(band);
+
+        for (coord_t j = 0; j < rows; ++j)
+        {
+            mem::copy_line<storage_T>(band_buffer_.data(), band_height_, j,
+                                      line_buffer_.data(), 1, 0, outp_width_);
+            sink.write_line(j0 + j, line_buffer_.data());
+        }
+    }
+
+    template <template <typename> class interpolator_T, mem::Storage::type storage_T>
+    coord_t
+    StreamingTransform<interpolator_T, storage_T>::
+    compute_band(coord_t band)
+    {
+        coord_t j0 = band * band_height_;
+        coord_t rows = std::min(band_height_, outp_height_ - j0);
+
+        // the band buffer represents lines j0 ... j0+rows-1 of the output image
+        band_view_.set_parent_window(0, j0, outp_width_, outp_height_);
+        band_view_.set_roi(0, 0, outp_width_, rows);
+
+        image_transform_.do_transform();
+
+        return rows;
+    }
+
+} // namespace phtr
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <photoropter/types.h>
 #include <photoropter/mem/coord_tuple.h>
 #include <photoropter/mem/colour_tuple.h>
+#include <photoropter/radial_collapse.h>
 #include <photoropter/model/subpixel_correction_model.h>
 
 namespace phtr
@@ -106,6 +107,59 @@ namespace phtr
             */
             model::ISubpixelCorrectionModel& add_model(const model::ISubpixelCorrectionModel& model);
 
+        public:
+            /**
+            * @brief Enable or disable collapsing radial %model chains.
+            * @details If all models in the queue are radially symmetric (see model::IRadialModel)
+            * about the same centre, the whole queue can be replaced by a single lookup table
+            * mapping the radius (separately for each channel). The analysis is performed by
+            * update_radial_collapse(), which ImageTransform calls at the start of every
+            * transformation (the tables are cached between transformations). Positions
+            * outside the valid part of the table are still transformed by the models
+            * themselves.
+            * The collapse is disabled by default.
+            * @param[in] enable Collapse the queue if possible.
+            */
+            void enable_radial_collapse(bool enable);
+
+        public:
+            /**
+            * @brief Set the parameters for the radial collapse.
+            * @details The table resolution is doubled (up to 2^20 intervals) until the
+            * interpolation error stays below @c max_err.
+            * @param[in] num The initial number of table intervals (default: 1024).
+            * @param[in] max_err The maximum position error in normalised coordinates
+            * (default: 1e-5, i.e. 1/100 pixel for an image height of 2000 pixels).
+            */
+            void set_radial_collapse_params(size_t num, double max_err);
+
+        public:
+            /**
+            * @brief Analyse the queue and build the radial lookup tables.
+            * @details The tables are cached: a channel's table is only rebuilt if the
+            * radius or the models (including their parameters) have changed since it
+            * was last updated.
+            * @param[in] r_max The maximum radius covered by the tables.
+            * @param[in] num_channels The number of channels in use.
+            * @return @c true if the queue has been collapsed for all channels.
+            */
+            bool update_radial_collapse(double r_max, size_t num_channels);
+
+        public:
+            /**
+            * @brief Discard the cached radial lookup tables.
+            * @details Parameter changes are detected by update_radial_collapse() itself,
+            * so this is only needed to free the tables or to force a rebuild.
+            */
+            void invalidate_radial_collapse();
+
+        public:
+            /**
+            * @brief Check whether the queue contains any models.
+            * @return @c true if the queue is empty (i.e., the identity transformation).
+            */
+            bool empty() const;
+
         public:
             /**
             * @brief Clear the current queue contents.
@@ -128,6 +182,24 @@ namespace phtr
             */
             unsigned short n_models_;
 
+        private:
+            /**
+            * @brief Flag to enable the radial collapse.
+            */
+            bool use_radial_collapse_;
+
+        private:
+            /**
+            * @brief Flag indicating that the radial lookup tables are valid.
+            */
+            bool radial_collapsed_;
+
+        private:
+            /**
+            * @brief The radial lookup tables (one per channel).
+            */
+            RadialCollapse radial_collapse_[mem::PHTR_MAX_CHANNELS];
+
     }; // class SubpixelCorrectionQueue
 
 } // namespace phtr
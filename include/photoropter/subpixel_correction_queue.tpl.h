@@ -34,6 +34,22 @@ namespace phtr
     {
         typedef typename coord_tuple_T::channel_order_t::colour_tuple_t colour_tuple_t;
 
+        if (radial_collapsed_)
+        {
+            bool success = true;
+            for (size_t i = 0; i < colour_tuple_t::num_vals && success; ++i)
+            {
+                coords.x[i] = dst_x;
+                coords.y[i] = dst_y;
+                success = radial_collapse_[i].get_src_coords(coords.x[i], coords.y[i]);
+            }
+
+            if (success)
+            {
+                return;
+            }
+        }
+
         for (size_t i = 0; i < colour_tuple_t::num_vals; ++i)
         {
             coords.x[i] = dst_x;
@@ -0,0 +1,75 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_TILE_PROVIDER_H__
+#define PHTR_TILE_PROVIDER_H__
+
+#include <photoropter/types.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Interface for classes that supply image data tile by tile.
+    * @details A tile provider is used by @ref TiledImageViewR to fetch parts
+    * of an input image on demand (e.g., from a file on disk), so that the whole
+    * image never has to be held in memory at once.
+    */
+    class ITileProvider
+    {
+
+        public:
+            /**
+             * @ brief (Dummy) Destructor.
+             */
+            virtual ~ITileProvider() {};
+
+        public:
+            /**
+            * @brief Load a rectangular region of the image into a tile buffer.
+            * @details The buffer uses the memory layout of an image of size
+            * buffer_width x buffer_height and the storage type of the view the
+            * provider is used with. The region has to be written to the top left
+            * corner of the buffer; the rest of the buffer is not accessed.
+            * @note The function is never called concurrently by the same view (it may
+            * be called from different threads, though).
+            * @param[in] x             The left edge of the region.
+            * @param[in] y             The upper edge of the region.
+            * @param[in] width         The width of the region.
+            * @param[in] height        The height of the region.
+            * @param[out] buffer       The tile buffer.
+            * @param[in] buffer_width  The width of the tile buffer.
+            * @param[in] buffer_height The height of the tile buffer.
+            */
+            virtual void load_tile(coord_t x, coord_t y, coord_t width, coord_t height,
+                                   void* buffer, coord_t buffer_width, coord_t buffer_height) = 0;
+
+    }; // class ITileProvider
+
+} // namespace phtr
+
+#endif // PHTR_TILE_PROVIDER_H__
@@ -0,0 +1,299 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_TILED_IMAGE_ITER_R_H__
+#define PHTR_TILED_IMAGE_ITER_R_H__
+
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/colour_tuple.h>
+#include <photoropter/mem/channel_type.h>
+#include <photoropter/mem/tile_cache.h>
+
+namespace phtr
+{
+
+    ///@cond PROTECTED
+
+    /**
+    * @brief Iterator class for read access to a tiled image.
+    * @details Instances of this class are usually created by @ref TiledImageViewR.
+    * The iterator keeps the tile it currently points into pinned in the cache,
+    * so consecutive accesses inside the same tile do not touch the cache at all.
+    * Pinning a tile the calling thread has used recently does not need any
+    * locking either (see @ref mem::TileCache), so short-lived iterators are cheap.
+    * An iterator must only be used (and destroyed) by the thread that accessed it first.
+    * Positions outside the image are clamped to the nearest edge pixel.
+    * @param storage_T The storage type (e.g. @ref mem::Storage::rgb_8_inter).
+    */
+    template <mem::Storage::type storage_T>
+    class TiledImageIterR
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief The type of the tile cache.
+            */
+            typedef mem::TileCache<storage_T> tile_cache_t;
+
+        public:
+            /**
+            * @brief The channel storage type for this image (e.g., uint8_t).
+            */
+            typedef typename tile_cache_t::channel_storage_t channel_storage_t;
+
+        public:
+            /**
+            * @brief Constructor.
+            * @param[in] cache The tile cache.
+            * @param[in] x     The x coordinate.
+            * @param[in] y     The y coordinate.
+            */
+            TiledImageIterR(tile_cache_t& cache, coord_t x, coord_t y);
+
+        public:
+            /**
+            * @brief Copy constructor.
+            * @param[in] orig The original iterator.
+            */
+            TiledImageIterR(const TiledImageIterR<storage_T>& orig);
+
+        public:
+            /**
+            * @brief Assignment operator.
+            * @param[in] orig The original iterator.
+            * @return Reference to this iterator.
+            */
+            TiledImageIterR<storage_T>& operator=(const TiledImageIterR<storage_T>& orig);
+
+        public:
+            /**
+            * @brief Destructor.
+            */
+            ~TiledImageIterR();
+
+        public:
+            /**
+            * @brief Read the value for the given channel.
+            * @param channel The channel.
+            * @return The value.
+            */
+            inline channel_storage_t get_px_val(Channel::type channel);
+
+        public:
+            /**
+            * @brief Read a span of pixels (starting at the current position) into
+            * a structure-of-arrays buffer.
+            * @details See @ref MemImageIterR::read_span() for the buffer layout. Each
+            * tile touched by the span is pinned once, and the values are read from
+            * the pinned tile without entering the cache's critical section.
+            * The iterator position is not changed.
+            * @param[in]  num        The number of pixels.
+            * @param[out] planes     The destination buffer (e.g., of type float or double).
+            * @param[in]  plane_size The distance between the channel planes (at least num).
+            */
+            template <typename value_T>
+            void read_span(coord_t num, value_T* planes, size_t plane_size);
+
+        public:
+            /**
+            * @brief Increment the current position (horizontally).
+            */
+            void inc_x();
+
+        public:
+            /**
+            * @brief Decrement the current position (horizontally).
+            */
+            void dec_x();
+
+        public:
+            /**
+            * @brief Increment the current position (vertically).
+            */
+            void inc_y();
+
+        public:
+            /**
+            * @brief Decrement the current position (vertically).
+            */
+            void dec_y();
+
+        public:
+            /**
+            * @brief Set the pixel offset.
+            * @param[in] px_offs The new pixel offset (as returned by
+            * @ref TiledImageViewR::get_px_offs()).
+            */
+            void set_px_offs(size_t px_offs);
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief Pin the tile containing the given (clamped) position.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            */
+            void switch_tile(coord_t x, coord_t y);
+
+        private:
+            /**
+            * @brief Get the offset of the given channel inside a pixel.
+            * @param[in] channel The channel.
+            * @return The offset.
+            */
+            size_t channel_offs(Channel::type channel) const;
+
+        private:
+            /**
+            * @brief Reset the cached tile information (no tile pinned).
+            */
+            void reset_tile();
+
+        private:
+            /**
+            * @brief The tile cache.
+            */
+            tile_cache_t* cache_;
+
+        private:
+            /**
+            * @brief The image width.
+            */
+            coord_t width_;
+
+        private:
+            /**
+            * @brief The image height.
+            */
+            coord_t height_;
+
+        private:
+            /**
+            * @brief The current x position.
+            */
+            coord_t x_;
+
+        private:
+            /**
+            * @brief The current y position.
+            */
+            coord_t y_;
+
+        private:
+            /**
+            * @brief The index of the pinned tile (or tile_cache_t::no_tile).
+            */
+            size_t tile_idx_;
+
+        private:
+            /**
+            * @brief The cache's thread slot holding the pin.
+            */
+            size_t pin_slot_;
+
+        private:
+            /**
+            * @brief The data of the pinned tile.
+            */
+            const channel_storage_t* tile_data_;
+
+        private:
+            /**
+            * @brief The left edge of the pinned tile.
+            */
+            coord_t tile_x0_;
+
+        private:
+            /**
+            * @brief The upper edge of the pinned tile.
+            */
+            coord_t tile_y0_;
+
+        private:
+            /**
+            * @brief The right edge of the pinned tile (exclusive).
+            */
+            coord_t tile_x1_;
+
+        private:
+            /**
+            * @brief The lower edge of the pinned tile (exclusive).
+            */
+            coord_t tile_y1_;
+
+        private:
+            /**
+            * @brief The step between adjacent pixels inside a tile.
+            */
+            size_t step_;
+
+        private:
+            /**
+            * @brief The step between lines inside a tile.
+            */
+            size_t line_step_;
+
+        private:
+            /**
+            * @brief The offset of the 'red' channel.
+            */
+            size_t r_offs_;
+
+        private:
+            /**
+            * @brief The offset of the 'green' channel.
+            */
+            size_t g_offs_;
+
+        private:
+            /**
+            * @brief The offset of the 'blue' channel.
+            */
+            size_t b_offs_;
+
+        private:
+            /**
+            * @brief The offset of the 'alpha' channel.
+            */
+            size_t a_offs_;
+
+    }; // template class TiledImageIterR<>
+
+    ///@endcond
+
+} // namespace phtr
+
+#include <photoropter/tiled_image_iter_r.tpl.h>
+
+#endif // PHTR_TILED_IMAGE_ITER_R_H__
@@ -0,0 +1,266 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+namespace phtr
+{
+
+    ///@cond PROTECTED
+
+    template <mem::Storage::type storage_T>
+    TiledImageIterR<storage_T>::TiledImageIterR
+    (tile_cache_t& cache, coord_t x, coord_t y)
+            : cache_(&cache),
+            width_(cache.width()),
+            height_(cache.height()),
+            x_(x),
+            y_(y),
+            step_(cache.tile_storage_info().step),
+            line_step_(cache.tile_storage_info().line_step),
+            r_offs_(cache.tile_storage_info().r_offs),
+            g_offs_(cache.tile_storage_info().g_offs),
+            b_offs_(cache.tile_storage_info().b_offs),
+            a_offs_(cache.tile_storage_info().a_offs)
+    {
+        // tiles are pinned lazily on first access
+        reset_tile();
+    }
+
+    template <mem::Storage::type storage_T>
+    TiledImageIterR<storage_T>::TiledImageIterR
+    (const TiledImageIterR<storage_T>& orig)
+            : cache_(orig.cache_),
+            width_(orig.width_),
+            height_(orig.height_),
+            x_(orig.x_),
+            y_(orig.y_),
+            step_(orig.step_),
+            line_step_(orig.line_step_),
+            r_offs_(orig.r_offs_),
+            g_offs_(orig.g_offs_),
+            b_offs_(orig.b_offs_),
+            a_offs_(orig.a_offs_)
+    {
+        reset_tile();
+    }
+
+    template <mem::Storage::type storage_T>
+    TiledImageIterR<storage_T>&
+    TiledImageIterR<storage_T>::operator=
+    (const TiledImageIterR<storage_T>& orig)
+    {
+        if (this != &orig)
+        {
+            if (tile_idx_ != tile_cache_t::no_tile)
+            {
+                cache_->unpin_tile(tile_idx_, pin_slot_);
+            }
+
+            cache_ = orig.cache_;
+            width_ = orig.width_;
+            height_ = orig.height_;
+            x_ = orig.x_;
+            y_ = orig.y_;
+            step_ = orig.step_;
+            line_step_ = orig.line_step_;
+            r_offs_ = orig.r_offs_;
+            g_offs_ = orig.g_offs_;
+            b_offs_ = orig.b_offs_;
+            a_offs_ = orig.a_offs_;
+
+            reset_tile();
+        }
+
+        return *this;
+    }
+
+    template <mem::Storage::type storage_T>
+    TiledImageIterR<storage_T>::~TiledImageIterR
+    ()
+    {
+        if (tile_idx_ != tile_cache_t::no_tile)
+        {
+            cache_->unpin_tile(tile_idx_, pin_slot_);
+        }
+    }
+
+    template <mem::Storage::type storage_T>
+    typename TiledImageIterR<storage_T>::channel_storage_t
+    TiledImageIterR<storage_T>::get_px_val(Channel::type channel)
+    {
+        coord_t x = (x_ < width_) ? x_ : width_ - 1;
+        coord_t y = (y_ < height_) ? y_ : height_ - 1;
+
+        if ((x < tile_x0_) || (x >= tile_x1_) || (y < tile_y0_) || (y >= tile_y1_))
+        {
+            switch_tile(x, y);
+        }
+
+        size_t offs = (y - tile_y0_) * line_step_ + (x - tile_x0_) * step_;
+
+        return tile_data_[offs + channel_offs(channel)];
+    }
+
+    template <mem::Storage::type storage_T> template <typename value_T>
+    void
+    TiledImageIterR<storage_T>::read_span
+    (coord_t num, value_T* planes, size_t plane_size)
+    {
+        typedef typename tile_cache_t::storage_info_t::mem_layout_t mem_layout_t;
+        typedef typename mem_layout_t::colour_tuple_t colour_tuple_t;
+
+        size_t chan_offs[colour_tuple_t::num_vals];
+        for (size_t i = 0; i < colour_tuple_t::num_vals; ++i)
+        {
+            chan_offs[i] = channel_offs(mem_layout_t::channel_type[i]);
+        }
+
+        const coord_t y = (y_ < height_) ? y_ : height_ - 1;
+
+        for (coord_t k = 0; k < num; ++k)
+        {
+            coord_t x = (x_ + k < width_) ? x_ + k : width_ - 1;
+
+            // (only entering a new tile involves the cache)
+            if ((x < tile_x0_) || (x >= tile_x1_) || (y < tile_y0_) || (y >= tile_y1_))
+            {
+                switch_tile(x, y);
+            }
+
+            const channel_storage_t* px = tile_data_ + (y - tile_y0_) * line_step_ + (x - tile_x0_) * step_;
+
+            for (size_t i = 0; i < colour_tuple_t::num_vals; ++i)
+            {
+                planes[i * plane_size + k] = static_cast<value_T>(px[chan_offs[i]]);
+            }
+        }
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::inc_x
+    ()
+    {
+        ++x_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::dec_x
+    ()
+    {
+        --x_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::inc_y
+    ()
+    {
+        ++y_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::dec_y
+    ()
+    {
+        --y_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::set_px_offs(size_t px_offs)
+    {
+        x_ = px_offs % width_;
+        y_ = px_offs / width_;
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::switch_tile
+    (coord_t x, coord_t y)
+    {
+        size_t new_idx = cache_->tile_index(x, y);
+
+        if (tile_idx_ != tile_cache_t::no_tile)
+        {
+            cache_->unpin_tile(tile_idx_, pin_slot_);
+            reset_tile();
+        }
+
+        tile_data_ = cache_->pin_tile(new_idx, pin_slot_);
+        tile_idx_ = new_idx;
+
+        coord_t tile_w = cache_->tile_width();
+        coord_t tile_h = cache_->tile_height();
+
+        tile_x0_ = (x / tile_w) * tile_w;
+        tile_y0_ = (y / tile_h) * tile_h;
+        tile_x1_ = tile_x0_ + tile_w;
+        tile_y1_ = tile_y0_ + tile_h;
+    }
+
+    template <mem::Storage::type storage_T>
+    size_t
+    TiledImageIterR<storage_T>::channel_offs
+    (Channel::type channel) const
+    {
+        switch (channel)
+        {
+            case Channel::red:
+            default:
+                return r_offs_;
+                break;
+
+            case Channel::green:
+                return g_offs_;
+                break;
+
+            case Channel::blue:
+                return b_offs_;
+                break;
+
+            case Channel::alpha:
+                return a_offs_;
+                break;
+        }
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageIterR<storage_T>::reset_tile
+    ()
+    {
+        tile_idx_ = tile_cache_t::no_tile;
+        pin_slot_ = tile_cache_t::no_slot;
+        tile_data_ = 0;
+        tile_x0_ = tile_y0_ = tile_x1_ = tile_y1_ = 0;
+    }
+
+    ///@endcond
+
+} // namespace phtr
@@ -0,0 +1,228 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_TILED_IMAGE_VIEW_R_H__
+#define PHTR_TILED_IMAGE_VIEW_R_H__
+
+#include <photoropter/types.h>
+#include <photoropter/tile_provider.h>
+#include <photoropter/tiled_image_iter_r.h>
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/channel_type.h>
+#include <photoropter/mem/mem_storage_info.h>
+#include <photoropter/mem/tile_cache.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Class template implementing a (reading) 'image view' of an image
+    * that is loaded tile by tile on demand.
+    * @details The image data is requested from an @ref ITileProvider in tiles
+    * of fixed size and kept in an LRU cache with a configurable memory budget.
+    * This way, images that do not fit into memory as a whole can be used as the
+    * source of an @ref ImageTransform (provided the geometric corrections do not
+    * scatter the accesses too widely). The view can be used wherever a
+    * @ref MemImageViewR is expected by the interpolators.
+    * @param storage_T The storage type (e.g. @ref mem::Storage::rgb_8_inter).
+    */
+    template <mem::Storage::type storage_T>
+    class TiledImageViewR
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief The type of the internal storage info object.
+            */
+            typedef typename mem::MemStorageInfo<storage_T> storage_info_t;
+
+        public:
+            /**
+            * @brief The channel storage type for this image (e.g., uint8_t).
+            */
+            typedef typename storage_info_t::channel_storage_t channel_storage_t;
+
+        public:
+            /**
+            * @brief The type of the internal iterator.
+            */
+            typedef typename phtr::TiledImageIterR<storage_T> iter_t;
+
+        public:
+            /**
+            * @brief Constructor.
+            * @param[in] provider    The tile provider.
+            * @param[in] width       The image width.
+            * @param[in] height      The image height.
+            * @param[in] tile_width  The tile width.
+            * @param[in] tile_height The tile height.
+            * @param[in] cache_size  The memory budget of the tile cache (in bytes).
+            */
+            TiledImageViewR(ITileProvider& provider,
+                            coord_t width,
+                            coord_t height,
+                            coord_t tile_width = 256,
+                            coord_t tile_height = 256,
+                            size_t cache_size = 64 * 1024 * 1024);
+
+        public:
+            /**
+            * @brief Get the image width.
+            * @return The width.
+            */
+            coord_t width() const;
+
+        public:
+            /**
+            * @brief Get the image height.
+            * @return The height.
+            */
+            coord_t height() const;
+
+        public:
+            /**
+            * @brief Determine the 'pixel offset' to a given set of coordinates.
+            * @note For tiled views, this is simply the linear pixel index.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The offset
+            */
+            size_t get_px_offs(coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Read the given channel value.
+            * @note Every call pins and releases a tile in the cache (which only needs
+            * locking if the calling thread has not used the tile recently); use an
+            * iterator (see get_iter()) or read_span() to read several values.
+            * @param[in] chan The channel.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The channel value.
+            */
+            inline channel_storage_t
+            get_px_val(Channel::type chan, coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Read a span of pixels of one line into a structure-of-arrays buffer.
+            * @details See @ref MemImageIterR::read_span() for the buffer layout. The
+            * values are read through an iterator, i.e. each tile is only pinned once.
+            * @param[in]  x          The x coordinate of the first pixel.
+            * @param[in]  y          The y coordinate.
+            * @param[in]  num        The number of pixels.
+            * @param[out] planes     The destination buffer (e.g., of type float or double).
+            * @param[in]  plane_size The distance between the channel planes (at least num).
+            */
+            template <typename value_T>
+            void read_span(coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const;
+
+        public:
+            /**
+            * @brief Get a pixel iterator.
+            * @param[in] x The x coordinate.
+            * @param[in] y The y coordinate.
+            * @return The iterator.
+            */
+            iter_t get_iter(coord_t x, coord_t y) const;
+
+        public:
+            /**
+            * @brief Set the aspect ratio of the image.
+            * @param aspect_ratio The new aspect ratio.
+            */
+            void set_aspect_ratio(interp_coord_t aspect_ratio);
+
+        public:
+            /**
+            * @brief Get the aspect ratio of the image.
+            * @note The ratio is automatically calculated when the image is created,
+            * but can be overridden using @ref set_aspect_ratio().
+            * @return The aspect ratio.
+            */
+            interp_coord_t aspect_ratio() const;
+
+        public:
+            /**
+            * @brief Get the number of tiles that were requested from the provider so far.
+            * @details This can be used to tune tile and cache sizes: ideally, every
+            * tile is loaded exactly once.
+            * @return The number of tile loads.
+            */
+            size_t tile_loads() const;
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief Copy constructor (disabled).
+            */
+            TiledImageViewR(const TiledImageViewR<storage_T>& orig);
+
+        private:
+            /**
+            * @brief Assignment operator (disabled).
+            */
+            TiledImageViewR<storage_T>& operator=(const TiledImageViewR<storage_T>& orig);
+
+        private:
+            /**
+            * @brief The image width.
+            */
+            const coord_t width_;
+
+        private:
+            /**
+            * @brief The image height.
+            */
+            const coord_t height_;
+
+        private:
+            /**
+            * @brief The image's aspect ratio.
+            */
+            interp_coord_t aspect_ratio_;
+
+        private:
+            /**
+            * @brief The tile cache.
+            */
+            mutable mem::TileCache<storage_T> cache_;
+
+    }; // template class TiledImageViewR<>
+
+} // namespace phtr
+
+#include <photoropter/tiled_image_view_r.tpl.h>
+
+#endif // PHTR_TILED_IMAGE_VIEW_R_H__
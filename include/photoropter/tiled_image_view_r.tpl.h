@@ -0,0 +1,146 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+namespace phtr
+{
+
+    template <mem::Storage::type storage_T>
+    TiledImageViewR<storage_T>::
+    TiledImageViewR
+    (ITileProvider& provider, coord_t width, coord_t height,
+     coord_t tile_width, coord_t tile_height, size_t cache_size)
+            : width_(width),
+            height_(height),
+            aspect_ratio_(static_cast<interp_coord_t>(width) / static_cast<interp_coord_t>(height)),
+            cache_(provider, width, height, tile_width, tile_height, cache_size)
+    {
+        //NIL
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    TiledImageViewR<storage_T>::width
+    () const
+    {
+        return width_;
+    }
+
+    template <mem::Storage::type storage_T>
+    coord_t
+    TiledImageViewR<storage_T>::height
+    () const
+    {
+        return height_;
+    }
+
+    template <mem::Storage::type storage_T>
+    size_t
+    TiledImageViewR<storage_T>::get_px_offs
+    (coord_t x, coord_t y) const
+    {
+        return (y * width_) + x;
+    }
+
+    template <mem::Storage::type storage_T>
+    typename TiledImageViewR<storage_T>::channel_storage_t
+    TiledImageViewR<storage_T>::
+    get_px_val
+    (Channel::type chan, coord_t x, coord_t y) const
+    {
+        // clamp to image area
+        x = (x < width_) ? x : width_ - 1;
+        y = (y < height_) ? y : height_ - 1;
+
+        const storage_info_t& info = cache_.tile_storage_info();
+
+        size_t offs = (y % cache_.tile_height()) * info.line_step
+                      + (x % cache_.tile_width()) * info.step;
+
+        switch (chan)
+        {
+            case Channel::red:
+            default:
+                offs += info.r_offs;
+                break;
+
+            case Channel::green:
+                offs += info.g_offs;
+                break;
+
+            case Channel::blue:
+                offs += info.b_offs;
+                break;
+
+            case Channel::alpha:
+                offs += info.a_offs;
+                break;
+        }
+
+        return cache_.get_val(cache_.tile_index(x, y), offs);
+    }
+
+    template <mem::Storage::type storage_T> template <typename value_T>
+    void
+    TiledImageViewR<storage_T>::
+    read_span
+    (coord_t x, coord_t y, coord_t num, value_T* planes, size_t plane_size) const
+    {
+        // pin each tile once instead of going through the cache per value
+        get_iter(x, y).read_span(num, planes, plane_size);
+    }
+
+    template <mem::Storage::type storage_T>
+    typename TiledImageViewR<storage_T>::iter_t
+    TiledImageViewR<storage_T>::
+    get_iter
+    (coord_t x, coord_t y) const
+    {
+        return iter_t(cache_, x, y);
+    }
+
+    template <mem::Storage::type storage_T>
+    void
+    TiledImageViewR<storage_T>::set_aspect_ratio(interp_coord_t aspect_ratio)
+    {
+        aspect_ratio_ = aspect_ratio;
+    }
+
+    template <mem::Storage::type storage_T>
+    interp_coord_t
+    TiledImageViewR<storage_T>::aspect_ratio() const
+    {
+        return aspect_ratio_;
+    }
+
+    template <mem::Storage::type storage_T>
+    size_t
+    TiledImageViewR<storage_T>::tile_loads() const
+    {
+        return cache_.tile_loads();
+    }
+
+} // namespace phtr
@@ -0,0 +1,454 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#ifndef PHTR_TRANSFORM_STATS_H__
+#define PHTR_TRANSFORM_STATS_H__
+
+extern "C"
+{
+#include <stdint.h>
+}
+
+#include <photoropter/types.h>
+#include <photoropter/cost_map.h>
+
+namespace phtr
+{
+
+    /**
+    * @brief Statistics collected during ImageTransform::do_transform().
+    * @details The statistics are only gathered if the library and the client code
+    * are compiled with @c PHTR_INSTRUMENT defined (CMake option @c PHTR_INSTRUMENT).
+    * Otherwise, the instrumentation compiles to nothing and all values stay zero
+    * (with @ref enabled set to 'false').
+    * @note Stage times are summed over all threads, i.e. with several threads
+    * their sum exceeds the wall time of the transformation.
+    */
+    struct TransformStats
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief Struct listing the stages of the transformation.
+            * @note The struct contains an enum which defines the actual stages.
+            */
+            struct Stage
+            {
+                /**
+                * @brief The enum holding the actual stages.
+                */
+                enum type
+                {
+                    /**
+                    * @brief Geometric corrections affecting all channels (PixelCorrectionQueue).
+                    */
+                    pixel_queue,
+                    /**
+                    * @brief Per-channel geometric corrections (SubpixelCorrectionQueue).
+                    */
+                    subpixel_queue,
+                    /**
+                    * @brief Colour correction factors (ColourCorrectionQueue).
+                    */
+                    colour_queue,
+                    /**
+                    * @brief Reading/interpolating the source pixels.
+                    */
+                    interpolation,
+                    /**
+                    * @brief Linearisation (gamma) and accumulation of the channel values.
+                    */
+                    normalise,
+                    /**
+                    * @brief Conversion to output codes (inverse gamma, dithering).
+                    */
+                    encode,
+                    /**
+                    * @brief Writing the output codes to the image view.
+                    */
+                    write,
+                    /**
+                    * @brief The number of stages (not a stage itself).
+                    */
+                    num_stages
+                };
+            };
+
+        public:
+            /**
+            * @brief Constructor.
+            * @details All values are set to zero.
+            */
+            TransformStats();
+
+        public:
+            /**
+            * @brief Reset all values to zero.
+            * @note The geometry of the cost map is retained.
+            */
+            void clear();
+
+        public:
+            /**
+            * @brief Add the values of another statistics object (e.g. of another thread).
+            * @param[in] other The statistics to be added.
+            * @return Reference to this object.
+            */
+            TransformStats& operator+=(const TransformStats& other);
+
+        public:
+            /**
+            * @brief Get the time spent in a given stage.
+            * @param[in] stage The stage.
+            * @return The time in seconds (summed over all threads).
+            */
+            double stage_time(Stage::type stage) const;
+
+        public:
+            /**
+            * @brief Get the time spent in all stages.
+            * @return The time in seconds (summed over all threads).
+            */
+            double total_stage_time() const;
+
+        public:
+            /**
+            * @brief Get a printable name for a stage.
+            * @param[in] stage The stage.
+            * @return The name.
+            */
+            static const char* stage_name(Stage::type stage);
+
+        public:
+            /**
+            * @brief 'true' if the statistics are actually collected (i.e., if
+            * @c PHTR_INSTRUMENT was defined).
+            */
+            bool enabled;
+
+        public:
+            /**
+            * @brief Clock ticks spent in each stage (summed over all threads).
+            * @details On x86 compilers supporting it, these are time stamp counter cycles;
+            * otherwise, they are std::clock() ticks.
+            */
+            uint64_t ticks[Stage::num_stages];
+
+        public:
+            /**
+            * @brief Clock ticks per second, as measured during the transformation.
+            */
+            double ticks_per_second;
+
+        public:
+            /**
+            * @brief Wall time of the transformation(s) in seconds.
+            */
+            double wall_time;
+
+        public:
+            /**
+            * @brief Number of output pixels written.
+            */
+            uint64_t pixels;
+
+        public:
+            /**
+            * @brief Number of source samples interpolated (i.e., pixels times
+            * the square of the oversampling factor).
+            */
+            uint64_t samples;
+
+        public:
+            /**
+            * @brief Number of samples for which at least one channel lies outside
+            * the source image.
+            */
+            uint64_t out_of_bounds;
+
+        public:
+            /**
+            * @brief Number of transformations accumulated.
+            */
+            unsigned int num_transforms;
+
+        public:
+            /**
+            * @brief Maximal number of threads used.
+            */
+            unsigned int num_threads;
+
+        public:
+            /**
+            * @brief Ticks spent per output tile (empty unless enabled
+            * through IImageTransform::set_cost_map_tile_size()).
+            */
+            CostMap cost_map;
+
+    }; // struct TransformStats
+
+    /**
+    * @brief Per-thread stage timer used inside the transformation loops.
+    * @details Each call to lap() attributes the ticks since the previous call
+    * (or start()) to the given stage. Without @c PHTR_INSTRUMENT, all member
+    * functions are empty.
+    */
+    class StageTimer
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief Constructor.
+            * @param[in] stats The (thread-local) statistics object to be filled.
+            */
+            inline explicit StageTimer(TransformStats& stats);
+
+        public:
+            /**
+            * @brief (Re-)start timing, discarding the ticks since the last lap.
+            */
+            inline void start();
+
+        public:
+            /**
+            * @brief Attribute the ticks since the last call to the given stage.
+            * @param[in] stage The stage.
+            */
+            inline void lap(TransformStats::Stage::type stage);
+
+        public:
+            /**
+            * @brief Attribute the ticks since the last pixel to the cost map.
+            * @param[in] x The horizontal position of the pixel.
+            * @param[in] y The vertical position of the pixel.
+            */
+            inline void pixel_done(coord_t x, coord_t y);
+
+        public:
+            /**
+            * @brief Attribute the ticks since the last pixel (or span) to a span of pixels in the cost map.
+            * @param[in] x0  The first pixel of the span.
+            * @param[in] y   The line.
+            * @param[in] num The number of pixels.
+            */
+            inline void span_done(coord_t x0, coord_t y, coord_t num);
+
+        public:
+            /**
+            * @brief Count a number of output pixels.
+            * @param[in] num The number of pixels.
+            */
+            inline void count_pixels(coord_t num);
+
+        public:
+            /**
+            * @brief Count a number of samples read directly (i.e., inside the source image).
+            * @param[in] num The number of samples.
+            */
+            inline void count_samples(coord_t num);
+
+        public:
+            /**
+            * @brief Count an interpolated sample.
+            * @param[in] coords The source coordinates of the sample.
+            * @param[in] aspect_ratio The aspect ratio of the source image.
+            */
+            template <typename coord_tuple_T>
+            inline void count_sample(const coord_tuple_T& coords, interp_coord_t aspect_ratio);
+
+        public:
+            /**
+            * @brief Read the tick counter.
+            * @return The current tick count.
+            */
+            static inline uint64_t ticks();
+
+        public:
+            /**
+            * @brief Get the fixed tick rate of the tick counter, if known.
+            * @return The number of ticks per second, or 0 if the rate has
+            * to be calibrated (time stamp counter).
+            */
+            static inline double fixed_tick_rate();
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief The statistics object to be filled.
+            */
+            TransformStats& stats_;
+
+        private:
+            /**
+            * @brief Tick count at the last call to start() or lap().
+            */
+            uint64_t last_;
+
+        private:
+            /**
+            * @brief Tick count at the last call to start(), pixel_done() or span_done().
+            */
+            uint64_t mark_;
+
+    }; // class StageTimer
+
+    /**
+    * @brief Statistics recorder for one call to ImageTransform::do_transform().
+    * @details The constructor and destructor measure the wall time and calibrate
+    * the tick counter; merge() adds the thread-local statistics in a thread-safe way.
+    * Without @c PHTR_INSTRUMENT, all member functions are empty.
+    */
+    class StatsRecorder
+    {
+
+            /* ****************************************
+             * public interface
+             * **************************************** */
+
+        public:
+            /**
+            * @brief Constructor.
+            * @param[in] stats The statistics object of the transformation.
+            */
+            explicit StatsRecorder(TransformStats& stats);
+
+        public:
+            /**
+            * @brief Destructor.
+            * @details Adds the wall time and updates the tick rate.
+            */
+            ~StatsRecorder();
+
+        public:
+            /**
+            * @brief Enable the cost map for the current transformation.
+            * @details If the geometry differs from the one of the accumulated map,
+            * the accumulated map is reset.
+            * @param[in] width       The width of the output image.
+            * @param[in] height      The height of the output image.
+            * @param[in] tile_width  The tile width (0 disables the cost map).
+            * @param[in] tile_height The tile height (0 disables the cost map).
+            */
+            void set_cost_map(coord_t width, coord_t height, coord_t tile_width, coord_t tile_height);
+
+        public:
+            /**
+            * @brief Prepare thread-local statistics (i.e., set up the cost map).
+            * @param[out] thread_stats The thread-local statistics.
+            */
+            void prepare(TransformStats& thread_stats) const;
+
+        public:
+            /**
+            * @brief Add thread-local statistics.
+            * @note This may be called concurrently from inside a parallel region.
+            * @param[in] thread_stats The thread-local statistics.
+            */
+            void merge(const TransformStats& thread_stats);
+
+            /* ****************************************
+             * internals
+             * **************************************** */
+
+        private:
+            /**
+            * @brief Copy constructor (not implemented).
+            */
+            StatsRecorder(const StatsRecorder&);
+
+        private:
+            /**
+            * @brief Assignment operator (not implemented).
+            */
+            StatsRecorder& operator=(const StatsRecorder&);
+
+        private:
+            /**
+            * @brief The statistics object of the transformation.
+            */
+            TransformStats& stats_;
+
+        private:
+            /**
+            * @brief Wall time at construction.
+            */
+            double t0_;
+
+        private:
+            /**
+            * @brief Tick count at construction.
+            */
+            uint64_t ticks0_;
+
+        private:
+            /**
+            * @brief Number of thread-local statistics merged.
+            */
+            unsigned int num_merged_;
+
+        private:
+            /**
+            * @brief Cost map geometry: image width.
+            */
+            coord_t map_width_;
+
+        private:
+            /**
+            * @brief Cost map geometry: image height.
+            */
+            coord_t map_height_;
+
+        private:
+            /**
+            * @brief Cost map geometry: tile width (0 if disabled).
+            */
+            coord_t map_tile_width_;
+
+        private:
+            /**
+            * @brief Cost map geometry: tile height (0 if disabled).
+            */
+            coord_t map_tile_height_;
+
+    }; // class StatsRecorder
+
+} // namespace phtr
+
+#include <photoropter/transform_stats.inl.h>
+
+#endif // PHTR_TRANSFORM_STATS_H__
@@ -0,0 +1,180 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <ctime>
+#include <cmath>
+
+#if defined(PHTR_INSTRUMENT) && defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace phtr
+{
+
+    StageTimer::
+    StageTimer(TransformStats& stats)
+            : stats_(stats),
+            last_(0),
+            mark_(0)
+    {
+#ifdef PHTR_INSTRUMENT
+        stats_.enabled = true;
+        last_ = ticks();
+        mark_ = last_;
+#endif
+    }
+
+    void
+    StageTimer::
+    start()
+    {
+#ifdef PHTR_INSTRUMENT
+        last_ = ticks();
+        mark_ = last_;
+#endif
+    }
+
+    void
+    StageTimer::
+    lap(TransformStats::Stage::type stage)
+    {
+#ifdef PHTR_INSTRUMENT
+        uint64_t now = ticks();
+        stats_.ticks[stage] += now - last_;
+        last_ = now;
+#else
+        (void)stage;
+#endif
+    }
+
+    void
+    StageTimer::
+    pixel_done(coord_t x, coord_t y)
+    {
+#ifdef PHTR_INSTRUMENT
+        if (!stats_.cost_map.empty())
+        {
+            stats_.cost_map.add(x, y, last_ - mark_);
+        }
+        mark_ = last_;
+#else
+        (void)x;
+        (void)y;
+#endif
+    }
+
+    void
+    StageTimer::
+    span_done(coord_t x0, coord_t y, coord_t num)
+    {
+#ifdef PHTR_INSTRUMENT
+        if (!stats_.cost_map.empty())
+        {
+            stats_.cost_map.add_span(x0, y, num, last_ - mark_);
+        }
+        mark_ = last_;
+#else
+        (void)x0;
+        (void)y;
+        (void)num;
+#endif
+    }
+
+    void
+    StageTimer::
+    count_pixels(coord_t num)
+    {
+#ifdef PHTR_INSTRUMENT
+        stats_.pixels += num;
+#else
+        (void)num;
+#endif
+    }
+
+    void
+    StageTimer::
+    count_samples(coord_t num)
+    {
+#ifdef PHTR_INSTRUMENT
+        stats_.samples += num;
+#else
+        (void)num;
+#endif
+    }
+
+    template <typename coord_tuple_T>
+    void
+    StageTimer::
+    count_sample(const coord_tuple_T& coords, interp_coord_t aspect_ratio)
+    {
+#ifdef PHTR_INSTRUMENT
+        ++stats_.samples;
+
+        for (size_t i = 0; i < coord_tuple_T::channel_order_t::colour_tuple_t::num_vals; ++i)
+        {
+            if ((std::fabs(coords.x[i]) > aspect_ratio) || (std::fabs(coords.y[i]) > 1.0))
+            {
+                ++stats_.out_of_bounds;
+                break;
+            }
+        }
+#else
+        (void)coords;
+        (void)aspect_ratio;
+#endif
+    }
+
+    uint64_t
+    StageTimer::
+    ticks()
+    {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        uint32_t lo(0);
+        uint32_t hi(0);
+        __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+        return (static_cast<uint64_t>(hi) << 32) | static_cast<uint64_t>(lo);
+#elif defined(PHTR_INSTRUMENT) && defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        return static_cast<uint64_t>(__rdtsc());
+#else
+        return static_cast<uint64_t>(std::clock());
+#endif
+    }
+
+    double
+    StageTimer::
+    fixed_tick_rate()
+    {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        return 0.0;
+#elif defined(PHTR_INSTRUMENT) && defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        return 0.0;
+#else
+        return static_cast<double>(CLOCKS_PER_SEC);
+#endif
+    }
+
+} // namespace phtr
@@ -25,6 +25,7 @@ THE SOFTWARE.
 */
 
 #include <list>
+#include <cmath>
 
 #include <photoropter/colour_correction_queue.h>
 
@@ -32,13 +33,20 @@ namespace phtr
 {
 
     ColourCorrectionQueue::ColourCorrectionQueue()
-            : n_models_(0)
+            : n_models_(0),
+            exposure_(0.0)
     {
-        //NIL
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            wb_gain_[i] = 1.0;
+        }
+
+        update_gains();
     }
 
     ColourCorrectionQueue::ColourCorrectionQueue(const ColourCorrectionQueue& orig)
-            : n_models_(0)
+            : n_models_(0),
+            exposure_(orig.exposure_)
     {
         n_models_ = static_cast<unsigned short>(orig.correction_model_.size());
         correction_model_.resize(n_models_);
@@ -47,6 +55,13 @@ namespace phtr
         {
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
+
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            wb_gain_[i] = orig.wb_gain_[i];
+        }
+
+        update_gains();
     }
 
     ColourCorrectionQueue::~ColourCorrectionQueue()
@@ -66,6 +81,14 @@ namespace phtr
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
 
+        exposure_ = orig.exposure_;
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            wb_gain_[i] = orig.wb_gain_[i];
+        }
+
+        update_gains();
+
         return *this;
     }
 
@@ -95,4 +118,42 @@ namespace phtr
         return *new_mod;
     }
 
+    void ColourCorrectionQueue::set_exposure(double ev)
+    {
+        exposure_ = ev;
+        update_gains();
+    }
+
+    double ColourCorrectionQueue::exposure() const
+    {
+        return exposure_;
+    }
+
+    void ColourCorrectionQueue::set_white_balance(double gain_r, double gain_g, double gain_b)
+    {
+        wb_gain_[Channel::red] = gain_r;
+        wb_gain_[Channel::green] = gain_g;
+        wb_gain_[Channel::blue] = gain_b;
+        update_gains();
+    }
+
+    void ColourCorrectionQueue::get_white_balance(double& gain_r, double& gain_g, double& gain_b) const
+    {
+        gain_r = wb_gain_[Channel::red];
+        gain_g = wb_gain_[Channel::green];
+        gain_b = wb_gain_[Channel::blue];
+    }
+
+    void ColourCorrectionQueue::update_gains()
+    {
+        const double exp_gain = std::pow(2.0, exposure_);
+
+        gain_[Channel::red] = exp_gain * wb_gain_[Channel::red];
+        gain_[Channel::green] = exp_gain * wb_gain_[Channel::green];
+        gain_[Channel::blue] = exp_gain * wb_gain_[Channel::blue];
+
+        // the alpha channel is not subject to colour corrections
+        gain_[Channel::alpha] = 1.0;
+    }
+
 } // namespace phtr
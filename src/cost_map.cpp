@@ -0,0 +1,206 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <algorithm>
+#include <cassert>
+
+#include <photoropter/cost_map.h>
+
+namespace phtr
+{
+
+    CostMap::
+    CostMap()
+            : tile_width_(1),
+            tile_height_(1),
+            cells_x_(0),
+            cells_y_(0)
+    {
+        //NIL
+    }
+
+    void
+    CostMap::
+    init(coord_t width, coord_t height, coord_t tile_width, coord_t tile_height)
+    {
+        assert(tile_width > 0 && tile_height > 0);
+
+        tile_width_ = tile_width;
+        tile_height_ = tile_height;
+        cells_x_ = (width + tile_width - 1) / tile_width;
+        cells_y_ = (height + tile_height - 1) / tile_height;
+
+        cells_.assign(cells_x_ * cells_y_, 0);
+    }
+
+    void
+    CostMap::
+    clear()
+    {
+        std::fill(cells_.begin(), cells_.end(), 0);
+    }
+
+    bool
+    CostMap::
+    empty() const
+    {
+        return cells_.empty();
+    }
+
+    void
+    CostMap::
+    add_span(coord_t x0, coord_t y, coord_t num, uint64_t ticks)
+    {
+        if (num == 0)
+        {
+            return;
+        }
+
+        coord_t cy = y / tile_height_;
+        assert(cy < cells_y_);
+
+        coord_t x_limit = x0 + num;
+        coord_t x = x0;
+        uint64_t remaining = ticks;
+
+        while (x < x_limit)
+        {
+            coord_t cx = x / tile_width_;
+            coord_t cell_limit = std::min((cx + 1) * tile_width_, x_limit);
+            assert(cx < cells_x_);
+
+            // the last tile receives the rounding remainder
+            uint64_t part = (cell_limit == x_limit) ? remaining
+                            : ticks * (cell_limit - x) / num;
+
+            cells_[cy * cells_x_ + cx] += part;
+            remaining -= part;
+            x = cell_limit;
+        }
+    }
+
+    CostMap&
+    CostMap::
+    operator+=(const CostMap& other)
+    {
+        if (other.empty())
+        {
+            return *this;
+        }
+
+        if (empty())
+        {
+            *this = other;
+            return *this;
+        }
+
+        assert(cells_.size() == other.cells_.size());
+
+        for (size_t i = 0; i < cells_.size(); ++i)
+        {
+            cells_[i] += other.cells_[i];
+        }
+
+        return *this;
+    }
+
+    coord_t
+    CostMap::
+    cells_x() const
+    {
+        return cells_x_;
+    }
+
+    coord_t
+    CostMap::
+    cells_y() const
+    {
+        return cells_y_;
+    }
+
+    uint64_t
+    CostMap::
+    ticks(coord_t cx, coord_t cy) const
+    {
+        assert(cx < cells_x_ && cy < cells_y_);
+
+        return cells_[cy * cells_x_ + cx];
+    }
+
+    void
+    CostMap::
+    write_csv(std::ostream& os, double ticks_per_second) const
+    {
+        for (coord_t cy = 0; cy < cells_y_; ++cy)
+        {
+            for (coord_t cx = 0; cx < cells_x_; ++cx)
+            {
+                if (cx > 0)
+                {
+                    os << ",";
+                }
+
+                if (ticks_per_second > 0.0)
+                {
+                    os << static_cast<double>(ticks(cx, cy)) / ticks_per_second * 1e3;
+                }
+                else
+                {
+                    os << ticks(cx, cy);
+                }
+            }
+
+            os << "\n";
+        }
+    }
+
+    void
+    CostMap::
+    write_pgm(std::ostream& os) const
+    {
+        uint64_t max_ticks(0);
+        if (!cells_.empty())
+        {
+            max_ticks = *std::max_element(cells_.begin(), cells_.end());
+        }
+
+        os << "P5\n" << cells_x_ << " " << cells_y_ << "\n255\n";
+
+        for (size_t i = 0; i < cells_.size(); ++i)
+        {
+            unsigned char val(0);
+            if (max_ticks > 0)
+            {
+                val = static_cast<unsigned char>(
+                          (static_cast<double>(cells_[i]) / static_cast<double>(max_ticks)) * 255.0 + 0.5);
+            }
+
+            os.put(static_cast<char>(val));
+        }
+    }
+
+} // namespace phtr
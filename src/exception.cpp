@@ -51,13 +51,13 @@ namespace phtr
 
         const char* base_exception::what() const throw()
         {
-            std::string tmp = prefix_;
+            what_ = prefix_;
             if (!msg_.empty())
             {
-                tmp += ": " + msg_;
+                what_ += ": " + msg_;
             }
 
-            return tmp.c_str();
+            return what_.c_str();
         }
 
         not_implemented::not_implemented()
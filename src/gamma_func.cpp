@@ -25,7 +25,6 @@ THE SOFTWARE.
 */
 
 #include <cmath>
-#include <algorithm>
 
 #include <photoropter/gamma_func.h>
 
@@ -81,59 +80,87 @@ namespace phtr
             return util::SetParam<coeff_iter_t>(coeff_.begin());
         }
 
-        template <class iterable_t>
-        void
-        GammaEMORBase::
-        set_param_list(const iterable_t& params)
+        double GammaEMORBase::get_function_value(double inp_val, const value_vect_t& tab) const
         {
 
-            coeff_.clear();
-            coeff_.resize(coeff_num_, 0);
-            precalc_done_ = false;
+            if (inp_val <= 0.0)
+            {
+                return 0.0;
+            }
+            else if (inp_val >= 1.0)
+            {
+                return 1.0;
+            }
 
-            coeff_iter_t coeff_iter;
-            typename iterable_t::const_iterator param_iter;
+            // make sure function values are initialised
+            check_precalc();
 
-            for (coeff_iter = coeff_.begin(), param_iter = params.begin();
-                    coeff_iter != coeff_.end() && param_iter != params.end();
-                    ++coeff_iter, ++param_iter)
+            // determine index on the uniform grid
+            double pos = inp_val * grid_num_;
+            size_t index = static_cast<size_t>(pos);
+            if (index >= grid_num_)
             {
-                *coeff_iter = *param_iter;
+                return tab[grid_num_];
             }
 
+            // linear interpolation
+            double frac = pos - index;
+            return tab[index] + frac * (tab[index + 1] - tab[index]);
+
         }
 
-        double GammaEMORBase::get_function_value(double inp_val, const value_vect_t& xval, const value_vect_t& yval) const
+        void GammaEMORBase::check_precalc() const
         {
-
-            if (inp_val <= 0.0)
+            /* note: this is not synchronised. It only has to do any work after set_params(),
+             all other paths precalculate eagerly (cf. the class documentation). */
+            if (!precalc_done_)
             {
-                return 0.0;
-            }
-            else if (inp_val >= 1.0)
-            {
-                return 1.0;
+                precalc_func();
+                precalc_done_ = true;
             }
+        }
 
-            // make sure function values are initialised
-            precalc_func();
+        void GammaEMORBase::resample(const value_vect_t& xval, const value_vect_t& yval, value_vect_t& tab)
+        {
+
+            tab.clear();
+            tab.resize(grid_num_ + 1, 0);
+
+            size_t num = xval.size();
+            size_t index = 1;
+
+            for (size_t i = 1; i < grid_num_; ++i)
+            {
+                double inp_val = static_cast<double>(i) / grid_num_;
 
-            // determine index
-            size_t index = static_cast<size_t>(std::lower_bound(xval.begin(), xval.end(), inp_val)
-                                               - xval.begin());
+                // find the first sample >= inp_val (the grid is traversed in ascending order)
+                while (index < num - 1 && xval[index] < inp_val)
+                {
+                    ++index;
+                }
 
-            // linar interpolation
-            /* note: since we checked that the input value is > 1.0, and the first element in
-             xval_ is guaranteed to be 0.0, lower_bound will yield a value >= 1 (and < sample_num_,
-             since input value is checked that it is < 1.0 as well). */
-            double x1 = xval[index - 1];
-            double x2 = xval[index];
-            double offs1 = inp_val - x1;
-            double offs2 = x2 - inp_val;
+                double x1 = xval[index - 1];
+                double x2 = xval[index];
 
-            double val = (yval[index - 1] * offs2 + yval[index] * offs1) / (x2 - x1);
+                if (inp_val <= x1)
+                {
+                    tab[i] = yval[index - 1];
+                }
+                else if (inp_val > x2)
+                {
+                    tab[i] = yval[index];
+                }
+                else
+                {
+                    // linear interpolation (x1 < inp_val <= x2)
+                    double offs1 = inp_val - x1;
+                    double offs2 = x2 - inp_val;
+                    tab[i] = (yval[index - 1] * offs2 + yval[index] * offs1) / (x2 - x1);
+                }
+            }
 
-            return val;
+            tab[0] = 0.0;
+            tab[grid_num_] = 1.0;
 
         }
 
@@ -160,64 +187,61 @@ namespace phtr
         };
         /// @endcond
 
-        void GammaEMOR::precalc_func() const
+        GammaEMOR::GammaEMOR()
         {
-            if (precalc_done_)
-            {
-                return;
-            }
+            precalc_func();
+            precalc_done_ = true;
+        }
 
-            // reset cache containers
-            xval_.clear();
-            xval_.resize(sample_num_, 0);
-            yval_.clear();
-            yval_.resize(sample_num_, 0);
+        void GammaEMOR::precalc_func() const
+        {
+            value_vect_t xval(sample_num_, 0);
+            value_vect_t yval(sample_num_, 0);
 
             double ytmp;
             for (size_t i = 0; i < sample_num_; ++i)
             {
-                xval_[i] = E_[i];
+                xval[i] = E_[i];
 
                 ytmp = f0_[i];
                 for (size_t j = 0; j < coeff_num_; ++j)
                 {
                     ytmp += coeff_[j] * h_[j][i];
                 }
-                yval_[i] = ytmp;
+                yval[i] = ytmp;
             }
 
-            precalc_done_ = true;
-            return;
+            // resample both directions onto the uniform grid
+            resample(xval, yval, inv_gamma_tab_);
+            resample(yval, xval, gamma_tab_);
         }
 
         double GammaEMOR::gamma(double value) const
         {
-            return get_function_value(value, yval_, xval_);
+            return get_function_value(value, gamma_tab_);
         }
 
         double GammaEMOR::inv_gamma(double value) const
         {
-            return get_function_value(value, xval_, yval_);
+            return get_function_value(value, inv_gamma_tab_);
         }
 
-        void GammaInvEMOR::precalc_func() const
+        GammaInvEMOR::GammaInvEMOR()
         {
-            if (precalc_done_)
-            {
-                return;
-            }
+            precalc_func();
+            precalc_done_ = true;
+        }
 
-            // reset cache containers
-            xval_.clear();
-            xval_.resize(sample_num_, 0);
-            yval_.clear();
-            yval_.resize(sample_num_, 0);
+        void GammaInvEMOR::precalc_func() const
+        {
+            value_vect_t xval(sample_num_, 0);
+            value_vect_t yval(sample_num_, 0);
 
             double ytmp;
             double lasty(0.0);
             for (size_t i = 0; i < sample_num_; ++i)
             {
-                xval_[i] = B_[i];
+                xval[i] = B_[i];
 
                 ytmp = g0_[i];
                 for (size_t j = 0; j < coeff_num_; ++j)
@@ -232,21 +256,22 @@ namespace phtr
                 }
 
                 lasty = ytmp;
-                yval_[i] = ytmp;
+                yval[i] = ytmp;
             }
 
-            precalc_done_ = true;
-            return;
+            // resample both directions onto the uniform grid
+            resample(xval, yval, gamma_tab_);
+            resample(yval, xval, inv_gamma_tab_);
         }
 
         double GammaInvEMOR::gamma(double value) const
         {
-            return get_function_value(value, xval_, yval_);
+            return get_function_value(value, gamma_tab_);
         }
 
         double GammaInvEMOR::inv_gamma(double value) const
         {
-            return get_function_value(value, yval_, xval_);
+            return get_function_value(value, inv_gamma_tab_);
         }
 
         ///@endcond
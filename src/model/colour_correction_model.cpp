@@ -0,0 +1,82 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+#include <photoropter/mem/mem_layout.h>
+#include <photoropter/model/colour_correction_model.h>
+
+namespace phtr
+{
+
+    namespace model
+    {
+
+        void
+        IColourCorrectionModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGB* factors) const
+        {
+            mult_correction_factors_row_generic(x, dx, y, num, factors);
+        }
+
+        void
+        IColourCorrectionModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGBA* factors) const
+        {
+            mult_correction_factors_row_generic(x, dx, y, num, factors);
+        }
+
+        template <typename colour_tuple_T>
+        void
+        IColourCorrectionModel::
+        mult_correction_factors_row_generic(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                            size_t num, colour_tuple_T* factors) const
+        {
+            typedef typename colour_tuple_T::channel_order_t channel_order_t;
+            typedef typename channel_order_t::coord_tuple_t coord_tuple_t;
+
+            coord_tuple_t coords;
+            colour_tuple_T fact;
+
+            for (size_t k = 0; k < num; ++k)
+            {
+                for (size_t i = 0; i < colour_tuple_T::num_vals; ++i)
+                {
+                    coords.x[i] = x + static_cast<interp_coord_t>(k) * dx;
+                    coords.y[i] = y;
+                }
+
+                get_correction_factors(coords, fact);
+
+                factors[k].value[channel_order_t::idx_red] *= fact.value[channel_order_t::idx_red];
+                factors[k].value[channel_order_t::idx_green] *= fact.value[channel_order_t::idx_green];
+                factors[k].value[channel_order_t::idx_blue] *= fact.value[channel_order_t::idx_blue];
+            }
+        }
+
+    } // namespace phtr::model
+
+} // namespace phtr
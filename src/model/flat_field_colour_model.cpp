@@ -0,0 +1,298 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <cassert>
+
+#include <photoropter/mem/mem_layout.h>
+#include <photoropter/model/flat_field_colour_model.h>
+
+namespace phtr
+{
+
+    namespace model
+    {
+
+        ///@cond PROTECTED
+
+        const size_t FlatFieldColourModel::num_gain_chans_;
+
+        FlatFieldColourModel::
+        FlatFieldColourModel(double param_aspect, double input_aspect,
+                             double param_crop, double input_crop)
+                : CorrectionModelBase(param_aspect, input_aspect, param_crop, input_crop),
+                grid_width_(0),
+                grid_height_(0),
+                scale_x_(0.0),
+                scale_y_(0.0),
+                offs_x_(0.0),
+                offs_y_(0.0)
+        {
+            set_grid_size(2, 2);
+        }
+
+        FlatFieldColourModel::
+        FlatFieldColourModel(double input_aspect)
+                : CorrectionModelBase(input_aspect, input_aspect, 1.0, 1.0),
+                grid_width_(0),
+                grid_height_(0),
+                scale_x_(0.0),
+                scale_y_(0.0),
+                offs_x_(0.0),
+                offs_y_(0.0)
+        {
+            set_grid_size(2, 2);
+        }
+
+        void
+        FlatFieldColourModel::
+        set_grid_size(size_t grid_width, size_t grid_height)
+        {
+            assert(grid_width >= 2 && grid_height >= 2);
+
+            grid_width_ = grid_width;
+            grid_height_ = grid_height;
+            calc_grid_scale();
+
+            gains_.assign(grid_width_ * grid_height_ * num_gain_chans_, 1.0);
+        }
+
+        void
+        FlatFieldColourModel::
+        get_grid_size(size_t& grid_width, size_t& grid_height) const
+        {
+            grid_width = grid_width_;
+            grid_height = grid_height_;
+        }
+
+        void
+        FlatFieldColourModel::
+        set_gain(Channel::type chan, size_t gx, size_t gy, double gain)
+        {
+            assert(static_cast<size_t>(chan) < num_gain_chans_);
+            assert(gx < grid_width_ && gy < grid_height_);
+
+            gains_[(gy * grid_width_ + gx) * num_gain_chans_ + chan] = gain;
+        }
+
+        double
+        FlatFieldColourModel::
+        get_gain(Channel::type chan, size_t gx, size_t gy) const
+        {
+            assert(static_cast<size_t>(chan) < num_gain_chans_);
+            assert(gx < grid_width_ && gy < grid_height_);
+
+            return gains_[(gy * grid_width_ + gx) * num_gain_chans_ + chan];
+        }
+
+        void
+        FlatFieldColourModel::
+        set_gains(Channel::type chan, const double* gains)
+        {
+            assert(static_cast<size_t>(chan) < num_gain_chans_);
+
+            const size_t num_nodes = grid_width_ * grid_height_;
+
+            for (size_t i = 0; i < num_nodes; ++i)
+            {
+                gains_[i * num_gain_chans_ + chan] = gains[i];
+            }
+        }
+
+        void
+        FlatFieldColourModel::
+        get_correction_factors(const mem::CoordTupleRGB& coords,
+                               mem::ColourTupleRGB& factors) const
+        {
+            get_correction_factors_impl(coords, factors);
+        }
+
+        void
+        FlatFieldColourModel::
+        get_correction_factors(const mem::CoordTupleRGBA& coords,
+                               mem::ColourTupleRGBA& factors) const
+        {
+            typedef mem::CoordTupleRGBA::channel_order_t channel_order_t;
+
+            get_correction_factors_impl(coords, factors);
+
+            factors.value[channel_order_t::idx_alpha] = 1.0;
+        }
+
+        void
+        FlatFieldColourModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGB* factors) const
+        {
+            mult_correction_factors_row_impl(x, dx, y, num, factors);
+        }
+
+        void
+        FlatFieldColourModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGBA* factors) const
+        {
+            mult_correction_factors_row_impl(x, dx, y, num, factors);
+        }
+
+        void
+        FlatFieldColourModel::
+        calc_coord_fact()
+        {
+            CorrectionModelBase::calc_coord_fact();
+            calc_grid_scale();
+        }
+
+        void
+        FlatFieldColourModel::
+        calc_grid_scale()
+        {
+            /* note: the outermost nodes lie on the borders of the measured image, so the grid
+             spans [-param_aspect_, param_aspect_] x [-1, 1] in its coordinate system. */
+            offs_x_ = 0.5 * static_cast<double>(grid_width_ - 1);
+            offs_y_ = 0.5 * static_cast<double>(grid_height_ - 1);
+            scale_x_ = coord_fact_ * offs_x_ / param_aspect_;
+            scale_y_ = coord_fact_ * offs_y_;
+        }
+
+        size_t
+        FlatFieldColourModel::
+        get_cell(double pos, size_t num, double& frac)
+        {
+            // clamp to the grid (this also catches NaN values)
+            const double pos_max = static_cast<double>(num - 1);
+            pos = (pos > 0.0) ? ((pos < pos_max) ? pos : pos_max) : 0.0;
+
+            size_t idx = static_cast<size_t>(pos);
+            if (idx > num - 2)
+            {
+                idx = num - 2;
+            }
+
+            frac = pos - static_cast<double>(idx);
+            return idx;
+        }
+
+        double
+        FlatFieldColourModel::
+        get_gain_at(size_t chan_idx, interp_coord_t x, interp_coord_t y) const
+        {
+            double fx(0);
+            double fy(0);
+            const size_t ix = get_cell(x * scale_x_ + offs_x_, grid_width_, fx);
+            const size_t iy = get_cell(y * scale_y_ + offs_y_, grid_height_, fy);
+
+            const double* g0 = &gains_[(iy * grid_width_ + ix) * num_gain_chans_ + chan_idx];
+            const double* g1 = g0 + grid_width_ * num_gain_chans_;
+
+            const double top = g0[0] + fx * (g0[num_gain_chans_] - g0[0]);
+            const double bottom = g1[0] + fx * (g1[num_gain_chans_] - g1[0]);
+
+            return top + fy * (bottom - top);
+        }
+
+        template <typename coord_tuple_T>
+        void
+        FlatFieldColourModel::
+        get_correction_factors_impl(const coord_tuple_T& coords,
+                                    typename coord_tuple_T::channel_order_t::colour_tuple_t& factors) const
+        {
+            typedef typename coord_tuple_T::channel_order_t channel_order_t;
+
+            const size_t idx_r = channel_order_t::idx_red;
+            const size_t idx_g = channel_order_t::idx_green;
+            const size_t idx_b = channel_order_t::idx_blue;
+
+            factors.value[idx_r] = get_gain_at(Channel::red, coords.x[idx_r], coords.y[idx_r]);
+            factors.value[idx_g] = get_gain_at(Channel::green, coords.x[idx_g], coords.y[idx_g]);
+            factors.value[idx_b] = get_gain_at(Channel::blue, coords.x[idx_b], coords.y[idx_b]);
+        }
+
+        template <typename colour_tuple_T>
+        void
+        FlatFieldColourModel::
+        mult_correction_factors_row_impl(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                         size_t num, colour_tuple_T* factors) const
+        {
+            typedef typename colour_tuple_T::channel_order_t channel_order_t;
+
+            const size_t idx_r = channel_order_t::idx_red;
+            const size_t idx_g = channel_order_t::idx_green;
+            const size_t idx_b = channel_order_t::idx_blue;
+
+            // the two grid lines enclosing the row
+            double fy(0);
+            const size_t iy = get_cell(y * scale_y_ + offs_y_, grid_height_, fy);
+            const double* g0 = &gains_[iy * grid_width_ * num_gain_chans_];
+            const double* g1 = g0 + grid_width_ * num_gain_chans_;
+
+            // horizontal position in grid units
+            double pos = x * scale_x_ + offs_x_;
+            const double step = dx * scale_x_;
+
+            /* note: the gains at the left and right node of the current cell are interpolated
+             vertically only when the row enters a new cell. */
+            size_t cur_ix = grid_width_;
+            double l0[num_gain_chans_];
+            double l1[num_gain_chans_];
+
+            for (size_t k = 0; k < num; ++k)
+            {
+                double fx(0);
+                const size_t ix = get_cell(pos, grid_width_, fx);
+
+                if (ix != cur_ix)
+                {
+                    const size_t i0 = ix * num_gain_chans_;
+                    const size_t i1 = i0 + num_gain_chans_;
+
+                    for (size_t c = 0; c < num_gain_chans_; ++c)
+                    {
+                        l0[c] = g0[i0 + c] + fy * (g1[i0 + c] - g0[i0 + c]);
+                        l1[c] = g0[i1 + c] + fy * (g1[i1 + c] - g0[i1 + c]);
+                    }
+
+                    cur_ix = ix;
+                }
+
+                factors[k].value[idx_r] *= l0[Channel::red] + fx * (l1[Channel::red] - l0[Channel::red]);
+                factors[k].value[idx_g] *= l0[Channel::green] + fx * (l1[Channel::green] - l0[Channel::green]);
+                factors[k].value[idx_b] *= l0[Channel::blue] + fx * (l1[Channel::blue] - l0[Channel::blue]);
+
+                pos += step;
+            }
+        }
+
+        IColourCorrectionModel* FlatFieldColourModel::clone() const
+        {
+            return new FlatFieldColourModel(*this);
+        }
+
+        ///@endcond
+
+    } // namespace phtr::model
+
+} // namespace phtr
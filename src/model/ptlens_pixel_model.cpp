@@ -144,6 +144,22 @@ namespace phtr
             y0 = y0_[chan_idx];
         }
 
+        void
+        PTLensPixelModel::
+        get_radial_centre(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const
+        {
+            x0 = x0_[chan_idx];
+            y0 = y0_[chan_idx];
+        }
+
+        bool
+        PTLensPixelModel::
+        get_src_radius(size_t chan_idx, double r, double& r_src) const
+        {
+            r_src = (((a_[chan_idx] * r + b_[chan_idx]) * r + c_[chan_idx]) * r + d_[chan_idx]) * r;
+            return true;
+        }
+
         void
         PTLensPixelModel::
         get_src_coords(mem::CoordTupleMono& coords) const
@@ -112,6 +112,22 @@ namespace phtr
             y0 = y0_[chan_idx];
         }
 
+        void
+        ScalerPixelModel::
+        get_radial_centre(size_t chan_idx, interp_coord_t& x0, interp_coord_t& y0) const
+        {
+            x0 = x0_[chan_idx];
+            y0 = y0_[chan_idx];
+        }
+
+        bool
+        ScalerPixelModel::
+        get_src_radius(size_t chan_idx, double r, double& r_src) const
+        {
+            r_src = r / k_[chan_idx];
+            return true;
+        }
+
         void
         ScalerPixelModel::
         get_src_coords(mem::CoordTupleMono& coords) const
@@ -45,7 +45,9 @@ namespace phtr
                 b_(0),
                 c_(0),
                 x0_(0),
-                y0_(0)
+                y0_(0),
+                use_radial_lut_(false),
+                radial_lut_num_(4096)
         {
             //NIL
         }
@@ -57,7 +59,9 @@ namespace phtr
                 b_(0),
                 c_(0),
                 x0_(0),
-                y0_(0)
+                y0_(0),
+                use_radial_lut_(false),
+                radial_lut_num_(4096)
         {
             //NIL
         }
@@ -68,6 +72,7 @@ namespace phtr
             a_ = a * std::pow(coord_fact_, 6);
             b_ = b * std::pow(coord_fact_, 4);
             c_ = c * std::pow(coord_fact_, 2);
+            update_radial_lut();
         }
 
         void VignettingColourModel::
@@ -94,6 +99,22 @@ namespace phtr
             y0 = y0_;
         }
 
+        void
+        VignettingColourModel::
+        enable_radial_lut(bool enable)
+        {
+            use_radial_lut_ = enable;
+            update_radial_lut();
+        }
+
+        void
+        VignettingColourModel::
+        set_radial_lut_precision(size_t num)
+        {
+            radial_lut_num_ = (num < 2) ? 2 : num;
+            update_radial_lut();
+        }
+
 
         void
         VignettingColourModel::
@@ -115,6 +136,35 @@ namespace phtr
             factors.value[channel_order_t::idx_alpha] = 1.0;
         }
 
+        void
+        VignettingColourModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGB* factors) const
+        {
+            mult_correction_factors_row_impl(x, dx, y, num, factors);
+        }
+
+        void
+        VignettingColourModel::
+        mult_correction_factors_row(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                    size_t num, mem::ColourTupleRGBA* factors) const
+        {
+            mult_correction_factors_row_impl(x, dx, y, num, factors);
+        }
+
+        double
+        VignettingColourModel::
+        get_factor(double r2) const
+        {
+            double fact(0.0);
+            if (radial_lut_.lookup(r2, fact))
+            {
+                return fact;
+            }
+
+            return 1.0 / (((a_ * r2 + b_) * r2 + c_) * r2 + 1.0);
+        }
+
         template <typename coord_tuple_T>
         void
         VignettingColourModel::
@@ -123,26 +173,110 @@ namespace phtr
         {
 
             typedef typename coord_tuple_T::channel_order_t channel_order_t;
-            typedef typename channel_order_t::colour_tuple_t colour_tuple_t;
 
-            double x_r = coords.x[channel_order_t::idx_red] - x0_;
-            double y_r = coords.y[channel_order_t::idx_red] - y0_;
-            double r2_r = x_r * x_r + y_r * y_r;
+            const size_t idx_r = channel_order_t::idx_red;
+            const size_t idx_g = channel_order_t::idx_green;
+            const size_t idx_b = channel_order_t::idx_blue;
+
+            double x_r = coords.x[idx_r] - x0_;
+            double y_r = coords.y[idx_r] - y0_;
+            double fact_r = get_factor(x_r * x_r + y_r * y_r);
+
+            factors.value[idx_r] = fact_r;
+
+            // without TCA correction, all channels share the same coordinates
+            if (coords.x[idx_g] == coords.x[idx_r] && coords.y[idx_g] == coords.y[idx_r])
+            {
+                factors.value[idx_g] = fact_r;
+            }
+            else
+            {
+                double x_g = coords.x[idx_g] - x0_;
+                double y_g = coords.y[idx_g] - y0_;
+                factors.value[idx_g] = get_factor(x_g * x_g + y_g * y_g);
+            }
+
+            if (coords.x[idx_b] == coords.x[idx_r] && coords.y[idx_b] == coords.y[idx_r])
+            {
+                factors.value[idx_b] = fact_r;
+            }
+            else
+            {
+                double x_b = coords.x[idx_b] - x0_;
+                double y_b = coords.y[idx_b] - y0_;
+                factors.value[idx_b] = get_factor(x_b * x_b + y_b * y_b);
+            }
+
+        }
+
+        template <typename colour_tuple_T>
+        void
+        VignettingColourModel::
+        mult_correction_factors_row_impl(interp_coord_t x, interp_coord_t dx, interp_coord_t y,
+                                         size_t num, colour_tuple_T* factors) const
+        {
+            typedef typename colour_tuple_T::channel_order_t channel_order_t;
+
+            const double x_c = x - x0_;
+            const double y_c = y - y0_;
 
-            factors.value[channel_order_t::idx_red] = 1.0 / (((a_ * r2_r + b_) * r2_r + c_) * r2_r + 1.0);
+            // r^2 and its first and second differences along the row
+            double r2 = x_c * x_c + y_c * y_c;
+            double delta = 2.0 * x_c * dx + dx * dx;
+            const double delta2 = 2.0 * dx * dx;
 
-            double x_g = coords.x[channel_order_t::idx_green] - x0_;
-            double y_g = coords.y[channel_order_t::idx_green] - y0_;
-            double r2_g = x_g * x_g + y_g * y_g;
+            for (size_t k = 0; k < num; ++k)
+            {
+                double fact = get_factor(r2);
 
-            factors.value[channel_order_t::idx_green] = 1.0 / (((a_ * r2_g + b_) * r2_g + c_) * r2_g + 1.0);
+                factors[k].value[channel_order_t::idx_red] *= fact;
+                factors[k].value[channel_order_t::idx_green] *= fact;
+                factors[k].value[channel_order_t::idx_blue] *= fact;
 
-            double x_b = coords.x[channel_order_t::idx_blue] - x0_;
-            double y_b = coords.y[channel_order_t::idx_blue] - y0_;
-            double r2_b = x_b * x_b + y_b * y_b;
+                r2 += delta;
+                delta += delta2;
+            }
+        }
+
+        void
+        VignettingColourModel::
+        update_radial_lut()
+        {
+            if (!use_radial_lut_)
+            {
+                radial_lut_.clear();
+                return;
+            }
+
+            // squared radius covered by the table: the square of the full image diagonal
+            const double r_max = RadialTable::max_radius(input_aspect_);
+
+            radial_lut_.build(Factor(a_, b_, c_), radial_lut_num_, r_max * r_max, false);
+        }
+
+        VignettingColourModel::Factor::
+        Factor(double a, double b, double c)
+                : a_(a),
+                b_(b),
+                c_(c)
+        {
+            //NIL
+        }
+
+        bool
+        VignettingColourModel::Factor::
+        eval(double r2, double& fact) const
+        {
+            double denom = ((a_ * r2 + b_) * r2 + c_) * r2 + 1.0;
 
-            factors.value[channel_order_t::idx_blue] = 1.0 / (((a_ * r2_b + b_) * r2_b + c_) * r2_b + 1.0);
+            // stop at the first pole (the exact formula is used beyond)
+            if (!(denom > 0.0))
+            {
+                return false;
+            }
 
+            fact = 1.0 / denom;
+            return true;
         }
 
         IColourCorrectionModel* VignettingColourModel::clone() const
@@ -172,6 +306,7 @@ namespace phtr
             a_ = a * std::pow(coord_fact_ * hugin_fact, 6);
             b_ = b * std::pow(coord_fact_ * hugin_fact, 4);
             c_ = c * std::pow(coord_fact_ * hugin_fact, 2);
+            update_radial_lut();
         }
 
         void HuginVignettingModel::
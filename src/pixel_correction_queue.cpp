@@ -28,18 +28,23 @@ THE SOFTWARE.
 
 #include <photoropter/pixel_correction_queue.h>
 #include <photoropter/model/pixel_correction_model.h>
+#include <photoropter/model/radial_model.h>
 
 namespace phtr
 {
 
     PixelCorrectionQueue::PixelCorrectionQueue()
-            : n_models_(0)
+            : n_models_(0),
+            use_radial_collapse_(false),
+            radial_collapsed_(false)
     {
         //NIL
     }
 
     PixelCorrectionQueue::PixelCorrectionQueue(const PixelCorrectionQueue& orig)
-            : n_models_(0)
+            : n_models_(0),
+            use_radial_collapse_(false),
+            radial_collapsed_(false)
     {
         n_models_ = static_cast<unsigned short>(orig.correction_model_.size());
         correction_model_.resize(n_models_);
@@ -48,6 +53,10 @@ namespace phtr
         {
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
+
+        use_radial_collapse_ = orig.use_radial_collapse_;
+        radial_collapsed_ = orig.radial_collapsed_;
+        radial_collapse_ = orig.radial_collapse_;
     }
 
     PixelCorrectionQueue::~PixelCorrectionQueue()
@@ -67,9 +76,18 @@ namespace phtr
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
 
+        use_radial_collapse_ = orig.use_radial_collapse_;
+        radial_collapsed_ = orig.radial_collapsed_;
+        radial_collapse_ = orig.radial_collapse_;
+
         return *this;
     }
 
+    bool PixelCorrectionQueue::empty() const
+    {
+        return n_models_ == 0;
+    }
+
     void PixelCorrectionQueue::clear()
     {
         n_models_ = static_cast<unsigned short>(correction_model_.size());
@@ -81,6 +99,7 @@ namespace phtr
         correction_model_.clear();
 
         n_models_ = 0;
+        invalidate_radial_collapse();
     }
 
     model::IPixelCorrectionModel& PixelCorrectionQueue::add_model(const model::IPixelCorrectionModel& model)
@@ -92,8 +111,53 @@ namespace phtr
 
         correction_model_.assign(tmp_list.begin(), tmp_list.end());
         ++n_models_;
+        invalidate_radial_collapse();
 
         return *new_mod;
     }
 
+    void PixelCorrectionQueue::enable_radial_collapse(bool enable)
+    {
+        use_radial_collapse_ = enable;
+        invalidate_radial_collapse();
+    }
+
+    void PixelCorrectionQueue::set_radial_collapse_params(size_t num, double max_err)
+    {
+        radial_collapse_.set_params(num, max_err);
+        invalidate_radial_collapse();
+    }
+
+    bool PixelCorrectionQueue::update_radial_collapse(double r_max)
+    {
+        radial_collapsed_ = false;
+
+        if (!use_radial_collapse_ || n_models_ == 0)
+        {
+            return false;
+        }
+
+        // collect the model chain (all models have to be radial)
+        RadialCollapse::chain_t chain;
+        for (size_t i = 0; i < n_models_; ++i)
+        {
+            const model::IRadialModel* radial_model = dynamic_cast<const model::IRadialModel*>(correction_model_[i]);
+            if (radial_model == 0)
+            {
+                return false;
+            }
+            chain.push_back(radial_model);
+        }
+
+        // (the table is only rebuilt if the chain has changed, cf. RadialCollapse::update())
+        radial_collapsed_ = radial_collapse_.update(chain, 0, r_max);
+        return radial_collapsed_;
+    }
+
+    void PixelCorrectionQueue::invalidate_radial_collapse()
+    {
+        radial_collapsed_ = false;
+        radial_collapse_.reset();
+    }
+
 } // namespace phtr
@@ -0,0 +1,203 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <cmath>
+#include <limits>
+
+#include <photoropter/radial_collapse.h>
+
+namespace phtr
+{
+
+    RadialCollapse::RadialCollapse()
+            : num_(1024),
+            cur_num_(1024),
+            max_err_(1e-5),
+            x0_(0.0),
+            y0_(0.0),
+            valid_(false)
+    {
+        //NIL
+    }
+
+    void RadialCollapse::set_params(size_t num, double max_err)
+    {
+        num_ = (num < 2) ? 2 : num;
+        cur_num_ = num_;
+        max_err_ = max_err;
+        reset();
+    }
+
+    bool RadialCollapse::update(const chain_t& chain, size_t chan_idx, double r_max)
+    {
+        std::vector<double> fp;
+        get_fingerprint(chain, chan_idx, r_max, fp);
+
+        // (the result for an unchanged chain is cached, whether it could be collapsed or not)
+        if (!fingerprint_.empty() && fp == fingerprint_)
+        {
+            return valid_;
+        }
+
+        reset();
+        build(chain, chan_idx, r_max);
+        fingerprint_.swap(fp);
+
+        return valid_;
+    }
+
+    bool RadialCollapse::build(const chain_t& chain, size_t chan_idx, double r_max)
+    {
+        if (chain.empty())
+        {
+            return false;
+        }
+
+        // all models have to share the same centre
+        chain[0]->get_radial_centre(chan_idx, x0_, y0_);
+        for (size_t i = 1; i < chain.size(); ++i)
+        {
+            interp_coord_t x0(0.0);
+            interp_coord_t y0(0.0);
+            chain[i]->get_radial_centre(chan_idx, x0, y0);
+
+            if (x0 != x0_ || y0 != y0_)
+            {
+                return false;
+            }
+        }
+
+        /* note: the table is only filled up to the source radius r_max, but the
+         error check only requires the chain to be evaluable. */
+        const ChainRatio fill_func(chain, chan_idx, r_max);
+        const ChainRatio check_func(chain, chan_idx, std::numeric_limits<double>::max());
+
+        // double the resolution until the interpolation error stays within the bound
+        size_t num = cur_num_;
+        for (;;)
+        {
+            table_.build(fill_func, num, r_max, true);
+
+            bool exceeded(false);
+            size_t lim = table_.check_error(check_func, max_err_, exceeded);
+            if (exceeded && 2 * num <= max_num_)
+            {
+                num *= 2;
+                continue;
+            }
+
+            // (highest resolution reached: only use the table up to the failing interval)
+            table_.limit(lim);
+            break;
+        }
+        cur_num_ = num;
+
+        valid_ = table_.valid();
+        return valid_;
+    }
+
+    void RadialCollapse::reset()
+    {
+        table_.clear();
+        valid_ = false;
+        fingerprint_.clear();
+    }
+
+    void RadialCollapse::get_fingerprint(const chain_t& chain, size_t chan_idx, double r_max,
+                                         std::vector<double>& fp)
+    {
+        fp.clear();
+        fp.reserve(3 + 2 * chain.size() + 2 * fingerprint_num_);
+
+        fp.push_back(r_max);
+        fp.push_back(static_cast<double>(chan_idx));
+        fp.push_back(static_cast<double>(chain.size()));
+
+        // the model centres
+        for (size_t i = 0; i < chain.size(); ++i)
+        {
+            interp_coord_t x0(0.0);
+            interp_coord_t y0(0.0);
+            chain[i]->get_radial_centre(chan_idx, x0, y0);
+
+            fp.push_back(x0);
+            fp.push_back(y0);
+        }
+
+        // the mapping of the radius (a failed evaluation is recorded as such)
+        const ChainRatio func(chain, chan_idx, std::numeric_limits<double>::max());
+        for (size_t i = 0; i < fingerprint_num_; ++i)
+        {
+            double ratio(0.0);
+            bool ok = func.eval(r_max * (i + 0.5) / fingerprint_num_, ratio);
+
+            fp.push_back(ok ? 1.0 : 0.0);
+            fp.push_back(ok ? ratio : 0.0);
+        }
+    }
+
+    RadialCollapse::ChainRatio::ChainRatio(const chain_t& chain, size_t chan_idx, double r_max)
+            : chain_(chain),
+            chan_idx_(chan_idx),
+            r_max_(r_max)
+    {
+        //NIL
+    }
+
+    bool RadialCollapse::ChainRatio::eval(double r, double& ratio) const
+    {
+        const double r_dst = r;
+        ratio = 1.0;
+
+        for (size_t i = 0; i < chain_.size(); ++i)
+        {
+            double r_src(0.0);
+            if (!chain_[i]->get_src_radius(chan_idx_, r, r_src) || !(r_src == r_src))
+            {
+                return false;
+            }
+
+            /* note: a negative source radius mirrors the point at the centre, so
+             the next model sees the absolute value. */
+            ratio *= r_src / r;
+            r = std::fabs(r_src);
+
+            if (r == 0.0)
+            {
+                return false;
+            }
+        }
+
+        return std::fabs(ratio) * r_dst <= r_max_;
+    }
+
+    double RadialCollapse::ChainRatio::error_scale(double r) const
+    {
+        return r;
+    }
+
+} // namespace phtr
@@ -0,0 +1,123 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+
+#include <cmath>
+
+#include <photoropter/radial_table.h>
+
+namespace phtr
+{
+
+    double RadialTable::IFunction::error_scale(double) const
+    {
+        return 1.0;
+    }
+
+    RadialTable::RadialTable()
+            : scale_(0.0),
+            lim_(0.0)
+    {
+        //NIL
+    }
+
+    double RadialTable::max_radius(double aspect)
+    {
+        return 2.0 * std::sqrt(1.0 + aspect * aspect);
+    }
+
+    void RadialTable::build(const IFunction& func, size_t num, double pos_max, bool off_centre)
+    {
+        scale_ = num / pos_max;
+        table_.clear();
+        table_.resize(num + 1, 0.0);
+        lim_ = 0.0;
+
+        for (size_t i = 0; i <= num; ++i)
+        {
+            /* note: functions of the direction (e.g. ratios of radii) are undefined at
+             the centre, so the first entry is evaluated slightly off-centre. */
+            double pos = (i == 0 && off_centre) ? (1e-6 / scale_) : (i / scale_);
+            double val(0.0);
+
+            if (!func.eval(pos, val))
+            {
+                break;
+            }
+
+            table_[i] = val;
+            lim_ = static_cast<double>(i);
+        }
+    }
+
+    size_t RadialTable::check_error(const IFunction& func, double max_err, bool& exceeded) const
+    {
+        exceeded = false;
+
+        size_t lim = static_cast<size_t>(lim_);
+        for (size_t i = 0; i < lim; ++i)
+        {
+            double pos = (i + 0.5) / scale_;
+            double val(0.0);
+
+            if (!func.eval(pos, val))
+            {
+                return i;
+            }
+
+            double err = std::fabs(0.5 * (table_[i] + table_[i + 1]) - val) * func.error_scale(pos);
+            if (err > max_err)
+            {
+                exceeded = true;
+                return i;
+            }
+        }
+
+        return lim;
+    }
+
+    void RadialTable::limit(size_t num)
+    {
+        if (static_cast<double>(num) < lim_)
+        {
+            lim_ = static_cast<double>(num);
+        }
+    }
+
+    void RadialTable::clear()
+    {
+        table_.clear();
+        scale_ = 0.0;
+        lim_ = 0.0;
+    }
+
+    bool RadialTable::valid() const
+    {
+        return lim_ > 0.0;
+    }
+
+} // namespace phtr
@@ -24,22 +24,28 @@ THE SOFTWARE.
 
 */
 
+#include <cassert>
 #include <list>
 
 #include <photoropter/subpixel_correction_queue.h>
 #include <photoropter/model/subpixel_correction_model.h>
+#include <photoropter/model/radial_model.h>
 
 namespace phtr
 {
 
     SubpixelCorrectionQueue::SubpixelCorrectionQueue()
-            : n_models_(0)
+            : n_models_(0),
+            use_radial_collapse_(false),
+            radial_collapsed_(false)
     {
         //NIL
     }
 
     SubpixelCorrectionQueue::SubpixelCorrectionQueue(const SubpixelCorrectionQueue& orig)
-            : n_models_(0)
+            : n_models_(0),
+            use_radial_collapse_(false),
+            radial_collapsed_(false)
     {
         n_models_ = static_cast<unsigned short>(orig.correction_model_.size());
         correction_model_.resize(n_models_);
@@ -48,6 +54,13 @@ namespace phtr
         {
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
+
+        use_radial_collapse_ = orig.use_radial_collapse_;
+        radial_collapsed_ = orig.radial_collapsed_;
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            radial_collapse_[i] = orig.radial_collapse_[i];
+        }
     }
 
     SubpixelCorrectionQueue::~SubpixelCorrectionQueue()
@@ -67,9 +80,21 @@ namespace phtr
             correction_model_[i] = orig.correction_model_[i]->clone();
         }
 
+        use_radial_collapse_ = orig.use_radial_collapse_;
+        radial_collapsed_ = orig.radial_collapsed_;
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            radial_collapse_[i] = orig.radial_collapse_[i];
+        }
+
         return *this;
     }
 
+    bool SubpixelCorrectionQueue::empty() const
+    {
+        return n_models_ == 0;
+    }
+
     void SubpixelCorrectionQueue::clear()
     {
         n_models_ = static_cast<unsigned short>(correction_model_.size());
@@ -81,6 +106,7 @@ namespace phtr
         correction_model_.clear();
 
         n_models_ = 0;
+        invalidate_radial_collapse();
     }
 
     model::ISubpixelCorrectionModel& SubpixelCorrectionQueue::add_model(const model::ISubpixelCorrectionModel& model)
@@ -92,8 +118,68 @@ namespace phtr
 
         correction_model_.assign(tmp_list.begin(), tmp_list.end());
         ++n_models_;
+        invalidate_radial_collapse();
 
         return *new_mod;
     }
 
+    void SubpixelCorrectionQueue::enable_radial_collapse(bool enable)
+    {
+        use_radial_collapse_ = enable;
+        invalidate_radial_collapse();
+    }
+
+    void SubpixelCorrectionQueue::set_radial_collapse_params(size_t num, double max_err)
+    {
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            radial_collapse_[i].set_params(num, max_err);
+        }
+        invalidate_radial_collapse();
+    }
+
+    bool SubpixelCorrectionQueue::update_radial_collapse(double r_max, size_t num_channels)
+    {
+        assert(num_channels <= mem::PHTR_MAX_CHANNELS);
+
+        radial_collapsed_ = false;
+
+        if (!use_radial_collapse_ || n_models_ == 0)
+        {
+            return false;
+        }
+
+        // collect the model chain (all models have to be radial)
+        RadialCollapse::chain_t chain;
+        for (size_t i = 0; i < n_models_; ++i)
+        {
+            const model::IRadialModel* radial_model = dynamic_cast<const model::IRadialModel*>(correction_model_[i]);
+            if (radial_model == 0)
+            {
+                return false;
+            }
+            chain.push_back(radial_model);
+        }
+
+        // (the tables are only rebuilt if the chain has changed, cf. RadialCollapse::update())
+        bool success = true;
+        for (size_t i = 0; i < num_channels; ++i)
+        {
+            success = radial_collapse_[i].update(chain, i, r_max) && success;
+        }
+
+        radial_collapsed_ = success;
+        return radial_collapsed_;
+    }
+
+    void SubpixelCorrectionQueue::invalidate_radial_collapse()
+    {
+        radial_collapsed_ = false;
+
+        for (size_t i = 0; i < mem::PHTR_MAX_CHANNELS; ++i)
+        {
+            radial_collapse_[i].reset();
+        }
+    }
+
 } // namespace phtr
@@ -0,0 +1,256 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+#include <algorithm>
+#include <cassert>
+
+#include <photoropter/transform_stats.h>
+#include <photoropter/wall_timer.h>
+
+namespace phtr
+{
+
+    TransformStats::
+    TransformStats()
+    {
+        clear();
+    }
+
+    void
+    TransformStats::
+    clear()
+    {
+        enabled = false;
+
+        for (size_t i = 0; i < Stage::num_stages; ++i)
+        {
+            ticks[i] = 0;
+        }
+
+        ticks_per_second = 0.0;
+        wall_time = 0.0;
+        pixels = 0;
+        samples = 0;
+        out_of_bounds = 0;
+        num_transforms = 0;
+        num_threads = 0;
+
+        cost_map.clear();
+    }
+
+    TransformStats&
+    TransformStats::
+    operator+=(const TransformStats& other)
+    {
+        enabled = enabled || other.enabled;
+
+        for (size_t i = 0; i < Stage::num_stages; ++i)
+        {
+            ticks[i] += other.ticks[i];
+        }
+
+        if (other.ticks_per_second > 0.0)
+        {
+            ticks_per_second = other.ticks_per_second;
+        }
+
+        wall_time += other.wall_time;
+        pixels += other.pixels;
+        samples += other.samples;
+        out_of_bounds += other.out_of_bounds;
+        num_transforms += other.num_transforms;
+        num_threads = std::max(num_threads, other.num_threads);
+
+        cost_map += other.cost_map;
+
+        return *this;
+    }
+
+    double
+    TransformStats::
+    stage_time(Stage::type stage) const
+    {
+        assert(stage < Stage::num_stages);
+
+        if (ticks_per_second <= 0.0)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(ticks[stage]) / ticks_per_second;
+    }
+
+    double
+    TransformStats::
+    total_stage_time() const
+    {
+        double sum(0.0);
+
+        for (size_t i = 0; i < Stage::num_stages; ++i)
+        {
+            sum += stage_time(static_cast<Stage::type>(i));
+        }
+
+        return sum;
+    }
+
+    const char*
+    TransformStats::
+    stage_name(Stage::type stage)
+    {
+        switch (stage)
+        {
+            case Stage::pixel_queue:
+                return "pixel_queue";
+
+            case Stage::subpixel_queue:
+                return "subpixel_queue";
+
+            case Stage::colour_queue:
+                return "colour_queue";
+
+            case Stage::interpolation:
+                return "interpolation";
+
+            case Stage::normalise:
+                return "normalise";
+
+            case Stage::encode:
+                return "encode";
+
+            case Stage::write:
+                return "write";
+
+            case Stage::num_stages:
+            default:
+                return "unknown";
+        }
+    }
+
+    StatsRecorder::
+    StatsRecorder(TransformStats& stats)
+            : stats_(stats),
+            t0_(0.0),
+            ticks0_(0),
+            num_merged_(0),
+            map_width_(0),
+            map_height_(0),
+            map_tile_width_(0),
+            map_tile_height_(0)
+    {
+#ifdef PHTR_INSTRUMENT
+        t0_ = WallTimer::now();
+        ticks0_ = StageTimer::ticks();
+#endif
+    }
+
+    StatsRecorder::
+    ~StatsRecorder()
+    {
+#ifdef PHTR_INSTRUMENT
+        double dt = WallTimer::now() - t0_;
+        uint64_t dticks = StageTimer::ticks() - ticks0_;
+
+        stats_.enabled = true;
+        stats_.wall_time += dt;
+        ++stats_.num_transforms;
+        stats_.num_threads = std::max(stats_.num_threads, num_merged_);
+
+        double tick_rate = StageTimer::fixed_tick_rate();
+        if (tick_rate > 0.0)
+        {
+            stats_.ticks_per_second = tick_rate;
+        }
+        else if ((dt > 0.0) && (dticks > 0))
+        {
+            stats_.ticks_per_second = static_cast<double>(dticks) / dt;
+        }
+#endif
+    }
+
+    void
+    StatsRecorder::
+    set_cost_map(coord_t width, coord_t height, coord_t tile_width, coord_t tile_height)
+    {
+#ifdef PHTR_INSTRUMENT
+        map_width_ = width;
+        map_height_ = height;
+        map_tile_width_ = tile_width;
+        map_tile_height_ = tile_height;
+
+        if (tile_width == 0 || tile_height == 0)
+        {
+            return;
+        }
+
+        // start a new accumulated map if the geometry has changed
+        CostMap tmp_map;
+        tmp_map.init(width, height, tile_width, tile_height);
+        if (stats_.cost_map.cells_x() != tmp_map.cells_x() || stats_.cost_map.cells_y() != tmp_map.cells_y())
+        {
+            stats_.cost_map = tmp_map;
+        }
+#else
+        (void)width;
+        (void)height;
+        (void)tile_width;
+        (void)tile_height;
+#endif
+    }
+
+    void
+    StatsRecorder::
+    prepare(TransformStats& thread_stats) const
+    {
+#ifdef PHTR_INSTRUMENT
+        if (map_tile_width_ > 0 && map_tile_height_ > 0)
+        {
+            thread_stats.cost_map.init(map_width_, map_height_, map_tile_width_, map_tile_height_);
+        }
+#else
+        (void)thread_stats;
+#endif
+    }
+
+    void
+    StatsRecorder::
+    merge(const TransformStats& thread_stats)
+    {
+#ifdef PHTR_INSTRUMENT
+#ifdef HAVE_OPENMP
+#pragma omp critical (phtr_stats_merge)
+#endif
+        {
+            stats_ += thread_stats;
+            ++num_merged_;
+        }
+#else
+        (void)thread_stats;
+#endif
+    }
+
+} // namespace phtr
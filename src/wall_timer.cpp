@@ -0,0 +1,84 @@
+/*
+
+Photoropter: lens correction for digital cameras
+
+Copyright (c) 2010 Robert Fendt
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+*/
+
+
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#endif
+
+#include <photoropter/wall_timer.h>
+
+namespace phtr
+{
+
+    WallTimer::
+    WallTimer()
+            : t0_(now())
+    {
+        //NIL
+    }
+
+    void
+    WallTimer::
+    start()
+    {
+        t0_ = now();
+    }
+
+    double
+    WallTimer::
+    elapsed() const
+    {
+        return now() - t0_;
+    }
+
+    double
+    WallTimer::
+    now()
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER freq;
+        LARGE_INTEGER count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return static_cast<double>(count.QuadPart) / static_cast<double>(freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<double>(ts.tv_sec) + 1e-9 * static_cast<double>(ts.tv_nsec);
+#else
+        // no monotonic clock available
+        timeval tv;
+        gettimeofday(&tv, 0);
+        return static_cast<double>(tv.tv_sec) + 1e-6 * static_cast<double>(tv.tv_usec);
+#endif
+    }
+
+} // namespace phtr
@@ -0,0 +1,402 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <photoropter/wall_timer.h>
+
+#include "batch.h"
+#include "bounded_queue.h"
+#include "image_frame.h"
+#include "transform_wrapper.h"
+
+namespace
+{
+
+    class BatchPipeline
+    {
+        public:
+            BatchPipeline(const Settings& settings, const std::vector<BatchJob>& jobs, BatchResult& result)
+                    : settings_(settings),
+                    jobs_(jobs),
+                    result_(result),
+                    next_job_(0),
+                    active_decoders_(0),
+                    decoded_(settings.queue_size),
+                    transformed_(settings.queue_size)
+            {
+                //NIL
+            }
+
+        public:
+            void run();
+
+        public:
+            // stage 1 (I/O threads)
+            void decode();
+
+            // stage 3 (I/O threads)
+            void encode();
+
+        private:
+            // stage 2 (calling thread)
+            void transform();
+
+            // set up the transformation (if needed) and apply it; false if the
+            // image format is not supported
+            bool transform_frame(std::auto_ptr<TransformWrapperBase>& tf, ImageFrame& frame);
+
+            void failed(const std::string& msg);
+
+        private:
+            const Settings& settings_;
+            const std::vector<BatchJob>& jobs_;
+            BatchResult& result_;
+
+            size_t next_job_;
+            unsigned int active_decoders_;
+            boost::mutex mutex_;
+
+            BoundedQueue<ImageFrame*> decoded_;
+            BoundedQueue<ImageFrame*> transformed_;
+    };
+
+    struct DecodeTask
+    {
+        explicit DecodeTask(BatchPipeline& pipeline_)
+                : pipeline(pipeline_)
+        {
+            //NIL
+        }
+
+        void operator()()
+        {
+            pipeline.decode();
+        }
+
+        BatchPipeline& pipeline;
+    };
+
+    struct EncodeTask
+    {
+        explicit EncodeTask(BatchPipeline& pipeline_)
+                : pipeline(pipeline_)
+        {
+            //NIL
+        }
+
+        void operator()()
+        {
+            pipeline.encode();
+        }
+
+        BatchPipeline& pipeline;
+    };
+
+    void BatchPipeline::run()
+    {
+        const unsigned int io_threads = (settings_.io_threads > 0) ? settings_.io_threads : 1;
+        active_decoders_ = io_threads;
+
+        boost::thread_group decoders;
+        boost::thread_group encoders;
+        for (unsigned int i = 0; i < io_threads; ++i)
+        {
+            decoders.create_thread(DecodeTask(*this));
+            encoders.create_thread(EncodeTask(*this));
+        }
+
+        transform();
+
+        decoders.join_all();
+        encoders.join_all();
+    }
+
+    void BatchPipeline::decode()
+    {
+        for (;;)
+        {
+            size_t job_idx(0);
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                if (next_job_ >= jobs_.size())
+                {
+                    break;
+                }
+                job_idx = next_job_++;
+            }
+
+            const BatchJob& job = jobs_[job_idx];
+            ImageFrame* frame(0);
+            try
+            {
+                frame = ImageFrame::load(settings_, job.inp_file, job.outp_file);
+            }
+            catch (const std::exception& e)
+            {
+                failed("Error: cannot read " + job.inp_file + ": " + e.what());
+                continue;
+            }
+            catch (...)
+            {
+                failed("Error: cannot read " + job.inp_file);
+                continue;
+            }
+
+            if (frame)
+            {
+                decoded_.push(frame);
+            }
+            else
+            {
+                failed("Error: cannot read " + job.inp_file);
+            }
+        }
+
+        // the last decoder ends the stream
+        boost::mutex::scoped_lock lock(mutex_);
+        if (--active_decoders_ == 0)
+        {
+            decoded_.close();
+        }
+    }
+
+    void BatchPipeline::transform()
+    {
+        std::auto_ptr<TransformWrapperBase> tf;
+        ImageFrame* frame(0);
+
+        // errors only affect the current frame; the encoders always get the end of
+        // the stream, so no thread is left waiting
+        while (decoded_.pop(frame))
+        {
+            try
+            {
+                if (!transform_frame(tf, *frame))
+                {
+                    failed("Error: unsupported image format: " + frame->inp_file);
+                    delete frame;
+                    continue;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                failed("Error: cannot transform " + frame->inp_file + ": " + e.what());
+                tf.reset();
+                delete frame;
+                continue;
+            }
+            catch (...)
+            {
+                failed("Error: cannot transform " + frame->inp_file);
+                tf.reset();
+                delete frame;
+                continue;
+            }
+
+            if (settings_.verbose)
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                std::cerr << "Transformed " << frame->inp_file << std::endl;
+            }
+
+            transformed_.push(frame);
+        }
+
+        transformed_.close();
+    }
+
+    bool BatchPipeline::transform_frame(std::auto_ptr<TransformWrapperBase>& tf, ImageFrame& frame)
+    {
+        phtr::WallTimer timer;
+
+        // set up a new transformation only if size or storage type change
+        if (!tf.get() || !tf->accepts(frame))
+        {
+            tf.reset(TransformWrapperBase::get_instance(settings_, frame));
+            if (!tf.get())
+            {
+                return false;
+            }
+
+            tf->setup();
+            tf->auto_scale();
+            ++result_.num_setups;
+        }
+
+        frame.create_output();
+        tf->do_transform(frame);
+        result_.transform_time += timer.elapsed();
+
+        return true;
+    }
+
+    void BatchPipeline::encode()
+    {
+        ImageFrame* frame(0);
+
+        while (transformed_.pop(frame))
+        {
+            bool saved(false);
+            std::string error;
+            try
+            {
+                saved = frame->save();
+            }
+            catch (const std::exception& e)
+            {
+                error = std::string(": ") + e.what();
+            }
+            catch (...)
+            {
+                //NIL
+            }
+
+            if (saved)
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                ++result_.num_done;
+                if (settings_.verbose)
+                {
+                    std::cerr << "Saved " << frame->outp_file << std::endl;
+                }
+            }
+            else
+            {
+                failed("Error: cannot write " + frame->outp_file + error);
+            }
+
+            delete frame;
+        }
+    }
+
+    void BatchPipeline::failed(const std::string& msg)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        ++result_.num_failed;
+        std::cerr << msg << std::endl;
+    }
+
+} // anonymous namespace
+
+bool read_batch_list(const std::string& list_file, std::vector<BatchJob>& jobs)
+{
+    std::ifstream file(list_file.c_str());
+    if (!file)
+    {
+        std::cerr << "Error: cannot open batch list " << list_file << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t line_no(0);
+    while (std::getline(file, line))
+    {
+        ++line_no;
+
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        std::istringstream sstr(line);
+        std::string inp_file;
+        std::string outp_file;
+        if (!(sstr >> inp_file))
+        {
+            continue;
+        }
+
+        if (!(sstr >> outp_file))
+        {
+            std::cerr << "Error: no output file in line " << line_no << " of " << list_file << std::endl;
+            return false;
+        }
+
+        jobs.push_back(BatchJob(inp_file, outp_file));
+    }
+
+    return true;
+}
+
+bool read_batch_dir(const std::string& inp_dir, const std::string& outp_dir, std::vector<BatchJob>& jobs)
+{
+    namespace fs = boost::filesystem;
+
+    const fs::path inp_path(inp_dir);
+    const fs::path outp_path(outp_dir);
+
+    if (!fs::is_directory(inp_path))
+    {
+        std::cerr << "Error: " << inp_dir << " is not a directory" << std::endl;
+        return false;
+    }
+
+    if (!fs::is_directory(outp_path))
+    {
+        std::cerr << "Error: " << outp_dir << " is not a directory" << std::endl;
+        return false;
+    }
+
+    if (fs::equivalent(inp_path, outp_path))
+    {
+        std::cerr << "Error: input and output directory are identical" << std::endl;
+        return false;
+    }
+
+    // sort by name for a reproducible order
+    std::vector<fs::path> files;
+    for (fs::directory_iterator it(inp_path); it != fs::directory_iterator(); ++it)
+    {
+        if (fs::is_regular_file(it->status()))
+        {
+            files.push_back(it->path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        jobs.push_back(BatchJob(files[i].string(), (outp_path / files[i].filename()).string()));
+    }
+
+    return true;
+}
+
+void run_batch(const Settings& settings, const std::vector<BatchJob>& jobs, BatchResult& result)
+{
+    phtr::WallTimer timer;
+
+    BatchPipeline pipeline(settings, jobs, result);
+    pipeline.run();
+
+    result.wall_time = timer.elapsed();
+}
@@ -0,0 +1,91 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTRX_BATCH_H__
+#define PHTRX_BATCH_H__
+
+#include <string>
+#include <vector>
+
+#include "settings.h"
+
+/**
+ * @brief One input/output file pair of a batch.
+ */
+struct BatchJob
+{
+    BatchJob(const std::string& inp_file_, const std::string& outp_file_)
+            : inp_file(inp_file_),
+            outp_file(outp_file_)
+    {
+        //NIL
+    }
+
+    std::string inp_file;
+    std::string outp_file;
+};
+
+/**
+ * @brief Summary of a batch run.
+ */
+struct BatchResult
+{
+    BatchResult()
+            : num_done(0),
+            num_failed(0),
+            num_setups(0),
+            wall_time(0.0),
+            transform_time(0.0)
+    {
+        //NIL
+    }
+
+    size_t num_done;
+    size_t num_failed;
+
+    // number of transformation set-ups (one per image size and storage type)
+    size_t num_setups;
+
+    // total wall time and time spent in the transformation stage (in seconds)
+    double wall_time;
+    double transform_time;
+};
+
+/**
+ * @brief Read a batch list: one 'input output' file pair per line ('#' starts a comment).
+ */
+bool read_batch_list(const std::string& list_file, std::vector<BatchJob>& jobs);
+
+/**
+ * @brief Create jobs for all files in a directory; the output files get the same names in outp_dir.
+ */
+bool read_batch_dir(const std::string& inp_dir, const std::string& outp_dir, std::vector<BatchJob>& jobs);
+
+/**
+ * @brief Process the jobs in a three-stage pipeline.
+ * @details Decoding and encoding run on settings.io_threads threads each, the transformation
+ * (parallelised by OpenMP) in the calling thread. The stages are connected by queues
+ * of settings.queue_size frames. The transformation is set up once and reused for all
+ * images of the same size and storage type.
+ */
+void run_batch(const Settings& settings, const std::vector<BatchJob>& jobs, BatchResult& result);
+
+#endif // PHTRX_BATCH_H__
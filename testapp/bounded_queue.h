@@ -0,0 +1,70 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTRX_BOUNDED_QUEUE_H__
+#define PHTRX_BOUNDED_QUEUE_H__
+
+#include <deque>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+/**
+ * @brief Thread-safe FIFO queue with a maximum size.
+ * @details Producers block while the queue is full, consumers while it is empty.
+ * After close(), consumers drain the remaining items and then stop.
+ */
+template <typename T>
+class BoundedQueue
+{
+    public:
+        explicit BoundedQueue(size_t capacity);
+
+    public:
+        /**
+         * @brief Append an item (blocks while the queue is full).
+         */
+        void push(const T& item);
+
+        /**
+         * @brief Remove the oldest item (blocks while the queue is empty).
+         * @return false if the queue has been closed and is empty.
+         */
+        bool pop(T& item);
+
+        /**
+         * @brief Signal that no more items will be pushed.
+         */
+        void close();
+
+    private:
+        const size_t capacity_;
+        bool closed_;
+        std::deque<T> items_;
+
+        boost::mutex mutex_;
+        boost::condition_variable not_empty_;
+        boost::condition_variable not_full_;
+};
+
+#include "bounded_queue.tpl.h"
+
+#endif // PHTRX_BOUNDED_QUEUE_H__
@@ -0,0 +1,80 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+template <typename T>
+BoundedQueue<T>::
+BoundedQueue(size_t capacity)
+        : capacity_((capacity > 0) ? capacity : 1),
+        closed_(false)
+{
+    //NIL
+}
+
+template <typename T>
+void
+BoundedQueue<T>::
+push(const T& item)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    while (items_.size() >= capacity_)
+    {
+        not_full_.wait(lock);
+    }
+
+    items_.push_back(item);
+    not_empty_.notify_one();
+}
+
+template <typename T>
+bool
+BoundedQueue<T>::
+pop(T& item)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    while (items_.empty() && !closed_)
+    {
+        not_empty_.wait(lock);
+    }
+
+    if (items_.empty())
+    {
+        return false;
+    }
+
+    item = items_.front();
+    items_.pop_front();
+    not_full_.notify_one();
+
+    return true;
+}
+
+template <typename T>
+void
+BoundedQueue<T>::
+close()
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    closed_ = true;
+    not_empty_.notify_all();
+}
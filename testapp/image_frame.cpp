@@ -0,0 +1,195 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <vil/vil_load.h>
+
+#include "image_frame.h"
+
+ImageFrame::
+ImageFrame(phtr::mem::Storage::type storage_type_, const std::string& inp_file_,
+           const std::string& outp_file_)
+        : storage_type(storage_type_),
+        inp_file(inp_file_),
+        outp_file(outp_file_),
+        img_width(0),
+        img_height(0),
+        dst_width(0),
+        dst_height(0),
+        in_place(false),
+        inp_line_step(0)
+{
+    //NIL
+}
+
+void
+ImageFrame::
+init_dimensions(const Settings& settings, size_t width, size_t height)
+{
+    // set image width and height
+    img_width = width;
+    img_height = height;
+    dst_width = img_width;
+    dst_height = img_height;
+    std::stringstream sstr;
+    sstr << "Image dimensions: " << img_width << "x" << img_height;
+    log(settings, sstr.str());
+
+    // 'sanity checks' on ROI settings
+    size_t sub_rect_x0 = settings.sub_rect_x0;
+    size_t sub_rect_y0 = settings.sub_rect_y0;
+    if (settings.sub_rect && settings.sub_rect_w <= img_width && settings.sub_rect_h <= img_height)
+    {
+        dst_width = settings.sub_rect_w;
+        dst_height = settings.sub_rect_h;
+    }
+    if (sub_rect_x0 > img_height - dst_width || sub_rect_y0 > img_height - dst_height)
+    {
+        sub_rect_x0 = 0;
+        sub_rect_y0 = 0;
+    }
+    {
+        std::stringstream sstr;
+        sstr << "Clip rectangle: " << dst_width << "x" << dst_height << " " << sub_rect_x0 << ":" << sub_rect_y0;
+        log(settings, sstr.str());
+    }
+
+    // in-place operation is only possible if the output has the input dimensions
+    in_place = settings.in_place && (dst_width == img_width) && (dst_height == img_height);
+    if (settings.in_place && !in_place)
+    {
+        log(settings, "Clip rectangle given, in-place transformation disabled.");
+    }
+}
+
+ImageFrame*
+ImageFrame::
+load(const Settings& settings, const std::string& inp_file, const std::string& outp_file)
+{
+    using phtr::mem::Storage;
+
+    Storage::type storage_type = get_storage_type(inp_file);
+
+    if (storage_type == Storage::rgb_8_inter)
+    {
+        log(settings, "8bit RGB data");
+        return new ImageFrameT<Storage::rgb_8_inter>(settings, inp_file, outp_file);
+    }
+    else if (storage_type == Storage::rgb_16_inter)
+    {
+        log(settings, "16bit RGB data");
+        return new ImageFrameT<Storage::rgb_16_inter>(settings, inp_file, outp_file);
+    }
+    else if (storage_type == Storage::rgb_32_inter)
+    {
+        log(settings, "32bit RGB data");
+        return new ImageFrameT<Storage::rgb_32_inter>(settings, inp_file, outp_file);
+    }
+    else if (storage_type == Storage::rgba_8_inter)
+    {
+        log(settings, "8bit RGBA data");
+        return new ImageFrameT<Storage::rgba_8_inter>(settings, inp_file, outp_file);
+    }
+    else if (storage_type == Storage::rgba_16_inter)
+    {
+        log(settings, "16bit RGBA data");
+        return new ImageFrameT<Storage::rgba_16_inter>(settings, inp_file, outp_file);
+    }
+    else if (storage_type == Storage::rgba_32_inter)
+    {
+        log(settings, "32bit RGBA data");
+        return new ImageFrameT<Storage::rgba_32_inter>(settings, inp_file, outp_file);
+    }
+
+    return 0;
+}
+
+phtr::mem::Storage::type
+ImageFrame::
+get_storage_type(const std::string& inp_file)
+{
+    using phtr::mem::Storage;
+    Storage::type phtr_storage = Storage::unknown;
+
+    // PPM/PAM/PFM files are read directly if their format is supported
+    MappedFile map;
+    RawHeader header;
+    if (map.open_read(inp_file) && parse_raw_header(map.data(), map.size(), header))
+    {
+        phtr_storage = header.storage_type();
+        if (phtr_storage != Storage::unknown)
+        {
+            return phtr_storage;
+        }
+    }
+
+    vil_image_resource_sptr img_res = vil_load_image_resource(inp_file.c_str());
+    if (!img_res)
+    {
+        return phtr_storage;
+    }
+
+    vil_pixel_format vil_img_format = img_res->pixel_format();
+
+    unsigned int num_components = img_res->nplanes();
+
+    if (num_components == 3)
+    {
+        if (vil_img_format == VIL_PIXEL_FORMAT_BYTE)
+        {
+            phtr_storage = Storage::rgb_8_inter;
+        }
+        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_16)
+        {
+            phtr_storage = Storage::rgb_16_inter;
+        }
+        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_32)
+        {
+            phtr_storage = Storage::rgb_32_inter;
+        }
+    }
+    else if (num_components == 4)
+    {
+        if (vil_img_format == VIL_PIXEL_FORMAT_BYTE)
+        {
+            phtr_storage = Storage::rgba_8_inter;
+        }
+        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_16)
+        {
+            phtr_storage = Storage::rgba_16_inter;
+        }
+        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_32)
+        {
+            phtr_storage = Storage::rgba_32_inter;
+        }
+    }
+
+    return phtr_storage;
+}
+
+void
+ImageFrame::
+log(const Settings& settings, const std::string& msg)
+{
+    if (settings.verbose)
+    {
+        std::cerr << msg << std::endl;
+    }
+}
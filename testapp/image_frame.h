@@ -0,0 +1,187 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTRX_IMAGE_FRAME_H__
+#define PHTRX_IMAGE_FRAME_H__
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include "vil_pixel_type.h"
+#include "raw_image.h"
+#include "settings.h"
+
+#include <photoropter/mem/storage_type.h>
+#include <photoropter/mem/mem_storage_info.h>
+#include <photoropter/image_buffer.h>
+
+#include <vil/vil_convert.h>
+#include <vil/vil_load.h>
+#include <vil/vil_save.h>
+
+/**
+ * @brief One image to be transformed: file names, dimensions and image buffers.
+ */
+class ImageFrame
+{
+
+    public:
+        /**
+         * @ brief (Dummy) Destructor.
+         */
+        virtual ~ImageFrame() {};
+
+    public:
+        /**
+         * @brief Load the given file into a frame of a compatible storage type.
+         * @return The new frame, or 0 if the file could not be read.
+         */
+        static ImageFrame* load(const Settings& settings, const std::string& inp_file,
+                                const std::string& outp_file);
+
+        /**
+         * @brief Determine a compatible storage type (i.e., check the bit depth of the given file)
+         */
+        static phtr::mem::Storage::type get_storage_type(const std::string& inp_file);
+
+    public:
+        /**
+         * @brief Create the output buffer (or the memory-mapped output file).
+         * @details Only call this once the transformation has been set up, so that
+         * rejected images leave no output file behind. Repeated calls have no effect.
+         */
+        virtual void create_output() = 0;
+
+        /**
+         * @brief Save the transformation result to the output file.
+         * @return false if the file could not be written.
+         */
+        virtual bool save() = 0;
+
+        /**
+         * @brief Keep a copy of the input data (for repeated in-place transformations).
+         */
+        virtual void backup_input() = 0;
+
+        /**
+         * @brief Restore the input data from the copy made by backup_input().
+         */
+        virtual void restore_input() = 0;
+
+        /**
+         * @brief Return the input buffer.
+         */
+        virtual void* input_data() = 0;
+
+        /**
+         * @brief Return the output buffer (i.e., the input buffer for in-place transformations).
+         */
+        virtual void* output_data() = 0;
+
+    public:
+        const phtr::mem::Storage::type storage_type;
+        const std::string inp_file;
+        const std::string outp_file;
+
+        size_t img_width;
+        size_t img_height;
+        size_t dst_width;
+        size_t dst_height;
+        bool in_place;
+
+        // distance between input lines, in channel storage units (the decoder's
+        // buffer is used directly if possible, its lines may be padded)
+        size_t inp_line_step;
+
+    protected:
+        ImageFrame(phtr::mem::Storage::type storage_type_, const std::string& inp_file_,
+                   const std::string& outp_file_);
+
+        /**
+         * @brief Set the image/output dimensions and decide on in-place operation.
+         */
+        void init_dimensions(const Settings& settings, size_t width, size_t height);
+
+    private:
+        /**
+         * @brief Log messages according to settings
+         */
+        static void log(const Settings& settings, const std::string& msg);
+
+};
+
+template <phtr::mem::Storage::type storage_T>
+class ImageFrameT : public ImageFrame
+{
+    public:
+        typedef phtr::ImageBuffer<storage_T> buffer_t;
+        typedef typename phtr::mem::MemStorageInfo<storage_T>::channel_storage_t channel_storage_t;
+        typedef typename VILPixelType<storage_T>::vil_pixel_t vil_pixel_t;
+
+    public:
+        ImageFrameT(const Settings& settings, const std::string& inp_file, const std::string& outp_file);
+        ~ImageFrameT();
+        void create_output();
+        bool save();
+        void backup_input();
+        void restore_input();
+        void* input_data();
+        void* output_data();
+
+    private:
+        void read(const Settings& settings);
+        void read_vil(const Settings& settings);
+        void read_raw(const Settings& settings, const RawHeader& header, std::auto_ptr<MappedFile> map);
+        bool save_raw(RawFormat::type format);
+        size_t input_bytes() const;
+        void log(const std::string& msg);
+
+    private:
+        static const unsigned int num_components_ = VILPixelType<storage_T>::num_components;
+
+        const bool verbose_;
+
+        // the output file replaces the input file (which must then not be mapped)
+        const bool overwrite_input_;
+
+        vil_image_view<vil_pixel_t> decoded_img_;
+        std::auto_ptr<buffer_t> input_buffer_;
+        std::auto_ptr<buffer_t> output_buffer_;
+        std::vector<char> backup_;
+
+        // memory-mapped PPM/PAM input and output files
+        std::auto_ptr<MappedFile> inp_map_;
+        std::auto_ptr<MappedFile> outp_map_;
+        size_t inp_payload_offs_;
+        size_t outp_payload_offs_;
+};
+
+#include "image_frame.tpl.h"
+
+#endif // PHTRX_IMAGE_FRAME_H__
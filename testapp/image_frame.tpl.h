@@ -0,0 +1,388 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+template <phtr::mem::Storage::type storage_T>
+ImageFrameT<storage_T>::
+ImageFrameT(const Settings& settings, const std::string& inp_file, const std::string& outp_file)
+        : ImageFrame(storage_T, inp_file, outp_file),
+        verbose_(settings.verbose),
+        overwrite_input_(same_file(inp_file, outp_file)),
+        inp_payload_offs_(0),
+        outp_payload_offs_(0)
+{
+    read(settings);
+}
+
+template <phtr::mem::Storage::type storage_T>
+ImageFrameT<storage_T>::
+~ImageFrameT()
+{
+    // a mapped output file that was never saved is incomplete
+    if (outp_map_.get() && outp_map_->data())
+    {
+        outp_map_->close();
+        std::remove(outp_file.c_str());
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+read(const Settings& settings)
+{
+    // PPM/PAM/PFM files with a matching storage type are mapped into memory
+    std::auto_ptr<MappedFile> map(new MappedFile);
+    RawHeader header;
+    if (map->open_read(inp_file) && parse_raw_header(map->data(), map->size(), header)
+            && header.storage_type() == storage_T
+            && header.payload_size() <= map->size() - header.payload_offs)
+    {
+        read_raw(settings, header, map);
+    }
+    else
+    {
+        map.reset();
+        read_vil(settings);
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+read_vil(const Settings& settings)
+{
+    vil_image_view<vil_pixel_t> loaded_img =
+        vil_convert_to_component_order(
+            vil_convert_to_n_planes(
+                num_components_, vil_load(inp_file.c_str())
+            )
+        );
+
+    init_dimensions(settings, loaded_img.ni(), loaded_img.nj());
+
+    // use the decoded image directly if the pixels are interleaved and the lines
+    // ascending (the streaming transformation needs unpadded lines, though)
+    const vcl_ptrdiff_t width_px = static_cast<vcl_ptrdiff_t>(img_width);
+    const bool use_decoded = (loaded_img.nplanes() == 1) && (loaded_img.istep() == 1)
+                             && (in_place ? (loaded_img.jstep() == width_px) : (loaded_img.jstep() >= width_px));
+
+    if (use_decoded)
+    {
+        log("Use decoded image buffer.");
+        decoded_img_ = loaded_img;
+        inp_line_step = static_cast<size_t>(loaded_img.jstep()) * num_components_;
+    }
+    else
+    {
+        inp_line_step = img_width * num_components_;
+        input_buffer_.reset(new buffer_t(img_width, img_height));
+
+        // attach a VIL view to the buffer
+        unsigned int width = static_cast<unsigned int>(img_width);
+        unsigned int height = static_cast<unsigned int>(img_height);
+        vil_image_view<vil_pixel_t> vil_input_view(
+            static_cast<vil_pixel_t*>(input_buffer_->data()), width, height, 1, 1, width, 1
+        );
+
+        // tell VIL to convert/copy data into the Photoropter buffer
+        vil_input_view.deep_copy(loaded_img);
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+read_raw(const Settings& settings, const RawHeader& header, std::auto_ptr<MappedFile> map)
+{
+    init_dimensions(settings, header.width, header.height);
+    inp_line_step = img_width * num_components_;
+
+    const char* payload = map->data() + header.payload_offs;
+    const size_t num_samples = img_width * img_height * num_components_;
+
+    // 16 bit samples are big-endian, so they can only be used in place on big-endian
+    // hosts; little-endian hosts need a swapped copy anyway (the output file must not
+    // replace a mapped input file, either)
+    const bool need_swap = (sizeof(channel_storage_t) == 2 && host_is_little_endian());
+    if (header.format != RawFormat::pfm && header.payload_offs % sizeof(channel_storage_t) == 0
+            && !need_swap && !overwrite_input_)
+    {
+        log("Use memory-mapped input file.");
+        inp_payload_offs_ = header.payload_offs;
+        inp_map_ = map;
+        return;
+    }
+
+    input_buffer_.reset(new buffer_t(img_width, img_height));
+    channel_storage_t* dst = static_cast<channel_storage_t*>(input_buffer_->data());
+
+    if (header.format != RawFormat::pfm)
+    {
+        log("Copy memory-mapped input file.");
+        std::memcpy(dst, payload, num_samples * sizeof(channel_storage_t));
+        if (need_swap)
+        {
+            swap_bytes_16(dst, num_samples);
+        }
+        return;
+    }
+
+    // PFM: convert the floating point samples, lines are stored bottom to top
+    log("Convert PFM input file.");
+    const bool swap = (header.little_endian != host_is_little_endian());
+    const double max_val = std::numeric_limits<channel_storage_t>::max();
+    const size_t line_len = img_width * num_components_;
+
+    for (size_t y = 0; y < img_height; ++y)
+    {
+        const char* src = payload + (img_height - 1 - y) * line_len * sizeof(float);
+        for (size_t i = 0; i < line_len; ++i, src += sizeof(float), ++dst)
+        {
+            float val;
+            std::memcpy(&val, src, sizeof(float));
+            if (swap)
+            {
+                swap_bytes_32(&val, 1);
+            }
+
+            double tmp = std::max(0.0, std::min(1.0, static_cast<double>(val)));
+            *dst = static_cast<channel_storage_t>(tmp * max_val + 0.5);
+        }
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+create_output()
+{
+    if (in_place || outp_map_.get() || output_buffer_.get())
+    {
+        return;
+    }
+
+    // write PPM/PAM output directly into a mapped file
+    const RawFormat::type format = raw_format_for_file(outp_file);
+    if (sizeof(channel_storage_t) <= 2 && !overwrite_input_
+            && ((format == RawFormat::ppm && num_components_ == 3) || format == RawFormat::pam))
+    {
+        RawHeader header;
+        header.format = format;
+        header.width = dst_width;
+        header.height = dst_height;
+        header.depth = num_components_;
+        header.maxval = std::numeric_limits<channel_storage_t>::max();
+
+        // align the payload with a comment line if necessary
+        std::string header_str = make_raw_header(header);
+        if (header_str.size() % sizeof(channel_storage_t) != 0)
+        {
+            header_str.insert(3, "# \n");
+        }
+
+        std::auto_ptr<MappedFile> map(new MappedFile);
+        if (map->create(outp_file, header_str.size() + header.payload_size()))
+        {
+            log("Use memory-mapped output file.");
+            std::copy(header_str.begin(), header_str.end(), map->data());
+            outp_payload_offs_ = header_str.size();
+            outp_map_ = map;
+            return;
+        }
+    }
+
+    output_buffer_.reset(new buffer_t(dst_width, dst_height));
+}
+
+template <phtr::mem::Storage::type storage_T>
+bool
+ImageFrameT<storage_T>::
+save()
+{
+    if (outp_map_.get())
+    {
+        // PPM/PAM samples are big-endian
+        if (sizeof(channel_storage_t) == 2 && host_is_little_endian())
+        {
+            swap_bytes_16(output_data(), dst_width * dst_height * num_components_);
+        }
+
+        outp_map_->close();
+        return true;
+    }
+
+    const RawFormat::type format = raw_format_for_file(outp_file);
+    if (format != RawFormat::none && save_raw(format))
+    {
+        return true;
+    }
+
+    unsigned int width = static_cast<unsigned int>(dst_width);
+    unsigned int height = static_cast<unsigned int>(dst_height);
+    vcl_ptrdiff_t line_step = in_place ? static_cast<vcl_ptrdiff_t>(inp_line_step / num_components_) : width;
+    vil_image_view<vil_pixel_t> vil_output_view
+    (static_cast<vil_pixel_t*>(output_data()), width, height, 1, 1, line_step, 1);
+
+    return vil_save(vil_output_view, outp_file.c_str());
+}
+
+template <phtr::mem::Storage::type storage_T>
+bool
+ImageFrameT<storage_T>::
+save_raw(RawFormat::type format)
+{
+    // PPM and PFM only store RGB; PPM/PAM samples are at most 16 bit
+    if ((format != RawFormat::pam && num_components_ != 3)
+            || (format != RawFormat::pfm && sizeof(channel_storage_t) > 2))
+    {
+        return false;
+    }
+
+    std::ofstream outp(outp_file.c_str(), std::ios::out | std::ios::binary);
+    if (!outp)
+    {
+        return false;
+    }
+
+    RawHeader header;
+    header.format = format;
+    header.width = dst_width;
+    header.height = dst_height;
+    header.depth = num_components_;
+    header.maxval = std::numeric_limits<channel_storage_t>::max();
+    header.little_endian = host_is_little_endian();
+
+    const std::string header_str = make_raw_header(header);
+    outp.write(header_str.data(), static_cast<std::streamsize>(header_str.size()));
+
+    const size_t line_len = dst_width * num_components_;
+    const size_t line_step = in_place ? inp_line_step : line_len;
+    const channel_storage_t* data = static_cast<const channel_storage_t*>(output_data());
+
+    if (format == RawFormat::pfm)
+    {
+        // lines are stored bottom to top
+        const double max_val = std::numeric_limits<channel_storage_t>::max();
+        std::vector<float> line(line_len);
+        for (size_t y = dst_height; y > 0; --y)
+        {
+            const channel_storage_t* src = data + (y - 1) * line_step;
+            for (size_t i = 0; i < line_len; ++i)
+            {
+                line[i] = static_cast<float>(src[i] / max_val);
+            }
+            outp.write(reinterpret_cast<const char*>(&line[0]),
+                       static_cast<std::streamsize>(line_len * sizeof(float)));
+        }
+    }
+    else
+    {
+        const bool swap = (sizeof(channel_storage_t) == 2 && host_is_little_endian());
+        std::vector<channel_storage_t> line(line_len);
+        for (size_t y = 0; y < dst_height; ++y)
+        {
+            const channel_storage_t* src = data + y * line_step;
+            std::copy(src, src + line_len, line.begin());
+            if (swap)
+            {
+                swap_bytes_16(&line[0], line_len);
+            }
+            outp.write(reinterpret_cast<const char*>(&line[0]),
+                       static_cast<std::streamsize>(line_len * sizeof(channel_storage_t)));
+        }
+    }
+
+    return static_cast<bool>(outp);
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+backup_input()
+{
+    const char* src = static_cast<const char*>(input_data());
+    backup_.assign(src, src + input_bytes());
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+restore_input()
+{
+    if (!backup_.empty())
+    {
+        std::copy(backup_.begin(), backup_.end(), static_cast<char*>(input_data()));
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void*
+ImageFrameT<storage_T>::
+input_data()
+{
+    if (input_buffer_.get())
+    {
+        return input_buffer_->data();
+    }
+    else if (inp_map_.get())
+    {
+        return inp_map_->data() + inp_payload_offs_;
+    }
+
+    return decoded_img_.top_left_ptr();
+}
+
+template <phtr::mem::Storage::type storage_T>
+void*
+ImageFrameT<storage_T>::
+output_data()
+{
+    if (in_place)
+    {
+        return input_data();
+    }
+    else if (outp_map_.get())
+    {
+        return outp_map_->data() + outp_payload_offs_;
+    }
+
+    return output_buffer_->data();
+}
+
+template <phtr::mem::Storage::type storage_T>
+size_t
+ImageFrameT<storage_T>::
+input_bytes() const
+{
+    // (the last line need not be padded)
+    return ((img_height - 1) * inp_line_step + img_width * num_components_) * sizeof(channel_storage_t);
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+ImageFrameT<storage_T>::
+log(const std::string& msg)
+{
+    if (verbose_)
+    {
+        std::cerr << msg << std::endl;
+    }
+}
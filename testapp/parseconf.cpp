@@ -76,12 +76,15 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
          " (blue channel shift, use for TCA)")
         ("tca", po::value<std::string>(), "Set linear TCA correction: kr:kb")
         ("vignetting,c", po::value<std::string>(), "Set vignetting correction parameters: a:b:c")
+        ("exposure", po::value<double>(), "Exposure correction in stops (EV)")
+        ("wb", po::value<std::string>(), "White balance gains: r:g:b")
         ("param-aspect", po::value<double>(), "Aspect ratio used for parameter calibration")
         ("param-crop", po::value<double>(), "Crop factor used for parameter calibration")
         ("image-crop", po::value<double>(), "Diagonal image crop factor")
         ("scale,s", po::value<double>(), "Linear scaling factor")
         ("autoscale", "enable auto-scaling")
         ("sub-rect", po::value<std::string>(), "Clip a sub-rectangle from the image: x0:y0:width:height")
+        ("in-place", "transform the image in place (saves memory; ignored with --sub-rect)")
         ("gain-func", po::value<std::string>(), "Type of gain function:\n"
          "  srgb    - sRGB gamma (default)\n"
          "  gamma   - generic gamma\n"
@@ -103,6 +106,18 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
          "  fish_stereo    stereographic fisheye\n"
          "  fish_ortho     orthographic fisheye")
         ("flen", po::value<std::string>(), "Focal lengths: f1:f2 (used for geometry conversion)")
+        ("cost-map", po::value<std::string>(), "Write a per-tile cost map (.csv or .pgm; needs a library"
+         " built with PHTR_INSTRUMENT)")
+        ("cost-tile", po::value<unsigned>(), "Cost map tile size in pixels (default: 64)")
+        ("repeat,n", po::value<unsigned>(), "Number of timed transformation runs; if > 1, an untimed"
+         " warm-up run is done first and min/median times are reported (default: 1)")
+        ("threads,t", po::value<unsigned>(), "Number of threads (default: OpenMP default)")
+        ("batch", po::value<std::string>(), "Batch mode: file with one 'input output' file pair per line")
+        ("batch-dir", po::value<std::string>(), "Batch mode: transform all files in this directory"
+         " (needs --output-dir)")
+        ("output-dir", po::value<std::string>(), "Batch mode: output directory for --batch-dir")
+        ("io-threads", po::value<unsigned>(), "Batch mode: number of decoding and encoding threads (default: 2)")
+        ("queue-size", po::value<unsigned>(), "Batch mode: images queued between pipeline stages (default: 2)")
         ("input-file", po::value<std::string>(), "Input file")
         ("output-file", po::value<std::string>(), "Output file");
 
@@ -153,11 +168,35 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
             settings.auto_scale = true;
         }
 
+        if (options_map.count("in-place"))
+        {
+            settings.in_place = true;
+        }
+
+        if (options_map.count("batch"))
+        {
+            settings.batch_list = options_map["batch"].as<std::string>();
+        }
+
+        if (options_map.count("batch-dir"))
+        {
+            settings.batch_dir = options_map["batch-dir"].as<std::string>();
+
+            if (!options_map.count("output-dir"))
+            {
+                std::cerr << "Error: --batch-dir needs --output-dir" << std::endl;
+                return false;
+            }
+            settings.batch_outp_dir = options_map["output-dir"].as<std::string>();
+        }
+
+        const bool batch_mode = !settings.batch_list.empty() || !settings.batch_dir.empty();
+
         if (options_map.count("input-file"))
         {
             settings.inp_file = options_map["input-file"].as<std::string>();
         }
-        else
+        else if (!batch_mode)
         {
             std::cerr << "Error: no input file given" << std::endl;
             return false;
@@ -167,12 +206,38 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
         {
             settings.outp_file = options_map["output-file"].as<std::string>();
         }
-        else
+        else if (!batch_mode)
         {
             std::cerr << "Error: no output file given" << std::endl;
             return false;
         }
 
+        if (batch_mode && !settings.inp_file.empty())
+        {
+            std::cerr << "Error: input/output file given in batch mode" << std::endl;
+            return false;
+        }
+
+        if (options_map.count("io-threads"))
+        {
+            settings.io_threads = options_map["io-threads"].as<unsigned>();
+            if (settings.io_threads < 1)
+            {
+                std::cerr << "Error: number of I/O threads must be >= 1" << std::endl;
+                return false;
+            }
+        }
+
+        if (options_map.count("queue-size"))
+        {
+            settings.queue_size = options_map["queue-size"].as<unsigned>();
+            if (settings.queue_size < 1)
+            {
+                std::cerr << "Error: queue size must be >= 1" << std::endl;
+                return false;
+            }
+        }
+
         if (options_map.count("centre-shift"))
         {
             typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
@@ -381,6 +446,43 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
 
         }
 
+        if (options_map.count("exposure"))
+        {
+            settings.exposure = options_map["exposure"].as<double>();
+        }
+
+        if (options_map.count("wb"))
+        {
+            typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+            typedef boost::char_separator<char> separator_t;
+
+            std::string param_string = options_map["wb"].as<std::string>();
+
+            separator_t sep(":;");
+            tokenizer_t tokens(param_string, sep);
+
+            std::list<double> tmp_list;
+            for (tokenizer_t::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+            {
+                std::stringstream sstr(*it);
+                double tmp_val;
+                sstr >> tmp_val;
+                tmp_list.push_back(tmp_val);
+            }
+
+            size_t num_params = tmp_list.size();
+            if (num_params == 3)
+            {
+                std::copy(tmp_list.begin(), tmp_list.end(), settings.wb_gains.begin());
+            }
+            else
+            {
+                std::cerr << "Error: incorrect number of parameters for white balance" << std::endl;
+                return false;
+            }
+
+        }
+
         if (options_map.count("sub-rect"))
         {
             typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
@@ -489,6 +591,41 @@ bool parse_command_line(int argc, char* argv[], Settings& settings)
             settings.oversampling = options_map["oversample"].as<unsigned>();
         }
 
+        if (options_map.count("cost-map"))
+        {
+            settings.cost_map_file = options_map["cost-map"].as<std::string>();
+        }
+
+        if (options_map.count("cost-tile"))
+        {
+            settings.cost_map_tile = options_map["cost-tile"].as<unsigned>();
+            if (settings.cost_map_tile < 1)
+            {
+                std::cerr << "Error: cost map tile size must be >= 1" << std::endl;
+                return false;
+            }
+        }
+
+        if (options_map.count("repeat"))
+        {
+            settings.repeat = options_map["repeat"].as<unsigned>();
+            if (settings.repeat < 1)
+            {
+                std::cerr << "Error: repeat count must be >= 1" << std::endl;
+                return false;
+            }
+        }
+
+        if (options_map.count("threads"))
+        {
+            settings.threads = options_map["threads"].as<unsigned>();
+            if (settings.threads < 1)
+            {
+                std::cerr << "Error: thread count must be >= 1" << std::endl;
+                return false;
+            }
+        }
+
         if (options_map.count("geom"))
         {
             settings.geom_convert = true;
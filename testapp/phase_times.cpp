@@ -0,0 +1,57 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <algorithm>
+
+#include "phase_times.h"
+
+double
+PhaseTimes::
+transform_min() const
+{
+    if (transform.empty())
+    {
+        return 0.0;
+    }
+
+    return *std::min_element(transform.begin(), transform.end());
+}
+
+double
+PhaseTimes::
+transform_median() const
+{
+    if (transform.empty())
+    {
+        return 0.0;
+    }
+
+    std::vector<double> sorted(transform);
+    std::sort(sorted.begin(), sorted.end());
+
+    const size_t mid = sorted.size() / 2;
+    if (sorted.size() % 2 == 0)
+    {
+        return 0.5 * (sorted[mid - 1] + sorted[mid]);
+    }
+
+    return sorted[mid];
+}
@@ -0,0 +1,52 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTRX_PHASE_TIMES_H__
+#define PHTRX_PHASE_TIMES_H__
+
+#include <vector>
+
+/**
+ * @brief Wall clock times of the phtrx processing phases (in seconds).
+ */
+struct PhaseTimes
+{
+    PhaseTimes()
+            : load(0.0),
+            setup(0.0),
+            autoscale(0.0),
+            save(0.0)
+    {
+        //NIL
+    }
+
+    double load;
+    double setup;
+    double autoscale;
+    std::vector<double> transform;
+    double save;
+
+    // fastest and median transformation run
+    double transform_min() const;
+    double transform_median() const;
+};
+
+#endif // PHTRX_PHASE_TIMES_H__
@@ -6,6 +6,7 @@
 
   Usage example :
   phtrx --gain-func emor --param-aspect 1.5333 --vignetting 0:0:-0.3 --ptlens 0:0.00987:-0.05127 in.jpg out.jpg
+  phtrx --vignetting 0:0:-0.3 --ptlens 0:0.00987:-0.05127 --batch-dir raw/ --output-dir corrected/
 
 This program is free software: you can redistribute it and/or modify
 it under the terms of the GNU General Public License as published by
@@ -23,16 +24,163 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "parseconf.h"
+#include "phase_times.h"
+#include "batch.h"
+#include "image_frame.h"
 #include "transform_wrapper.h"
 
 #include <photoropter/version.h>
+#include <photoropter/wall_timer.h>
 
-#include <ctime>
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <iomanip>
 #include <iostream>
 #include <memory>
 
 const char APP_NAME[] = "phtrx";
 
+namespace
+{
+
+    void report_times(const PhaseTimes& times)
+    {
+        std::cerr << std::fixed << std::setprecision(2);
+        std::cerr << "Time taken [ms]: load " << times.load * 1e3
+                  << ", setup " << times.setup * 1e3
+                  << ", autoscale " << times.autoscale * 1e3
+                  << ", transform " << times.transform_min() * 1e3
+                  << ", save " << times.save * 1e3 << std::endl;
+
+        if (times.transform.size() > 1)
+        {
+            std::cerr << "Transformation [ms] (" << times.transform.size() << " runs after warm-up): min "
+                      << times.transform_min() * 1e3
+                      << ", median " << times.transform_median() * 1e3 << std::endl;
+        }
+    }
+
+    int transform_file(const Settings& settings)
+    {
+        PhaseTimes times;
+        phtr::WallTimer timer;
+
+        std::cerr << "Load file." << std::endl;
+        std::auto_ptr<ImageFrame> frame(ImageFrame::load(settings, settings.inp_file, settings.outp_file));
+        if (!frame.get())
+        {
+            std::cerr << "Error: cannot read " << settings.inp_file << std::endl;
+            return 1;
+        }
+        times.load = timer.elapsed();
+
+        std::cerr << "Set up transformation." << std::endl;
+        timer.start();
+        std::auto_ptr<TransformWrapperBase> tf(TransformWrapperBase::get_instance(settings, *frame));
+        if (!tf.get())
+        {
+            std::cerr << "Error: unsupported image format: " << settings.inp_file << std::endl;
+            return 1;
+        }
+        tf->setup();
+        times.setup = timer.elapsed();
+
+        timer.start();
+        tf->auto_scale();
+        times.autoscale = timer.elapsed();
+
+        frame->create_output();
+
+        // repeated in-place runs need the original data for each run
+        if (settings.repeat > 1 && frame->in_place)
+        {
+            frame->backup_input();
+        }
+
+        // warm-up run (page faults, thread pool start-up), not timed
+        if (settings.repeat > 1)
+        {
+            std::cerr << "Warm-up run." << std::endl;
+            tf->do_transform(*frame);
+        }
+
+        std::cerr << "Perform transformation." << std::endl;
+        for (unsigned i = 0; i < settings.repeat; ++i)
+        {
+            frame->restore_input();
+
+            timer.start();
+            tf->do_transform(*frame);
+            times.transform.push_back(timer.elapsed());
+        }
+
+        std::cerr << "Save output file." << std::endl;
+        timer.start();
+        if (!frame->save())
+        {
+            std::cerr << "Error: cannot write " << settings.outp_file << std::endl;
+            return 1;
+        }
+        times.save = timer.elapsed();
+
+        if (!settings.cost_map_file.empty())
+        {
+            std::cerr << "Save cost map." << std::endl;
+            tf->save_cost_map();
+        }
+
+        report_times(times);
+
+        return 0;
+    }
+
+    int transform_batch(const Settings& settings)
+    {
+        std::vector<BatchJob> jobs;
+        if (!settings.batch_list.empty() && !read_batch_list(settings.batch_list, jobs))
+        {
+            return 1;
+        }
+        if (!settings.batch_dir.empty() && !read_batch_dir(settings.batch_dir, settings.batch_outp_dir, jobs))
+        {
+            return 1;
+        }
+
+        if (jobs.empty())
+        {
+            std::cerr << "Error: no input files" << std::endl;
+            return 1;
+        }
+
+        if (settings.repeat > 1 || !settings.cost_map_file.empty())
+        {
+            std::cerr << "Warning: --repeat and --cost-map are ignored in batch mode." << std::endl;
+        }
+
+        std::cerr << "Transform " << jobs.size() << " image(s)." << std::endl;
+        BatchResult result;
+        run_batch(settings, jobs, result);
+
+        std::cerr << std::fixed << std::setprecision(2);
+        std::cerr << "Processed " << result.num_done << " of " << jobs.size() << " image(s) in "
+                  << result.wall_time << " seconds (" << result.num_failed << " failed, "
+                  << result.num_setups << " transformation set-up(s))." << std::endl;
+
+        if (result.num_done > 0)
+        {
+            std::cerr << "Throughput: " << static_cast<double>(result.num_done) / result.wall_time
+                      << " images/s, transformation "
+                      << result.transform_time * 1e3 / static_cast<double>(result.num_done)
+                      << " ms/image." << std::endl;
+        }
+
+        return (result.num_failed > 0) ? 1 : 0;
+    }
+
+} // anonymous namespace
+
 int main(int argc, char* argv[])
 {
     Settings settings;
@@ -46,19 +194,24 @@ int main(int argc, char* argv[])
     }
     else
     {
-        std::cerr << "Load file and set up transformation." << std::endl;
-        std::auto_ptr<TransformWrapperBase> tf(TransformWrapperBase::get_instance(settings));
-
-        std::cerr << "Perform transformation... ";
-        time_t t0 = time(0);
-        tf->do_transform();
-        time_t t1 = time(0);
-        std::cerr << "done (time taken: " << difftime(t1, t0) << " seconds)." << std::endl;
-
-        std::cerr << "Save output file." << std::endl;
-        tf->save();
-
-        return 0;
+        if (settings.threads > 0)
+        {
+#ifdef HAVE_OPENMP
+            omp_set_num_threads(static_cast<int>(settings.threads));
+#else
+            if (settings.threads > 1)
+            {
+                std::cerr << "Built without OpenMP support, using a single thread." << std::endl;
+            }
+#endif
+        }
+
+        if (!settings.batch_list.empty() || !settings.batch_dir.empty())
+        {
+            return transform_batch(settings);
+        }
+
+        return transform_file(settings);
     }
 
 }
@@ -0,0 +1,580 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+#include "raw_image.h"
+
+namespace
+{
+
+    // reads the whitespace-separated tokens of a PPM/PFM header
+    class HeaderReader
+    {
+        public:
+            HeaderReader(const char* data, size_t size)
+                    : data_(data),
+                    size_(size),
+                    pos_(0)
+            {
+                //NIL
+            }
+
+            // read the next token, skipping whitespace and comments
+            bool token(std::string& tok)
+            {
+                for (;;)
+                {
+                    while (pos_ < size_ && std::isspace(static_cast<unsigned char>(data_[pos_])))
+                    {
+                        ++pos_;
+                    }
+
+                    if (pos_ < size_ && data_[pos_] == '#')
+                    {
+                        while (pos_ < size_ && data_[pos_] != '\n')
+                        {
+                            ++pos_;
+                        }
+                        continue;
+                    }
+
+                    break;
+                }
+
+                const size_t start = pos_;
+                while (pos_ < size_ && !std::isspace(static_cast<unsigned char>(data_[pos_])))
+                {
+                    ++pos_;
+                }
+
+                tok.assign(data_ + start, pos_ - start);
+                return !tok.empty();
+            }
+
+            // read the next line (without the line break)
+            bool line(std::string& ln)
+            {
+                if (pos_ >= size_)
+                {
+                    return false;
+                }
+
+                const size_t start = pos_;
+                while (pos_ < size_ && data_[pos_] != '\n')
+                {
+                    ++pos_;
+                }
+
+                ln.assign(data_ + start, pos_ - start);
+                if (pos_ < size_)
+                {
+                    ++pos_;
+                }
+
+                return true;
+            }
+
+            // the header ends with a single whitespace character after the last token
+            bool end_of_header(size_t& payload_offs) const
+            {
+                if (pos_ >= size_ || !std::isspace(static_cast<unsigned char>(data_[pos_])))
+                {
+                    return false;
+                }
+
+                payload_offs = pos_ + 1;
+                return true;
+            }
+
+            size_t pos() const
+            {
+                return pos_;
+            }
+
+        private:
+            const char* data_;
+            const size_t size_;
+            size_t pos_;
+    };
+
+    bool to_size(const std::string& tok, size_t& val)
+    {
+        char* end(0);
+        unsigned long tmp = std::strtoul(tok.c_str(), &end, 10);
+        val = static_cast<size_t>(tmp);
+        // (strtoul() would accept a sign)
+        return !tok.empty() && std::isdigit(static_cast<unsigned char>(tok[0]))
+               && *end == '\0' && tmp > 0;
+    }
+
+    bool parse_ppm(HeaderReader& reader, RawHeader& header)
+    {
+        std::string tok;
+        size_t maxval(0);
+
+        if (!reader.token(tok) || !to_size(tok, header.width)
+                || !reader.token(tok) || !to_size(tok, header.height)
+                || !reader.token(tok) || !to_size(tok, maxval))
+        {
+            return false;
+        }
+
+        header.format = RawFormat::ppm;
+        header.depth = 3;
+        header.maxval = maxval;
+
+        return reader.end_of_header(header.payload_offs);
+    }
+
+    bool parse_pam(HeaderReader& reader, RawHeader& header)
+    {
+        std::string ln;
+        size_t depth(0);
+        size_t maxval(0);
+
+        while (reader.line(ln))
+        {
+            std::istringstream sstr(ln);
+            std::string key;
+            std::string val;
+            if (!(sstr >> key) || key[0] == '#')
+            {
+                continue;
+            }
+
+            if (key == "ENDHDR")
+            {
+                header.format = RawFormat::pam;
+                header.depth = static_cast<unsigned int>(depth);
+                header.maxval = maxval;
+                header.payload_offs = reader.pos();
+
+                return header.width > 0 && header.height > 0 && depth > 0 && maxval > 0;
+            }
+
+            sstr >> val;
+            if (key == "WIDTH")
+            {
+                to_size(val, header.width);
+            }
+            else if (key == "HEIGHT")
+            {
+                to_size(val, header.height);
+            }
+            else if (key == "DEPTH")
+            {
+                if (!to_size(val, depth) || depth > std::numeric_limits<unsigned int>::max())
+                {
+                    return false;
+                }
+            }
+            else if (key == "MAXVAL")
+            {
+                to_size(val, maxval);
+            }
+        }
+
+        return false;
+    }
+
+    bool parse_pfm(HeaderReader& reader, RawHeader& header)
+    {
+        std::string tok;
+
+        if (!reader.token(tok) || !to_size(tok, header.width)
+                || !reader.token(tok) || !to_size(tok, header.height)
+                || !reader.token(tok))
+        {
+            return false;
+        }
+
+        // the sign of the scale factor gives the byte order
+        double scale = std::strtod(tok.c_str(), 0);
+        if (scale == 0.0)
+        {
+            return false;
+        }
+
+        header.format = RawFormat::pfm;
+        header.depth = 3;
+        header.little_endian = (scale < 0.0);
+
+        return reader.end_of_header(header.payload_offs);
+    }
+
+    // the header values are untrusted: reject maximum values beyond 16 bit, and
+    // dimensions that make the pixel data size overflow
+    bool check_header(const RawHeader& header)
+    {
+        if (header.format != RawFormat::pfm && header.maxval > 65535)
+        {
+            return false;
+        }
+
+        size_t limit = std::numeric_limits<size_t>::max();
+        limit /= header.sample_size();
+        limit /= header.depth;
+        limit /= header.width;
+        limit /= header.height;
+
+        return limit > 0;
+    }
+
+} // anonymous namespace
+
+size_t
+RawHeader::
+sample_size() const
+{
+    if (format == RawFormat::pfm)
+    {
+        return 4;
+    }
+
+    return (maxval > 255) ? 2 : 1;
+}
+
+size_t
+RawHeader::
+payload_size() const
+{
+    return width * height * depth * sample_size();
+}
+
+phtr::mem::Storage::type
+RawHeader::
+storage_type() const
+{
+    using phtr::mem::Storage;
+
+    switch (format)
+    {
+        case RawFormat::ppm:
+        case RawFormat::pam:
+            // other maximum values would need rescaling
+            if (depth == 3 && maxval == 255)
+            {
+                return Storage::rgb_8_inter;
+            }
+            else if (depth == 3 && maxval == 65535)
+            {
+                return Storage::rgb_16_inter;
+            }
+            else if (depth == 4 && maxval == 255)
+            {
+                return Storage::rgba_8_inter;
+            }
+            else if (depth == 4 && maxval == 65535)
+            {
+                return Storage::rgba_16_inter;
+            }
+            return Storage::unknown;
+
+        case RawFormat::pfm:
+            // there is no floating point storage, PFM data is converted
+            return Storage::rgb_32_inter;
+
+        case RawFormat::none:
+        default:
+            return Storage::unknown;
+    }
+}
+
+bool parse_raw_header(const char* data, size_t size, RawHeader& header)
+{
+    if (size < 2 || data[0] != 'P')
+    {
+        return false;
+    }
+
+    HeaderReader reader(data, size);
+    std::string magic;
+    reader.token(magic);
+
+    bool parsed(false);
+    if (magic == "P6")
+    {
+        parsed = parse_ppm(reader, header);
+    }
+    else if (magic == "P7")
+    {
+        // skip the rest of the magic line
+        std::string ln;
+        reader.line(ln);
+        parsed = parse_pam(reader, header);
+    }
+    else if (magic == "PF")
+    {
+        parsed = parse_pfm(reader, header);
+    }
+
+    return parsed && check_header(header);
+}
+
+std::string make_raw_header(const RawHeader& header)
+{
+    std::ostringstream sstr;
+
+    switch (header.format)
+    {
+        case RawFormat::ppm:
+            sstr << "P6\n" << header.width << " " << header.height << "\n" << header.maxval << "\n";
+            break;
+
+        case RawFormat::pam:
+            sstr << "P7\nWIDTH " << header.width << "\nHEIGHT " << header.height
+                 << "\nDEPTH " << header.depth << "\nMAXVAL " << header.maxval
+                 << "\nTUPLTYPE " << ((header.depth == 4) ? "RGB_ALPHA" : "RGB") << "\nENDHDR\n";
+            break;
+
+        case RawFormat::pfm:
+            sstr << "PF\n" << header.width << " " << header.height << "\n"
+                 << (header.little_endian ? "-1.0" : "1.0") << "\n";
+            break;
+
+        case RawFormat::none:
+        default:
+            break;
+    }
+
+    return sstr.str();
+}
+
+RawFormat::type raw_format_for_file(const std::string& fname)
+{
+    const std::string::size_type dot = fname.rfind('.');
+    if (dot == std::string::npos)
+    {
+        return RawFormat::none;
+    }
+
+    std::string ext = fname.substr(dot + 1);
+    for (size_t i = 0; i < ext.size(); ++i)
+    {
+        ext[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(ext[i])));
+    }
+
+    if (ext == "ppm")
+    {
+        return RawFormat::ppm;
+    }
+    else if (ext == "pam")
+    {
+        return RawFormat::pam;
+    }
+    else if (ext == "pfm")
+    {
+        return RawFormat::pfm;
+    }
+
+    return RawFormat::none;
+}
+
+bool same_file(const std::string& fname1, const std::string& fname2)
+{
+    // compares device and inode (or the platform's equivalent), so different
+    // spellings and links of the same file are detected
+    boost::system::error_code err;
+    return boost::filesystem::equivalent(fname1, fname2, err) && !err;
+}
+
+bool host_is_little_endian()
+{
+    const unsigned short probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+void swap_bytes_16(void* data, size_t num)
+{
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (size_t i = 0; i < num; ++i, bytes += 2)
+    {
+        std::swap(bytes[0], bytes[1]);
+    }
+}
+
+void swap_bytes_32(void* data, size_t num)
+{
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (size_t i = 0; i < num; ++i, bytes += 4)
+    {
+        std::swap(bytes[0], bytes[3]);
+        std::swap(bytes[1], bytes[2]);
+    }
+}
+
+MappedFile::
+MappedFile()
+        : fd_(-1),
+        addr_(0),
+        size_(0)
+{
+    //NIL
+}
+
+MappedFile::
+~MappedFile()
+{
+    close();
+}
+
+#if !defined(_WIN32)
+
+bool
+MappedFile::
+open_read(const std::string& fname)
+{
+    close();
+
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // private mapping: pages are only copied if they are modified (e.g. byte-swapped)
+    size_t size = static_cast<size_t>(st.st_size);
+    void* addr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (addr == MAP_FAILED)
+    {
+        return false;
+    }
+
+    addr_ = static_cast<char*>(addr);
+    size_ = size;
+    return true;
+}
+
+bool
+MappedFile::
+create(const std::string& fname, size_t size)
+{
+    close();
+
+    int fd = ::open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // reserve the disk space now: writing to a sparse file through the mapping
+    // would raise SIGBUS on a full disk instead of failing here
+    if (posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0)
+    {
+        ::close(fd);
+        ::unlink(fname.c_str());
+        return false;
+    }
+
+    void* addr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        ::close(fd);
+        ::unlink(fname.c_str());
+        return false;
+    }
+
+    fd_ = fd;
+    addr_ = static_cast<char*>(addr);
+    size_ = size;
+    return true;
+}
+
+void
+MappedFile::
+close()
+{
+    if (addr_)
+    {
+        munmap(addr_, size_);
+    }
+
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+
+    fd_ = -1;
+    addr_ = 0;
+    size_ = 0;
+}
+
+#else
+
+bool
+MappedFile::
+open_read(const std::string&)
+{
+    return false;
+}
+
+bool
+MappedFile::
+create(const std::string&, size_t)
+{
+    return false;
+}
+
+void
+MappedFile::
+close()
+{
+    //NIL
+}
+
+#endif
+
+char*
+MappedFile::
+data()
+{
+    return addr_;
+}
+
+size_t
+MappedFile::
+size() const
+{
+    return size_;
+}
@@ -0,0 +1,164 @@
+/*
+
+  phtrx: Photoropter demo application
+
+  Copyright (C) 2010 Robert Fendt
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef PHTRX_RAW_IMAGE_H__
+#define PHTRX_RAW_IMAGE_H__
+
+#include <cstddef>
+#include <string>
+
+#include <photoropter/mem/storage_type.h>
+
+/**
+ * @brief Uncompressed ('raw') file formats phtrx can map into memory.
+ */
+struct RawFormat
+{
+    enum type
+    {
+        none,
+        ppm,    // P6, 8/16 bit RGB (16 bit samples are big-endian)
+        pam,    // P7, 8/16 bit RGB/RGB_ALPHA (16 bit samples are big-endian)
+        pfm     // PF, 32 bit float RGB, lines bottom to top
+    };
+};
+
+/**
+ * @brief Header information of a raw image file.
+ */
+struct RawHeader
+{
+    RawHeader()
+            : format(RawFormat::none),
+            width(0),
+            height(0),
+            depth(0),
+            maxval(0),
+            little_endian(false),
+            payload_offs(0)
+    {
+        //NIL
+    }
+
+    RawFormat::type format;
+    size_t width;
+    size_t height;
+
+    // number of channels and maximum sample value (unused for PFM)
+    unsigned int depth;
+    unsigned long maxval;
+
+    // byte order of the samples (PFM only, PPM/PAM are always big-endian)
+    bool little_endian;
+
+    // offset of the pixel data in the file
+    size_t payload_offs;
+
+    // size of a sample in bytes
+    size_t sample_size() const;
+
+    // size of the pixel data in bytes
+    size_t payload_size() const;
+
+    // the storage type of the (converted) pixel data; unknown if not supported
+    phtr::mem::Storage::type storage_type() const;
+};
+
+/**
+ * @brief Parse the header of a PPM (P6), PAM (P7) or PFM (PF) file.
+ * @return false if the data does not start with a supported header, or if the
+ * header values are out of range (e.g., the size of the pixel data would overflow).
+ */
+bool parse_raw_header(const char* data, size_t size, RawHeader& header);
+
+/**
+ * @brief Create a file header (header.payload_offs is ignored).
+ */
+std::string make_raw_header(const RawHeader& header);
+
+/**
+ * @brief Determine the raw format from the file name extension (.ppm, .pam, .pfm).
+ */
+RawFormat::type raw_format_for_file(const std::string& fname);
+
+/**
+ * @brief Check whether two file names refer to the same (existing) file.
+ */
+bool same_file(const std::string& fname1, const std::string& fname2);
+
+/**
+ * @brief Check whether the host stores multi-byte values little-endian.
+ */
+bool host_is_little_endian();
+
+/**
+ * @brief Swap the byte order of 16 bit values in place.
+ */
+void swap_bytes_16(void* data, size_t num);
+
+/**
+ * @brief Swap the byte order of 32 bit values in place.
+ */
+void swap_bytes_32(void* data, size_t num);
+
+/**
+ * @brief A file mapped into memory.
+ * @note Memory mapping is only available on POSIX systems; elsewhere
+ * open_read() and create() fail and phtrx falls back to buffered I/O.
+ */
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+
+    public:
+        /**
+         * @brief Map an existing file (private mapping, i.e., changes are not written back).
+         */
+        bool open_read(const std::string& fname);
+
+        /**
+         * @brief Create a file of the given size and map it (changes are written back).
+         * @details The disk space is allocated up front; if that fails, no file is left behind.
+         */
+        bool create(const std::string& fname, size_t size);
+
+        /**
+         * @brief Unmap (and thereby write back) the file.
+         */
+        void close();
+
+        char* data();
+        size_t size() const;
+
+    private:
+        // not copyable
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+    private:
+        int fd_;
+        char* addr_;
+        size_t size_;
+};
+
+#endif // PHTRX_RAW_IMAGE_H__
@@ -22,6 +22,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef PHTRX_SETTINGS_H__
 #define PHTRX_SETTINGS_H__
 
+#include <string>
+#include <vector>
+
 #include <photoropter/interpolation_type.h>
 #include <photoropter/geometry_type.h>
 
@@ -53,6 +56,8 @@ struct Settings
             scale_fact(1.0),
             vignetting_corr(false),
             vignetting_params(3, 0),
+            exposure(0.0),
+            wb_gains(3, 1.0),
             x0(0),
             y0(0),
             param_aspect_override(false),
@@ -64,6 +69,7 @@ struct Settings
             sub_rect_y0(0),
             sub_rect_w(0),
             sub_rect_h(0),
+            in_place(false),
             gainfunc(GainFunc::srgb),
             gamma(2.2),
             oversampling(1),
@@ -73,7 +79,12 @@ struct Settings
             src_geom(phtr::Geometry::rectilinear),
             dst_geom(phtr::Geometry::rectilinear),
             src_focal_length(10.0),
-            dst_focal_length(10.0)
+            dst_focal_length(10.0),
+            cost_map_tile(64),
+            repeat(1),
+            threads(0),
+            io_threads(2),
+            queue_size(2)
     {
         ptlens_r_params[3] = 1.0;
         ptlens_b_params[3] = 1.0;
@@ -102,6 +113,10 @@ struct Settings
     bool vignetting_corr;
     std::vector<double> vignetting_params;
 
+    // exposure correction (EV) and white balance gains
+    double exposure;
+    std::vector<double> wb_gains;
+
     // centre shift
     size_t x0;
     size_t y0;
@@ -119,6 +134,9 @@ struct Settings
     size_t sub_rect_w;
     size_t sub_rect_h;
 
+    // transform in place (saves the output buffer)
+    bool in_place;
+
     // input / output file names
     std::string inp_file;
     std::string outp_file;
@@ -139,6 +157,25 @@ struct Settings
     phtr::Geometry::type dst_geom;
     double src_focal_length;
     double dst_focal_length;
+
+    // per-tile cost map (needs PHTR_INSTRUMENT)
+    std::string cost_map_file;
+    unsigned cost_map_tile;
+
+    // timed transformation runs (preceded by a warm-up run if > 1)
+    unsigned repeat;
+
+    // number of threads (0: OpenMP default)
+    unsigned threads;
+
+    // batch mode: list of file pairs, or input and output directory
+    std::string batch_list;
+    std::string batch_dir;
+    std::string batch_outp_dir;
+
+    // batch mode: decoding/encoding threads (each), frames per pipeline queue
+    unsigned io_threads;
+    unsigned queue_size;
 };
 
 #endif // PHTRX_SETTINGS_H__
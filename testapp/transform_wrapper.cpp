@@ -19,96 +19,38 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 */
 
-#include <vil/vil_load.h>
-
 #include "transform_wrapper.h"
 
 TransformWrapperBase*
 TransformWrapperBase::
-get_instance(const Settings& settings)
+get_instance(const Settings& settings, ImageFrame& frame)
 {
     using phtr::mem::Storage;
 
-    Storage::type storage_type = get_storage_type(settings.inp_file);
-
-    if (storage_type == Storage::rgb_8_inter)
-    {
-        log(settings, "8bit RGB data");
-        return new TransformWrapper<Storage::rgb_8_inter>(settings);
-    }
-    else if (storage_type == Storage::rgb_16_inter)
-    {
-        log(settings, "16bit RGB data");
-        return new TransformWrapper<Storage::rgb_16_inter>(settings);
-    }
-    else if (storage_type == Storage::rgb_32_inter)
-    {
-        log(settings, "32bit RGB data");
-        return new TransformWrapper<Storage::rgb_32_inter>(settings);
-    }
-    else if (storage_type == Storage::rgba_8_inter)
-    {
-        log(settings, "8bit RGBA data");
-        return new TransformWrapper<Storage::rgba_8_inter>(settings);
-    }
-    else if (storage_type == Storage::rgba_16_inter)
-    {
-        log(settings, "16bit RGBA data");
-        return new TransformWrapper<Storage::rgba_16_inter>(settings);
-    }
-    else if (storage_type == Storage::rgba_32_inter)
+    switch (frame.storage_type)
     {
-        log(settings, "32bit RGBA data");
-        return new TransformWrapper<Storage::rgba_32_inter>(settings);
-    }
+        case Storage::rgb_8_inter:
+            return new TransformWrapper<Storage::rgb_8_inter>(settings, frame);
 
-    return 0;
-}
+        case Storage::rgb_16_inter:
+            return new TransformWrapper<Storage::rgb_16_inter>(settings, frame);
 
-phtr::mem::Storage::type
-TransformWrapperBase::
-get_storage_type(const std::string inp_file)
-{
-    using phtr::mem::Storage;
-    Storage::type phtr_storage = Storage::unknown;
+        case Storage::rgb_32_inter:
+            return new TransformWrapper<Storage::rgb_32_inter>(settings, frame);
 
-    vil_image_resource_sptr img_res = vil_load_image_resource(inp_file.c_str());
-    vil_pixel_format vil_img_format = img_res->pixel_format();
+        case Storage::rgba_8_inter:
+            return new TransformWrapper<Storage::rgba_8_inter>(settings, frame);
 
-    unsigned int num_components = img_res->nplanes();
+        case Storage::rgba_16_inter:
+            return new TransformWrapper<Storage::rgba_16_inter>(settings, frame);
 
-    if (num_components == 3)
-    {
-        if (vil_img_format == VIL_PIXEL_FORMAT_BYTE)
-        {
-            phtr_storage = Storage::rgb_8_inter;
-        }
-        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_16)
-        {
-            phtr_storage = Storage::rgb_16_inter;
-        }
-        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_32)
-        {
-            phtr_storage = Storage::rgb_32_inter;
-        }
-    }
-    else if (num_components == 4)
-    {
-        if (vil_img_format == VIL_PIXEL_FORMAT_BYTE)
-        {
-            phtr_storage = Storage::rgba_8_inter;
-        }
-        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_16)
-        {
-            phtr_storage = Storage::rgba_16_inter;
-        }
-        else if (vil_img_format == VIL_PIXEL_FORMAT_UINT_32)
-        {
-            phtr_storage = Storage::rgba_32_inter;
-        }
-    }
+        case Storage::rgba_32_inter:
+            return new TransformWrapper<Storage::rgba_32_inter>(settings, frame);
 
-    return phtr_storage;
+        default:
+            log(settings, "Unsupported storage type.");
+            return 0;
+    }
 }
 
 void
@@ -23,17 +23,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define PHTRX_TRANSFORM_WRAPPER_H__
 
 #include <string>
+#include <fstream>
+#include <iostream>
 #include <memory>
 #include <algorithm>
+#include <cassert>
 
-#include "vil_pixel_type.h"
 #include "settings.h"
+#include "image_frame.h"
 
 #include <photoropter/mem/storage_type.h>
-#include <photoropter/image_buffer.h>
 #include <photoropter/mem_image_view_r.h>
 #include <photoropter/mem_image_view_w.h>
 #include <photoropter/image_transform.h>
+#include <photoropter/streaming_transform.h>
 #include <photoropter/auto_scaler.h>
 
 #include <photoropter/model/vignetting_colour_model.h>
@@ -41,10 +44,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <photoropter/model/scaler_pixel_model.h>
 #include <photoropter/model/geometry_convert_pixel_model.h>
 
-#include <vil/vil_convert.h>
-#include <vil/vil_load.h>
-#include <vil/vil_save.h>
-
 class TransformWrapperBase
 {
 
@@ -56,26 +55,38 @@ class TransformWrapperBase
 
     public:
         /**
-         * @brief Initialise and return a transformation object compatible with the given settings.
+         * @brief Initialise and return a transformation object compatible with the given image.
+         * @details The transformation works on the frame's buffers. It can be reused for other
+         * frames of the same size and storage type, cf. accepts().
          */
-        static TransformWrapperBase* get_instance(const Settings& settings);
+        static TransformWrapperBase* get_instance(const Settings& settings, ImageFrame& frame);
 
         /**
-         * @brief Perform the transformation.
+         * @brief Set up the transformation (gain function, correction models etc.).
          */
-        virtual void do_transform() = 0;
+        virtual void setup() = 0;
 
         /**
-         * @brief Save the transformation result.
+         * @brief Determine and apply the automatic scaling factor (if requested).
          */
-        virtual void save() = 0;
+        virtual void auto_scale() = 0;
+
+        /**
+         * @brief Check whether the transformation can be used for the given frame.
+         */
+        virtual bool accepts(const ImageFrame& frame) const = 0;
 
-    private:
         /**
-         * @brief Determine a compatible storage type (i.e., check the bit depth of the given file)
+         * @brief Transform the given frame.
          */
-        static phtr::mem::Storage::type get_storage_type(const std::string inp_file);
+        virtual void do_transform(ImageFrame& frame) = 0;
 
+        /**
+         * @brief Save the cost map collected during the transformation.
+         */
+        virtual void save_cost_map() = 0;
+
+    private:
         /**
          * @brief Log messages according to settings
          */
@@ -87,45 +98,46 @@ template <phtr::mem::Storage::type storage_T>
 class TransformWrapper : public TransformWrapperBase
 {
     public:
-        typedef phtr::ImageBuffer<storage_T> buffer_t;
         typedef phtr::MemImageViewR<storage_T> view_r_t;
         typedef phtr::MemImageViewW<storage_T> view_w_t;
         typedef typename view_w_t::iter_t iter_t;
 
         typedef phtr::InterpolatorLanczos<view_r_t> interp_lanczos_t;
         typedef phtr::ImageTransform<interp_lanczos_t, view_w_t> transform_lanczos_t;
-
-        typedef typename VILPixelType<storage_T>::vil_pixel_t vil_pixel_t;
+        typedef phtr::StreamingTransform<phtr::InterpolatorLanczos, storage_T> streaming_lanczos_t;
 
     public:
-        TransformWrapper(const Settings& settings);
-        void do_transform();
-        void save();
+        TransformWrapper(const Settings& settings, ImageFrame& frame);
+        void setup();
+        void auto_scale();
+        bool accepts(const ImageFrame& frame) const;
+        void do_transform(ImageFrame& frame);
+        void save_cost_map();
 
     private:
-        void load();
         void init_transform();
         void setup_transform();
         void set_gainfunc();
         void add_models();
         void log(const std::string& msg);
+        phtr::IImageTransform& transform();
 
     private:
-        static const unsigned int num_components_ = VILPixelType<storage_T>::num_components;
         size_t img_width_;
         size_t img_height_;
         size_t dst_width_;
         size_t dst_height_;
+        size_t inp_line_step_;
+        bool in_place_;
+        double param_aspect_;
 
         const Settings settings_;
 
-        std::auto_ptr<buffer_t> input_buffer_;
-        std::auto_ptr<buffer_t> output_buffer_;
-
         std::auto_ptr<view_r_t> input_view_;
         std::auto_ptr<view_w_t> output_view_;
 
         std::auto_ptr<phtr::IImageTransform> image_transform_;
+        std::auto_ptr<phtr::IStreamingTransform> streaming_transform_;
 };
 
 #include "transform_wrapper.tpl.h"
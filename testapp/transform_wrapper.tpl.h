@@ -21,76 +21,34 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 template <phtr::mem::Storage::type storage_T>
 TransformWrapper<storage_T>::
-TransformWrapper(const Settings& settings)
-        : img_width_(0),
-        img_height_(0),
-        dst_width_(0),
-        dst_height_(0),
+TransformWrapper(const Settings& settings, ImageFrame& frame)
+        : img_width_(frame.img_width),
+        img_height_(frame.img_height),
+        dst_width_(frame.dst_width),
+        dst_height_(frame.dst_height),
+        inp_line_step_(frame.inp_line_step),
+        in_place_(frame.in_place),
+        param_aspect_(1.0),
         settings_(settings)
 {
-    log("Load image data.");
-    load();
-    log("Init transformation structures.");
-    init_transform();
-    log("Setup transformation.");
-    setup_transform();
+    // attach views to the frame's buffers (other frames are attached in do_transform();
+    // the output is only created once the transformation has been set up)
+    input_view_.reset(new view_r_t(frame.input_data(), img_width_, img_height_, inp_line_step_));
+    if (!in_place_)
+    {
+        output_view_.reset(new view_w_t(0, dst_width_, dst_height_));
+    }
 }
 
 template <phtr::mem::Storage::type storage_T>
 void
 TransformWrapper<storage_T>::
-load()
+setup()
 {
-    vil_image_view<vil_pixel_t> loaded_img =
-        vil_convert_to_component_order(
-            vil_convert_to_n_planes(
-                num_components_, vil_load(settings_.inp_file.c_str())
-            )
-        );
-
-    // set image width and height
-    img_width_ = loaded_img.ni();
-    img_height_ = loaded_img.nj();
-    dst_width_ = img_width_;
-    dst_height_ = img_height_;
-    std::stringstream sstr;
-    sstr << "Image dimensions: " << img_width_ << "x" << img_height_;
-    log(sstr.str());
-
-    // 'sanity checks' on ROI settings
-    size_t sub_rect_x0 = settings_.sub_rect_x0;
-    size_t sub_rect_y0 = settings_.sub_rect_y0;
-    if (settings_.sub_rect && settings_.sub_rect_w <= img_width_ && settings_.sub_rect_h <= img_height_)
-    {
-        dst_width_ = settings_.sub_rect_w;
-        dst_height_ = settings_.sub_rect_h;
-    }
-    if (sub_rect_x0 > img_height_ - dst_width_ || sub_rect_y0 > img_height_ - dst_height_)
-    {
-        sub_rect_x0 = 0;
-        sub_rect_y0 = 0;
-    }
-    {
-        std::stringstream sstr;
-        sstr << "Clip rectangle: " << dst_width_ << "x" << dst_height_ << " " << sub_rect_x0 << ":" << sub_rect_y0;
-        log(sstr.str());
-    }
-
-    // allocate transfer buffers & attach views
-    input_buffer_.reset(new buffer_t(img_width_, img_height_));
-    input_view_.reset(new view_r_t(input_buffer_->data(), img_width_, img_height_));
-    output_buffer_.reset(new buffer_t(dst_width_, dst_height_));
-    output_view_.reset(new view_w_t(output_buffer_->data(), dst_width_, dst_height_));
-
-    // attach a VIL view to the buffer
-    unsigned int width = static_cast<unsigned int>(img_width_);
-    unsigned int height = static_cast<unsigned int>(img_height_);
-    vil_image_view<vil_pixel_t> vil_input_view(
-        static_cast<vil_pixel_t*>(input_buffer_->data()), width, height, 1, 1, width, 1
-    );
-
-    // tell VIL to convert/copy data into the Photoropter buffer
-    vil_input_view.deep_copy(loaded_img);
+    log("Init transformation structures.");
+    init_transform();
+    log("Setup transformation.");
+    setup_transform();
 }
 
 template <phtr::mem::Storage::type storage_T>
@@ -100,7 +58,16 @@ init_transform()
 {
     using phtr::Interpolation;
 
-    image_transform_.reset(phtr::get_image_transform(settings_.interp_type, *input_view_, *output_view_));
+    if (in_place_)
+    {
+        log("Transform in place.");
+        streaming_transform_.reset(phtr::get_streaming_transform<storage_T>(settings_.interp_type,
+                                   img_width_, img_height_, dst_width_, dst_height_));
+    }
+    else
+    {
+        image_transform_.reset(phtr::get_image_transform(settings_.interp_type, *input_view_, *output_view_));
+    }
 
     // the switch is mainly used for logging (and for setting the lanczos support)
     switch (settings_.interp_type)
@@ -119,8 +86,16 @@ init_transform()
             sstr << "Use Lanczos interpolation, support = " << settings_.lanczos_support;
             log(sstr.str());
 
-            transform_lanczos_t& transform = dynamic_cast<transform_lanczos_t&>(*image_transform_);
-            transform.interpolator().set_support(settings_.lanczos_support);
+            if (in_place_)
+            {
+                streaming_lanczos_t& transform = dynamic_cast<streaming_lanczos_t&>(*streaming_transform_);
+                transform.image_transform().interpolator().set_support(settings_.lanczos_support);
+            }
+            else
+            {
+                transform_lanczos_t& transform = dynamic_cast<transform_lanczos_t&>(*image_transform_);
+                transform.interpolator().set_support(settings_.lanczos_support);
+            }
             break;
     }
 }
@@ -140,7 +115,13 @@ setup_transform()
     std::stringstream sstr;
     sstr << "Set (over-)sampling factor: " << settings_.oversampling;
     log(sstr.str());
-    image_transform_->set_sampling_fact(settings_.oversampling);
+    transform().set_sampling_fact(settings_.oversampling);
+
+    // collect a cost map (streaming transformations work band by band)
+    if (!settings_.cost_map_file.empty() && !in_place_)
+    {
+        transform().set_cost_map_tile_size(settings_.cost_map_tile, settings_.cost_map_tile);
+    }
 }
 
 template <phtr::mem::Storage::type storage_T>
@@ -164,7 +145,7 @@ set_gainfunc()
                     coeff_iter = coeff_iter(coeff);
                 }
 
-                image_transform_->set_gamma(emor_func);
+                transform().set_gamma(emor_func);
             }
 
             break;
@@ -181,20 +162,20 @@ set_gainfunc()
                     coeff_iter = coeff_iter(coeff);
                 }
 
-                image_transform_->set_gamma(emor_func);
+                transform().set_gamma(emor_func);
             }
 
             break;
 
         case GainFunc::gamma:
             log("Use generic gamma gain function.");
-            image_transform_->set_gamma(gamma::GammaGeneric(settings_.gamma));
+            transform().set_gamma(gamma::GammaGeneric(settings_.gamma));
             break;
 
         case GainFunc::srgb:
         default:
             log("Use sRGB gamma gain function.");
-            image_transform_->set_gamma(gamma::GammaSRGB());
+            transform().set_gamma(gamma::GammaSRGB());
             break;
     }
 }
@@ -224,6 +205,7 @@ add_models()
         sstr << "Assume parameter aspect: " << param_aspect;
         log(sstr.str());
     }
+    param_aspect_ = param_aspect;
 
     // calculate centre shift
     double x0 = static_cast<double>(settings_.x0) / static_cast<double>(input_view_->height());
@@ -243,7 +225,7 @@ add_models()
         scaler_tca_mod.set_model_param_single(idx_red, settings_.tca_r);
         scaler_tca_mod.set_model_param_single(idx_blue, settings_.tca_b);
 
-        image_transform_->subpixel_queue().add_model(scaler_tca_mod);
+        transform().subpixel_queue().add_model(scaler_tca_mod);
     }
 
     // apply PTLens TCA correction (fulla style)
@@ -267,7 +249,7 @@ add_models()
 
         ptlens_tca_mod.set_centre_shift(x0, y0);
 
-        image_transform_->subpixel_queue().add_model(ptlens_tca_mod);
+        transform().subpixel_queue().add_model(ptlens_tca_mod);
     }
 
     // apply PTLens geometric correction
@@ -294,7 +276,7 @@ add_models()
         }
         ptlens_mod.set_centre_shift(x0, y0);
 
-        image_transform_->pixel_queue().add_model(ptlens_mod);
+        transform().pixel_queue().add_model(ptlens_mod);
     }
 
     // lens geometry conversion
@@ -305,7 +287,7 @@ add_models()
             model::get_geometry_conversion(settings_.src_geom, settings_.dst_geom,
                                            image_aspect, settings_.image_crop));
         geom_conv_mod->set_focal_lengths(settings_.src_focal_length, settings_.dst_focal_length);
-        image_transform_->pixel_queue().add_model(*geom_conv_mod);
+        transform().pixel_queue().add_model(*geom_conv_mod);
     }
 
     if (settings_.do_scale)
@@ -318,35 +300,7 @@ add_models()
 
         scaler_mod.set_model_param(settings_.scale_fact);
 
-        image_transform_->pixel_queue().add_model(scaler_mod);
-    }
-
-    if (settings_.auto_scale)
-    {
-        std::auto_ptr<IAutoScaler> scaler(get_auto_scaler(storage_T, *image_transform_));
-        double auto_scale;
-        bool found_scale = scaler->find_scale(std::max(dst_width_, dst_height_), auto_scale);
-        std::stringstream sstr;
-
-        if (found_scale)
-        {
-            sstr << "Autoscale: " << 1.0 / auto_scale;
-
-            model::ScalerPixelModel scaler_mod(param_aspect,
-                                               image_aspect,
-                                               settings_.param_crop,
-                                               settings_.image_crop);
-
-            scaler_mod.set_model_param(1.0 / auto_scale);
-
-            image_transform_->pixel_queue().add_model(scaler_mod);
-        }
-        else
-        {
-            sstr << "Autoscale failed.";
-        }
-
-        log(sstr.str());
+        transform().pixel_queue().add_model(scaler_mod);
     }
 
     // apply vignetting correction
@@ -363,34 +317,156 @@ add_models()
 
         // add the model to queue and get a reference to the internal object back
         HuginVignettingModel& vign_mod = dynamic_cast<HuginVignettingModel&>(
-                                             image_transform_->colour_queue().add_model(tmp_vign_mod));
+                                             transform().colour_queue().add_model(tmp_vign_mod));
 
         vign_mod.set_model_params(settings_.vignetting_params[0],
                                   settings_.vignetting_params[1],
                                   settings_.vignetting_params[2]);
         vign_mod.set_centre_shift(x0, y0);
     }
+
+    // exposure and white balance (folded into the colour correction factors)
+    if (settings_.exposure != 0.0)
+    {
+        std::stringstream sstr;
+        sstr << "Set exposure correction: " << settings_.exposure << " EV";
+        log(sstr.str());
+        transform().colour_queue().set_exposure(settings_.exposure);
+    }
+
+    if (settings_.wb_gains[0] != 1.0 || settings_.wb_gains[1] != 1.0 || settings_.wb_gains[2] != 1.0)
+    {
+        std::stringstream sstr;
+        sstr << "Set white balance gains: " << settings_.wb_gains[0] << ":"
+             << settings_.wb_gains[1] << ":" << settings_.wb_gains[2];
+        log(sstr.str());
+        transform().colour_queue().set_white_balance(settings_.wb_gains[0],
+                settings_.wb_gains[1],
+                settings_.wb_gains[2]);
+    }
 }
 
 template <phtr::mem::Storage::type storage_T>
 void
 TransformWrapper<storage_T>::
-do_transform()
+auto_scale()
 {
-    image_transform_->do_transform();
+    using namespace phtr;
+
+    if (!settings_.auto_scale)
+    {
+        return;
+    }
+
+    double image_aspect = input_view_->aspect_ratio();
+
+    std::auto_ptr<IAutoScaler> scaler(get_auto_scaler(storage_T, transform()));
+    double scale_fact;
+    bool found_scale = scaler->find_scale(std::max(dst_width_, dst_height_), scale_fact);
+    std::stringstream sstr;
+
+    if (found_scale)
+    {
+        sstr << "Autoscale: " << 1.0 / scale_fact;
+
+        model::ScalerPixelModel scaler_mod(param_aspect_,
+                                           image_aspect,
+                                           settings_.param_crop,
+                                           settings_.image_crop);
+
+        scaler_mod.set_model_param(1.0 / scale_fact);
+
+        // (the scaler has to be the last model in the pixel queue)
+        transform().pixel_queue().add_model(scaler_mod);
+    }
+    else
+    {
+        sstr << "Autoscale failed.";
+    }
+
+    log(sstr.str());
+}
+
+template <phtr::mem::Storage::type storage_T>
+bool
+TransformWrapper<storage_T>::
+accepts(const ImageFrame& frame) const
+{
+    return (frame.storage_type == storage_T)
+           && (frame.img_width == img_width_) && (frame.img_height == img_height_)
+           && (frame.dst_width == dst_width_) && (frame.dst_height == dst_height_)
+           && (frame.inp_line_step == inp_line_step_) && (frame.in_place == in_place_);
 }
 
 template <phtr::mem::Storage::type storage_T>
 void
 TransformWrapper<storage_T>::
-save()
+do_transform(ImageFrame& frame)
 {
-    unsigned int width = static_cast<unsigned int>(dst_width_);
-    unsigned int height = static_cast<unsigned int>(dst_height_);
-    vil_image_view<vil_pixel_t> vil_output_view
-    (static_cast<vil_pixel_t*>(output_buffer_->data()), width, height, 1, 1, width, 1);
+    assert(accepts(frame));
+
+    if (in_place_)
+    {
+        streaming_transform_->transform_in_place(frame.input_data());
+    }
+    else
+    {
+        // the transformation only holds references to the views
+        input_view_->set_base_addr(frame.input_data());
+        output_view_->set_base_addr(frame.output_data());
+        image_transform_->do_transform();
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+void
+TransformWrapper<storage_T>::
+save_cost_map()
+{
+    if (in_place_)
+    {
+        std::cerr << "Warning: no cost map for in-place transformations." << std::endl;
+        return;
+    }
+
+    const phtr::TransformStats& stats = transform().stats();
+    if (!stats.enabled || stats.cost_map.empty())
+    {
+        std::cerr << "Warning: no cost map collected (library built without PHTR_INSTRUMENT?)." << std::endl;
+        return;
+    }
+
+    const std::string& fname = settings_.cost_map_file;
+    const bool is_pgm = (fname.size() >= 4) && (fname.compare(fname.size() - 4, 4, ".pgm") == 0);
+
+    std::ofstream file(fname.c_str(), is_pgm ? (std::ios::out | std::ios::binary) : std::ios::out);
+    if (!file)
+    {
+        std::cerr << "Error: could not open " << fname << std::endl;
+        return;
+    }
+
+    if (is_pgm)
+    {
+        stats.cost_map.write_pgm(file);
+    }
+    else
+    {
+        stats.cost_map.write_csv(file, stats.ticks_per_second);
+    }
+}
+
+template <phtr::mem::Storage::type storage_T>
+phtr::IImageTransform&
+TransformWrapper<storage_T>::
+transform()
+{
+    if (in_place_)
+    {
+        return streaming_transform_->transform();
+    }
 
-    vil_save(vil_output_view, settings_.outp_file.c_str());
+    return *image_transform_;
 }
 
 template <phtr::mem::Storage::type storage_T>